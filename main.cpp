@@ -2,6 +2,8 @@
 #include <glog/logging.h>
 #include "cli-arg-parser/cli-arg-parser.h"
 #include "controller-base/controller-base.h"
+#include "benchmark-base/benchmark-base.h"
+#include "telemetry/telemetry.h"
 
 std::atomic_bool controller::Controller::exit_signal_ = false;
 
@@ -12,6 +14,20 @@ void SignalHandler(int) {
 
 int main(int argc, char **argv) {
   cli_argv.Parse(argc, argv);
+  if (!cli_argv.BenchmarkType().empty()) {
+    std::unique_ptr<benchmark::Benchmark> benchmark;
+    benchmark.reset(benchmark::CreateBenchmark(cli_argv.BenchmarkType()));
+    if (!benchmark) return -1;
+    if (!benchmark->Initialize("../config/benchmark/" + cli_argv.BenchmarkType() + "-baseline.yaml")) return 1;
+    int ret = benchmark->Run();
+    google::ShutdownGoogleLogging();
+    return ret;
+  }
+  if (!cli_argv.DecodeTelemetry().empty()) {
+    int ret = telemetry::Decode(cli_argv.DecodeTelemetry(), cli_argv.DecodeTelemetry() + ".csv") ? 0 : 1;
+    google::ShutdownGoogleLogging();
+    return ret;
+  }
   std::unique_ptr<controller::Controller> controller;
   controller.reset(controller::CreateController(cli_argv.ControllerType()));
   if (!controller) return -1;
@@ -0,0 +1,181 @@
+#include <glog/logging.h>
+#include <opencv2/core/persistence.hpp>
+#include <opencv2/imgproc.hpp>
+#include "association.h"
+
+namespace {
+using CostMat = std::array<std::array<double, association::kCapacity>, association::kCapacity>;  ///< 代价矩阵
+
+constexpr double kForbidden = 1e6;  ///< 禁止关联的配对代价，远大于任意合法代价之和
+
+/**
+ * @brief 求解最小代价指派问题
+ * @details 使用基于势函数的匈牙利算法，不足的行列以零代价补齐为方阵，时间复杂度 O(n^3)，只使用栈上的定长数组
+ * @param [in] cost 代价矩阵，只使用左上角 rows x cols 部分
+ * @param rows 行数（轨迹数）
+ * @param cols 列数（装甲板数）
+ * @param [out] row_to_col 每行指派的列，指派到补齐列的行为 -1
+ */
+void SolveAssignment(CostMat REF_IN cost, int rows, int cols,
+                     std::array<int, association::kCapacity> REF_OUT row_to_col) {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  int n = std::max(rows, cols);
+  // 下标从 1 开始，第 0 列作为每轮增广的虚拟起点
+  std::array<double, association::kCapacity + 1> u{}, v{}, min_v{};
+  std::array<int, association::kCapacity + 1> p{}, way{};
+  std::array<bool, association::kCapacity + 1> used{};
+  for (auto i = 1; i <= n; ++i) {
+    p[0] = i;
+    int j0 = 0;
+    std::fill_n(min_v.begin(), n + 1, kInfinity);
+    std::fill_n(used.begin(), n + 1, false);
+    do {
+      used[j0] = true;
+      int i0 = p[j0], j1 = 0;
+      double delta = kInfinity;
+      for (auto j = 1; j <= n; ++j) {
+        if (used[j]) continue;
+        double current = (i0 <= rows && j <= cols ? cost[i0 - 1][j - 1] : 0) - u[i0] - v[j];
+        if (current < min_v[j]) {
+          min_v[j] = current;
+          way[j] = j0;
+        }
+        if (min_v[j] < delta) {
+          delta = min_v[j];
+          j1 = j;
+        }
+      }
+      for (auto j = 0; j <= n; ++j) {
+        if (used[j]) {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        } else min_v[j] -= delta;
+      }
+      j0 = j1;
+    } while (p[j0]);
+    do {
+      int j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    } while (j0);
+  }
+  std::fill(row_to_col.begin(), row_to_col.end(), -1);
+  for (auto j = 1; j <= cols; ++j)
+    if (p[j] && p[j] <= rows) row_to_col[p[j] - 1] = j - 1;
+}
+
+/**
+ * @brief 计算两个矩形的交并比
+ * @param [in] a 矩形 a
+ * @param [in] b 矩形 b
+ * @return 交并比，取值 [0, 1]
+ */
+inline double IoU(cv::Rect2f REF_IN a, cv::Rect2f REF_IN b) {
+  double intersection = (a & b).area();
+  return intersection > 0 ? intersection / (a.area() + b.area() - intersection) : 0;
+}
+}
+
+bool association::Associator::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage association_config;
+  association_config.open(config_file, cv::FileStorage::READ);
+  if (!association_config.isOpened()) {
+    LOG(ERROR) << "Failed to open association configuration file " << config_file << ".";
+    return false;
+  }
+  std::string tracker_config;
+  association_config["GATE_DISTANCE"] >> gate_distance_;
+  association_config["DISTANCE_WEIGHT"] >> distance_weight_;
+  association_config["OVERLAP_WEIGHT"] >> overlap_weight_;
+  association_config["MAX_MISSES"] >> max_misses_;
+  association_config["TRACKER_CONFIG"] >> tracker_config;
+  if (gate_distance_ <= 0 || distance_weight_ < 0 || overlap_weight_ < 0 || max_misses_ < 0) {
+    LOG(ERROR) << "Invalid association configurations. Gate distance must be positive "
+               << "and weights and max misses must not be negative.";
+    return false;
+  }
+  if (!tracker_param_.Initialize(tracker_config, "CV")) {
+    LOG(ERROR) << "Failed to read tracker configurations for association.";
+    return false;
+  }
+  num_tracks_ = 0;
+  next_id_ = 0;
+  LOG(INFO) << "Initialized multi-target associator with capacity " << kCapacity << ".";
+  return true;
+}
+
+void association::Associator::Update(std::vector<Armor> REF_IN armors,
+                                     uint64_t time_stamp,
+                                     coordinate::CoordSolver REF_IN coord_solver,
+                                     coordinate::EAngle REF_IN euler_angle) {
+  int num_detections = std::min(static_cast<int>(armors.size()), kCapacity);
+  auto rm_imu = coordinate::CoordSolver::EAngleToRMat(euler_angle);
+  CostMat cost;
+  for (auto i = 0; i < num_tracks_; ++i) {
+    auto &&track = tracks_[i];
+    track.tracker.Predict(time_stamp);
+    auto ctv_world = track.tracker.Position(time_stamp);
+    auto ctv_cam = coord_solver.WorldToCam(ctv_world, rm_imu);
+    // 预测位置在相机后方时无法投影，只按距离关联
+    cv::Rect2f box;
+    if (ctv_cam.z() > 0) {
+      auto center = coord_solver.CamToPic(ctv_cam);
+      box = {center.x - track.size.width / 2, center.y - track.size.height / 2,
+             track.size.width, track.size.height};
+    }
+    for (auto j = 0; j < num_detections; ++j) {
+      auto &&armor = armors[j];
+      double distance = (armor.CTVecWorld() - ctv_world).norm();
+      if (distance > gate_distance_ || (track.armor_id && armor.ID() && track.armor_id != armor.ID())) {
+        cost[i][j] = kForbidden;
+        continue;
+      }
+      auto overlap = box.empty() ? 0 : IoU(box, cv::Rect2f(cv::boundingRect(armor.Vertexes())));
+      cost[i][j] = distance_weight_ * distance / gate_distance_ + overlap_weight_ * (1 - overlap);
+    }
+  }
+  std::array<int, kCapacity> track_to_detection;
+  SolveAssignment(cost, num_tracks_, num_detections, track_to_detection);
+
+  std::fill(detection_track_ids_.begin(), detection_track_ids_.end(), -1);
+  for (auto i = 0; i < num_tracks_; ++i) {
+    auto &&track = tracks_[i];
+    int j = track_to_detection[i];
+    if (j < 0 || cost[i][j] >= kForbidden) {
+      ++track.misses;
+      continue;
+    }
+    auto &&armor = armors[j];
+    track.tracker.Update(armor.STVecWorld(), time_stamp);
+    track.size = cv::boundingRect(armor.Vertexes()).size();
+    if (armor.ID()) track.armor_id = armor.ID();
+    ++track.hits;
+    track.misses = 0;
+    detection_track_ids_[j] = track.id;
+  }
+
+  // 先移除丢失过久的轨迹，再为未关联的装甲板生成新轨迹，移除时以末尾轨迹填补空位
+  for (auto i = 0; i < num_tracks_;) {
+    if (tracks_[i].misses > max_misses_) std::swap(tracks_[i], tracks_[--num_tracks_]);
+    else ++i;
+  }
+  for (auto j = 0; j < num_detections && num_tracks_ < kCapacity; ++j) {
+    if (detection_track_ids_[j] >= 0) continue;
+    auto &&armor = armors[j];
+    auto &&track = tracks_[num_tracks_++];
+    track.id = next_id_++;
+    track.armor_id = armor.ID();
+    track.hits = 1;
+    track.misses = 0;
+    track.size = cv::boundingRect(armor.Vertexes()).size();
+    track.tracker.SetParam(tracker_param_);
+    track.tracker.Reset(armor.STVecWorld(), time_stamp);
+    detection_track_ids_[j] = track.id;
+  }
+}
+
+const association::Track *association::Associator::Find(int id) const {
+  for (auto i = 0; i < num_tracks_; ++i)
+    if (tracks_[i].id == id) return &tracks_[i];
+  return nullptr;
+}
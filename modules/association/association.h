@@ -0,0 +1,81 @@
+#ifndef SRM_IC_2023_MODULES_ASSOCIATION_ASSOCIATION_H_
+#define SRM_IC_2023_MODULES_ASSOCIATION_ASSOCIATION_H_
+
+#include <array>
+#include "common/armor.h"
+#include "tracker/tracker.h"
+
+namespace association {
+constexpr int kCapacity = 16;  ///< 跟踪目标与单帧参与关联的装甲板的最大数量
+
+/// 跟踪轨迹
+struct Track {
+  int id;                      ///< 轨迹编号，在关联器生命周期内唯一
+  int armor_id;                ///< 最近一次关联的装甲板编号，0 表示未分类
+  int hits;                    ///< 累计关联成功的帧数
+  int misses;                  ///< 连续未关联的帧数
+  cv::Size2f size;             ///< 最近一次关联的装甲板外接矩形尺寸
+  tracker::CVTracker tracker;  ///< 世界坐标系跟踪器
+};
+
+/**
+ * @brief 多目标数据关联器，每帧将识别到的装甲板指派给已有轨迹
+ * @details 代价由预测位置与测量位置的世界坐标距离、预测位置投影到图像上的外接矩形与装甲板外接矩形的交并比加权得到，
+ *   距离超过门限或编号冲突的配对禁止关联；在固定容量的代价矩阵上用匈牙利算法求全局最优指派，
+ *   最坏耗时为 O(kCapacity^3)，关联过程不分配内存；未关联的装甲板生成新轨迹，连续丢失过多帧的轨迹被移除
+ */
+class Associator final {
+ public:
+  Associator() = default;
+  ~Associator() = default;
+
+  /// 轨迹列表，前 NumTracks() 个有效
+  attr_reader_ref(tracks_, Tracks)
+  /// 有效轨迹数量
+  attr_reader_val(num_tracks_, NumTracks)
+  /// 最近一帧中前 kCapacity 个装甲板所属的轨迹编号，下标与输入装甲板一致，-1 表示轨迹已满、未能关联
+  attr_reader_ref(detection_track_ids_, DetectionTrackIDs)
+
+  /**
+   * @brief 初始化关联器
+   * @param [in] config_file 配置文件路径
+   * @return 是否初始化成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+
+  /**
+   * @brief 以一帧识别结果更新全部轨迹
+   * @param [in] armors 识别到的装甲板，超出 kCapacity 的部分不参与关联
+   * @param time_stamp 帧时间戳，单位：ns
+   * @param [in] coord_solver 坐标求解器
+   * @param [in] euler_angle 当前云台姿态欧拉角
+   */
+  void Update(std::vector<Armor> REF_IN armors,
+              uint64_t time_stamp,
+              coordinate::CoordSolver REF_IN coord_solver,
+              coordinate::EAngle REF_IN euler_angle);
+
+  /**
+   * @brief 按编号查找轨迹
+   * @param id 轨迹编号
+   * @return 轨迹指针，不存在时为空
+   */
+  [[nodiscard]] const Track *Find(int id) const;
+
+  /// 清除全部轨迹
+  void Clear() { num_tracks_ = 0; }
+
+ private:
+  tracker::Param tracker_param_;                      ///< 新轨迹的跟踪器参数
+  double gate_distance_{};                            ///< 关联距离门限，单位：m
+  double distance_weight_{};                          ///< 归一化距离的代价权重
+  double overlap_weight_{};                           ///< 图像外接矩形不重叠程度 (1 - IoU) 的代价权重
+  int max_misses_{};                                  ///< 轨迹允许连续丢失的最大帧数
+  int next_id_{};                                     ///< 下一条新轨迹的编号
+  std::array<Track, kCapacity> tracks_;               ///< 轨迹列表
+  int num_tracks_{};                                  ///< 有效轨迹数量
+  std::array<int, kCapacity> detection_track_ids_{};  ///< 每个装甲板所属的轨迹编号
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_ASSOCIATION_ASSOCIATION_H_
@@ -0,0 +1,162 @@
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <glog/logging.h>
+#include "association/association.h"
+#include "benchmark-association.h"
+
+benchmark::Registry<benchmark::association::AssociationBenchmark>
+    benchmark::association::AssociationBenchmark::registry_("association");
+
+namespace {
+/// 小装甲板四个角点相对中心的坐标，顺序同 Armor
+const std::array<coordinate::CTVec, 4> kSmallArmorCorners{coordinate::CTVec(-0.066, 0.027, 0),
+                                                          coordinate::CTVec(-0.066, -0.027, 0),
+                                                          coordinate::CTVec(0.066, -0.027, 0),
+                                                          coordinate::CTVec(0.066, 0.027, 0)};
+
+/**
+ * @brief 计算目标在指定时间的真实位置
+ * @details 目标按编号分布在 4 个距离（3 m 至 7.5 m）和 4 个高度上，横向振幅 1.5 m，频率随编号递增，
+ *   同一距离的目标上下相距 0.3 m，不同距离的目标在图像上反复交叉
+ * @param index 目标编号
+ * @param t 时间，单位：s
+ * @return 目标中心的世界坐标系直角坐标
+ */
+coordinate::CTVec TargetPosition(int index, double t) {
+  return {1.5 * std::sin(M_PI * (0.3 + 0.03 * index) * t + index), -0.45 + 0.3 * (index / 4 % 4),
+          3 + 1.5 * (index % 4)};
+}
+}
+
+bool benchmark::association::AssociationBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open association benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int repeats = 0;
+  baseline_["WIDTH"] >> size_.width;
+  baseline_["HEIGHT"] >> size_.height;
+  baseline_["REPEATS"] >> repeats;
+  baseline_["TARGETS"] >> targets_;
+  baseline_["FRAMES"] >> frames_;
+  baseline_["FRAME_RATE"] >> frame_rate_;
+  baseline_["DROP_RATE"] >> drop_rate_;
+  baseline_["ASSOCIATION_CONFIG"] >> association_config_;
+  baseline_["COORD_CONFIG"] >> coord_config_;
+  if (size_.empty() || repeats <= 0 || targets_ <= 0 || targets_ > ::association::kCapacity || frames_ <= 0
+      || frame_rate_ <= 0 || drop_rate_ < 0 || drop_rate_ >= 1) {
+    LOG(ERROR) << "Invalid image size, repeat count, target count, frame count, frame rate or drop rate "
+               << "in association benchmark baseline. At most " << ::association::kCapacity
+               << " targets are supported.";
+    baseline_.release();
+    return false;
+  }
+  if (association_config_.empty() || coord_config_.empty()) {
+    LOG(ERROR) << "Association or coordinate configuration not found in association benchmark baseline.";
+    baseline_.release();
+    return false;
+  }
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "association");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized association benchmark with " << targets_ << " targets, " << frames_ << " frames and "
+            << repeats_ << " repeats.";
+  return true;
+}
+
+int benchmark::association::AssociationBenchmark::Run() {
+  cv::Mat intrinsic_mat = (cv::Mat_<double>(3, 3) << 1500, 0, size_.width / 2, 0, 1500, size_.height / 2, 0, 0, 1);
+  coordinate::CoordSolver coord_solver;
+  if (!coord_solver.Initialize(coord_config_, intrinsic_mat, cv::Mat::zeros(1, 5, CV_64F))) {
+    LOG(ERROR) << "Failed to initialize coordinate solver.";
+    return 1;
+  }
+  ::association::Associator associator;
+  if (!associator.Initialize(association_config_)) {
+    LOG(ERROR) << "Failed to initialize associator.";
+    return 1;
+  }
+
+  std::mt19937 random_engine(0);
+  std::normal_distribution<float> pixel_noise_distribution(0, 0.3);
+  std::uniform_real_distribution<double> drop_distribution(0, 1);
+  coordinate::EAngle euler_angle{0, 0, 0};
+  auto rm_imu = coordinate::CoordSolver::EAngleToRMat(euler_angle);
+  auto frame_time_ns = static_cast<uint64_t>(1e9 / frame_rate_);
+  std::vector<int> order(targets_);
+  std::iota(order.begin(), order.end(), 0);
+  // 生成一帧装甲板，角点由真实位置投影并加入像素噪声，再经 PnP 解算得到测量值
+  auto make_frame = [&](int frame_index, double drop_rate, std::vector<Armor> REF_OUT armors,
+                        std::vector<int> REF_OUT truth) {
+    armors.clear();
+    truth.clear();
+    std::shuffle(order.begin(), order.end(), random_engine);
+    for (auto index : order) {
+      if (drop_distribution(random_engine) < drop_rate) continue;
+      auto ctv_world = TargetPosition(index, frame_index / frame_rate_);
+      std::array<cv::Point2f, 4> vertexes;
+      for (auto k = 0; k < 4; ++k)
+        vertexes[k] = coord_solver.CamToPic(coord_solver.WorldToCam(ctv_world + kSmallArmorCorners[k], rm_imu))
+            + cv::Point2f(pixel_noise_distribution(random_engine), pixel_noise_distribution(random_engine));
+      armors.emplace_back(vertexes, coord_solver, euler_angle, Armor::ArmorSize::SMALL);
+      truth.push_back(index);
+    }
+  };
+
+  std::vector<Armor> armors;
+  std::vector<int> truth, last_track_ids(targets_, -1);
+  size_t id_switches = 0, unassigned = 0;
+  for (auto frame_index = 0; frame_index < frames_; ++frame_index) {
+    make_frame(frame_index, drop_rate_, armors, truth);
+    associator.Update(armors, frame_index * frame_time_ns, coord_solver, euler_angle);
+    for (size_t j = 0; j < armors.size(); ++j) {
+      int track_id = associator.DetectionTrackIDs()[j], &last_track_id = last_track_ids[truth[j]];
+      if (track_id < 0) {
+        ++unassigned;
+        continue;
+      }
+      if (last_track_id >= 0 && last_track_id != track_id) ++id_switches;
+      last_track_id = track_id;
+    }
+  }
+  // 满容量单帧计时：全部目标可见，时间戳不变，每次重复都计算完整的代价矩阵并求解指派
+  make_frame(frames_, 0, armors, truth);
+  double update_time = MeasureTime([&]() {
+    associator.Update(armors, frames_ * frame_time_ns, coord_solver, euler_angle);
+  }, repeats_);
+
+  LOG(INFO) << std::left << std::setw(8) << "TARGETS" << std::right << std::setw(12) << "ID SWITCHES"
+            << std::setw(12) << "UNASSIGNED" << std::setw(12) << "UPDATE(us)";
+  LOG(INFO) << std::left << std::setw(8) << targets_ << std::right << std::setw(12) << id_switches
+            << std::setw(12) << unassigned << std::fixed << std::setprecision(3)
+            << std::setw(12) << update_time * 1e-3;
+  auto baseline = platform_baseline_;
+  if (baseline.empty()) return 0;
+  size_t regressions = 0;
+  int baseline_max_id_switches = 0;
+  double baseline_max_time = 0;
+  baseline["MAX_ID_SWITCHES"] >> baseline_max_id_switches;
+  baseline["MAX_TIME_US"] >> baseline_max_time;
+  if (id_switches > static_cast<size_t>(baseline_max_id_switches)) {
+    LOG(ERROR) << "Association accuracy regressed: " << id_switches << " ID switches exceed baseline "
+               << baseline_max_id_switches << ".";
+    ++regressions;
+  }
+#if NDEBUG
+  if (update_time * 1e-3 > baseline_max_time) {
+    LOG(ERROR) << "Association speed regressed: " << update_time * 1e-3 << " us exceeds baseline "
+               << baseline_max_time << " us.";
+    ++regressions;
+  }
+#endif
+  if (regressions) {
+    LOG(ERROR) << regressions << " association case(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All association cases passed baseline on " << Platform() << ".";
+  return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_ASSOCIATION_BENCHMARK_ASSOCIATION_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_ASSOCIATION_BENCHMARK_ASSOCIATION_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::association {
+/**
+ * @brief 多目标数据关联基准测试类，统计轨迹编号跳变次数并测量满容量关联的耗时
+ * @details 多块装甲板分布在不同距离与高度上横向往复运动，在图像上相互交叉；每帧随机丢弃部分装甲板并打乱顺序，
+ *   由投影得到的角点经 PnP 解算后输入关联器；编号跳变次数或满容量单帧耗时（仅 Release 构建检查）超过基准值时，测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("association") @endcode 获取该类的公共接口指针
+ */
+class AssociationBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<AssociationBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  cv::Size size_;                   ///< 合成图像尺寸
+  size_t repeats_{};                ///< 计时重复次数
+  int targets_{};                   ///< 目标数量
+  int frames_{};                    ///< 帧数
+  double frame_rate_{};             ///< 帧率，单位：Hz
+  double drop_rate_{};              ///< 每帧随机丢弃装甲板的概率
+  std::string association_config_;  ///< 关联器配置文件路径
+  std::string coord_config_;        ///< 坐标系配置文件路径
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_ASSOCIATION_BENCHMARK_ASSOCIATION_H_
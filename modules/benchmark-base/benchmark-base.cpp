@@ -0,0 +1,41 @@
+#include <chrono>
+#include <glog/logging.h>
+#include "benchmark-base.h"
+
+double benchmark::Benchmark::MeasureTime(std::function<void()> REF_IN func, size_t repeats) {
+  double min_time = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < repeats; ++i) {
+    auto start_time = std::chrono::steady_clock::now();
+    func();
+    auto end_time = std::chrono::steady_clock::now();
+    min_time = std::min(min_time, static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count()));
+  }
+  return min_time;
+}
+
+std::string benchmark::Benchmark::Platform() {
+#if defined(__x86_64__)
+  return "x86_64";
+#elif defined(__aarch64__)
+  return "aarch64";
+#else
+  return "generic";
+#endif
+}
+
+cv::FileNode benchmark::Benchmark::PlatformBaseline(cv::FileStorage REF_IN baseline, std::string REF_IN name) {
+  auto platform_baseline = baseline[Platform()];
+  if (platform_baseline.empty())
+    LOG(WARNING) << "No " << name << " baseline found for platform " << Platform()
+                 << ". Regression checks are skipped and results will be reported only.";
+  return platform_baseline;
+}
+
+cv::Mat benchmark::Benchmark::Mosaic(cv::Mat REF_IN image) {
+  cv::Mat raw(image.size(), CV_8UC1);
+  for (auto j = 0; j < raw.rows; ++j)
+    for (auto i = 0; i < raw.cols; ++i)
+      raw.at<uchar>(j, i) = image.at<cv::Vec3b>(j, i)[j % 2 + i % 2 == 0 ? 2 : j % 2 + i % 2 == 2 ? 0 : 1];
+  return raw;
+}
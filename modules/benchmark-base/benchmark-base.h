@@ -0,0 +1,66 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_BASE_BENCHMARK_BASE_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_BASE_BENCHMARK_BASE_H_
+
+#include <functional>
+#include <string>
+#include <opencv2/core/mat.hpp>
+#include <opencv2/core/persistence.hpp>
+#include "common/factory.h"
+
+enable_factory(benchmark, Benchmark)
+
+namespace benchmark {
+/// 性能与精度基准测试公共接口类
+class Benchmark {
+ public:
+  Benchmark() = default;
+  virtual ~Benchmark() = default;
+
+  /**
+   * @brief 初始化基准测试
+   * @param [in] config_file 基准数据配置文件路径
+   * @return 是否初始化成功
+   */
+  virtual bool Initialize(std::string REF_IN config_file) = 0;
+
+  /**
+   * @brief 执行基准测试
+   * @return 错误码，0 表示所有项目均未退化，可作为 main() 的返回值
+   */
+  virtual int Run() = 0;
+
+ protected:
+  /**
+   * @brief 测量函数耗时
+   * @param [in] func 待测函数
+   * @param repeats 重复次数
+   * @return 多次执行中的最短耗时，单位：ns
+   */
+  static double MeasureTime(std::function<void()> REF_IN func, size_t repeats);
+
+  /**
+   * @brief 获取当前平台名称，用于在基准数据中选择对应的节点
+   * @return 平台名称
+   */
+  static std::string Platform();
+
+  /**
+   * @brief 取出基准数据中当前平台的节点
+   * @details 速度与精度阈值随平台不同，基准数据按 Platform() 的名称分节点存放；
+   *   缺少当前平台的节点时给出警告并跳过全部退化检查，只报告测量结果，需在该平台上实测后补充节点
+   * @param [in] baseline 基准数据文件
+   * @param [in] name 基准测试名称，用于日志
+   * @return 当前平台的基准数据节点，缺少时为空节点
+   */
+  static cv::FileNode PlatformBaseline(cv::FileStorage REF_IN baseline, std::string REF_IN name);
+
+  /**
+   * @brief 按 BayerRG 排列对彩色图像采样，生成合成的原始图像
+   * @param [in] image BGR 图像
+   * @return 8 位 Bayer 图像
+   */
+  static cv::Mat Mosaic(cv::Mat REF_IN image);
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_BASE_BENCHMARK_BASE_H_
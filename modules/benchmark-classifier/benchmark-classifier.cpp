@@ -0,0 +1,170 @@
+#include <iomanip>
+#include <random>
+#include <glog/logging.h>
+#include <opencv2/imgproc.hpp>
+#include "classifier/classifier.h"
+#include "common/frame.h"
+#include "benchmark-classifier.h"
+
+benchmark::Registry<benchmark::classifier::ClassifierBenchmark>
+    benchmark::classifier::ClassifierBenchmark::registry_("classifier");
+
+namespace {
+constexpr int kColumns = 5;              ///< 合成装甲板网格的列数
+constexpr int kInputSize[2] = {20, 28};  ///< 网络输入图案宽度、高度
+constexpr int kHiddenUnits = 32;         ///< 隐藏层单元数
+constexpr int kClasses = 6;              ///< 类别数，含负样本
+
+/**
+ * @brief 生成随机分类器权重
+ * @details 推理耗时只取决于网络结构而与权重取值无关，使用固定种子的随机权重，不依赖训练得到的权重文件
+ * @param [out] weights 内存中的权重存储，键名与权重文件相同
+ */
+void RandomWeights(cv::FileStorage REF_OUT weights) {
+  cv::RNG rng(0);
+  cv::Mat fc1_weights(kHiddenUnits, kInputSize[0] * kInputSize[1], CV_32F), fc1_bias(1, kHiddenUnits, CV_32F),
+      fc2_weights(kClasses, kHiddenUnits, CV_32F), fc2_bias(1, kClasses, CV_32F);
+  for (auto &&mat : {fc1_weights, fc1_bias, fc2_weights, fc2_bias}) rng.fill(mat, cv::RNG::NORMAL, 0, 0.1);
+  std::vector<std::string> classes{"negative"};
+  for (auto k = 1; k < kClasses; ++k) classes.push_back(std::to_string(k));
+  cv::FileStorage writer(".yaml", cv::FileStorage::WRITE | cv::FileStorage::MEMORY);
+  writer << "INPUT_SIZE" << std::vector<int>(kInputSize, kInputSize + 2) << "CLASSES" << classes
+         << "FC1_WEIGHTS" << fc1_weights << "FC1_BIAS" << fc1_bias
+         << "FC2_WEIGHTS" << fc2_weights << "FC2_BIAS" << fc2_bias;
+  weights.open(writer.releaseAndGetString(), cv::FileStorage::READ | cv::FileStorage::MEMORY);
+}
+
+/**
+ * @brief 绘制一个灯条
+ * @param [out] image BGR 图像
+ * @param [in] center 灯条中心
+ * @param length 灯条长度
+ * @param tilt 灯条倾角，单位：度
+ * @param [out] top 灯条上端点
+ * @param [out] bottom 灯条下端点
+ */
+void DrawLightBar(cv::Mat REF_OUT image, cv::Point2f REF_IN center, float length, float tilt,
+                  cv::Point2f REF_OUT top, cv::Point2f REF_OUT bottom) {
+  cv::Point2f vertexes[4];
+  cv::RotatedRect(center, cv::Size2f(std::max(3.f, length / 7), length), tilt).points(vertexes);
+  std::vector<cv::Point> polygon;
+  for (auto &&p : vertexes) polygon.emplace_back(cvRound(p.x), cvRound(p.y));
+  cv::fillConvexPoly(image, polygon, cv::Scalar(60, 80, 250));
+  std::sort(vertexes, vertexes + 4, [](cv::Point2f REF_IN a, cv::Point2f REF_IN b) { return a.y < b.y; });
+  top = (vertexes[0] + vertexes[1]) / 2;
+  bottom = (vertexes[2] + vertexes[3]) / 2;
+}
+
+/**
+ * @brief 生成带编号贴纸的合成测试图像
+ * @details 装甲板按网格排列，编号依次为 1 到 5，贴纸数字高度约为灯条长度的 1.2 倍
+ * @param size 图像尺寸
+ * @param count 装甲板数量
+ * @param [out] candidates 装甲板候选，id 为真实编号
+ * @return BGR 图像
+ */
+cv::Mat SyntheticImage(cv::Size size, int count, std::vector<::classifier::Candidate> REF_OUT candidates) {
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<float> length_distribution(24, 64), tilt_distribution(-10, 10);
+  cv::Mat image(size, CV_8UC3);
+  cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(50));
+  int rows = (count + kColumns - 1) / kColumns;
+  candidates.clear();
+  for (auto k = 0; k < count; ++k) {
+    float length = length_distribution(random_engine), tilt = tilt_distribution(random_engine);
+    auto size_type = k % 4 == 3 ? Armor::ArmorSize::BIG : Armor::ArmorSize::SMALL;
+    float distance = length * (size_type == Armor::ArmorSize::BIG ? 4.2f : 2.3f);
+    cv::Point2f center(static_cast<float>(size.width * (2 * (k % kColumns) + 1)) / (2 * kColumns),
+                       static_cast<float>(size.height * (2 * (k / kColumns) + 1)) / (2 * rows));
+    ::classifier::Candidate candidate{{}, size_type, k % 5 + 1, 1};
+    auto &&v = candidate.vertexes;
+    DrawLightBar(image, center - cv::Point2f(distance / 2, 0), length, tilt, v[1], v[0]);
+    DrawLightBar(image, center + cv::Point2f(distance / 2, 0), length, tilt, v[2], v[3]);
+    auto text = std::to_string(candidate.id);
+    double font_scale = 1.2 * length / 22;
+    int thickness = std::max(1, cvRound(length / 8)), baseline;
+    auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, thickness, &baseline);
+    cv::Point origin(cvRound(center.x - text_size.width / 2.f), cvRound(center.y + text_size.height / 2.f));
+    cv::putText(image, text, origin, cv::FONT_HERSHEY_SIMPLEX, font_scale, cv::Scalar::all(200), thickness);
+    candidates.push_back(candidate);
+  }
+  return image;
+}
+}
+
+bool benchmark::classifier::ClassifierBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open classifier benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int repeats = 0;
+  baseline_["WIDTH"] >> size_.width;
+  baseline_["HEIGHT"] >> size_.height;
+  baseline_["REPEATS"] >> repeats;
+  baseline_["CANDIDATES"] >> candidates_;
+  if (size_.width < 4 || size_.height < 4 || size_.width % 2 || size_.height % 2 || repeats <= 0 || candidates_ <= 0) {
+    LOG(ERROR) << "Invalid image size, repeat count or candidate count in classifier benchmark baseline. "
+               << "Image width and height must be even numbers no less than 4.";
+    baseline_.release();
+    return false;
+  }
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "classifier");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized classifier benchmark with " << candidates_ << " candidates per frame and "
+            << repeats_ << " repeats.";
+  return true;
+}
+
+int benchmark::classifier::ClassifierBenchmark::Run() {
+  cv::FileStorage weights;
+  RandomWeights(weights);
+  ::classifier::Classifier batched, single;
+  if (!batched.Initialize(weights.root(), candidates_) || !single.Initialize(weights.root(), 1)) {
+    LOG(ERROR) << "Failed to initialize armor classifier.";
+    return 1;
+  }
+  std::vector<::classifier::Candidate> candidates;
+  auto image = SyntheticImage(size_, candidates_, candidates);
+  // 识别器将 Bayer 帧中候选所在的区域解马赛克后再分类，这里同样经 Frame::Crop() 处理整帧
+  Frame bayer_frame;
+  bayer_frame.bayer = Mosaic(image);
+  bayer_frame.bayer_pattern = simd::BayerPattern::RG;
+  cv::Mat demosaiced;
+  bayer_frame.Crop({{0, 0}, size_}, demosaiced);
+  std::vector<std::pair<std::string, cv::Mat>> cases{{"bayer", demosaiced}, {"bgr", image}};
+
+  int num_threads = cv::getNumThreads();
+  cv::setNumThreads(1);
+  LOG(INFO) << std::left << std::setw(8) << "INPUT" << std::right << std::setw(12) << "BATCH(ms)"
+            << std::setw(12) << "SINGLE(ms)" << std::setw(10) << "SPEEDUP";
+  size_t regressions = 0;
+  for (auto &&[name, input] : cases) {
+    double batch_time = MeasureTime([&]() { batched.Classify(input, candidates); }, repeats_);
+    double single_time = MeasureTime([&]() { single.Classify(input, candidates); }, repeats_);
+    LOG(INFO) << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << batch_time * 1e-6 << std::setw(12) << single_time * 1e-6
+              << std::setw(10) << std::setprecision(2) << single_time / batch_time;
+    auto baseline = platform_baseline_[name];
+    if (baseline.empty()) continue;
+    double baseline_max_time = 0;
+    baseline["MAX_TIME_MS"] >> baseline_max_time;
+#if NDEBUG
+    if (batch_time * 1e-6 > baseline_max_time) {
+      LOG(ERROR) << name << " speed regressed: " << batch_time * 1e-6 << " ms exceeds baseline "
+                 << baseline_max_time << " ms.";
+      ++regressions;
+    }
+#endif
+  }
+  cv::setNumThreads(num_threads);
+  if (regressions) {
+    LOG(ERROR) << regressions << " classifier case(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All classifier cases passed baseline on " << Platform() << ".";
+  return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_CLASSIFIER_BENCHMARK_CLASSIFIER_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_CLASSIFIER_BENCHMARK_CLASSIFIER_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::classifier {
+/**
+ * @brief 装甲板编号分类器基准测试类，测量一帧内全部候选整批分类的耗时
+ * @details 在合成图像上绘制带编号贴纸的装甲板，分别以 BayerRG8 帧（与识别器相同，经 Frame::Crop() 解马赛克）和 BGR 帧输入，
+ *   并与逐个候选推理（批次大小为 1）对比；网络使用固定种子的随机权重，只检查耗时，整批耗时超过基准值（仅 Release 构建检查）时，
+ *   测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("classifier") @endcode 获取该类的公共接口指针
+ */
+class ClassifierBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<ClassifierBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  cv::Size size_;                   ///< 合成图像尺寸
+  size_t repeats_{};                ///< 计时重复次数
+  int candidates_{};                ///< 每帧候选数量
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_CLASSIFIER_BENCHMARK_CLASSIFIER_H_
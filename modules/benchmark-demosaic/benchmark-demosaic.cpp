@@ -0,0 +1,233 @@
+#include <iomanip>
+#include <random>
+#include <glog/logging.h>
+#include <opencv2/imgproc.hpp>
+#include <DxImageProc.h>
+#include "simd/simd.h"
+#include "benchmark-demosaic.h"
+
+benchmark::Registry<benchmark::demosaic::DemosaicBenchmark>
+    benchmark::demosaic::DemosaicBenchmark::registry_("demosaic");
+
+namespace {
+typedef std::function<void(cv::Mat REF_IN raw, cv::Mat REF_OUT image)> Converter;
+
+constexpr unsigned char kMaskThreshold = 40;  ///< 色差掩码阈值
+
+/// 待测输出格式描述
+struct Case {
+  std::string name;               ///< 格式名，同时作为基准数据的键
+  Converter simd;                 ///< SIMD 实现
+  Converter opencv;               ///< OpenCV 实现，用于速度对比
+  Converter dx;                   ///< 大恒 Dx 库实现，用于速度对比，可为空
+  Converter exact;                ///< 参考实现，用于精度对比
+};
+
+/**
+ * @brief 半分辨率输出的标量参考实现，BayerRG 排列
+ * @param [in] raw 源图像
+ * @param [out] image 输出图像
+ * @param rgb 是否以 RGB 顺序输出
+ */
+void HalfReference(cv::Mat REF_IN raw, cv::Mat REF_OUT image, bool rgb) {
+  image.create(raw.rows / 2, raw.cols / 2, CV_8UC3);
+  for (auto j = 0; j < image.rows; ++j)
+    for (auto i = 0; i < image.cols; ++i) {
+      auto r = raw.at<uchar>(2 * j, 2 * i), b = raw.at<uchar>(2 * j + 1, 2 * i + 1);
+      auto g = static_cast<uchar>((raw.at<uchar>(2 * j, 2 * i + 1) + raw.at<uchar>(2 * j + 1, 2 * i) + 1) >> 1);
+      image.at<cv::Vec3b>(j, i) = rgb ? cv::Vec3b(r, g, b) : cv::Vec3b(b, g, r);
+    }
+}
+
+/**
+ * @brief 色差掩码的标量参考实现，BayerRG 排列
+ * @param [in] raw 源图像
+ * @param [out] image 输出掩码
+ * @param red 是否以红色为目标
+ */
+void MaskReference(cv::Mat REF_IN raw, cv::Mat REF_OUT image, bool red) {
+  image.create(raw.rows / 2, raw.cols / 2, CV_8UC1);
+  for (auto j = 0; j < image.rows; ++j)
+    for (auto i = 0; i < image.cols; ++i) {
+      int r = raw.at<uchar>(2 * j, 2 * i), b = raw.at<uchar>(2 * j + 1, 2 * i + 1);
+      image.at<uchar>(j, i) = (red ? r - b : b - r) > kMaskThreshold ? 255 : 0;
+    }
+}
+
+/**
+ * @brief 先解马赛克再求色差掩码的 OpenCV 实现，BayerRG 排列
+ * @param [in] raw 源图像
+ * @param [out] image 输出掩码，全分辨率
+ * @param red 是否以红色为目标
+ */
+void MaskOpenCV(cv::Mat REF_IN raw, cv::Mat REF_OUT image, bool red) {
+  cv::Mat bgr, channels[3];
+  cv::cvtColor(raw, bgr, cv::COLOR_BayerBG2BGR);
+  cv::split(bgr, channels);
+  if (red) cv::subtract(channels[2], channels[0], image);
+  else cv::subtract(channels[0], channels[2], image);
+  cv::threshold(image, image, kMaskThreshold, 255, cv::THRESH_BINARY);
+}
+
+/**
+ * @brief 以 simd::demosaic_8u 实现的解马赛克，BayerRG 排列
+ * @param [in] raw 源图像
+ * @param [out] image 输出图像
+ * @param format 输出格式
+ */
+void DemosaicSIMD(cv::Mat REF_IN raw, cv::Mat REF_OUT image, simd::DemosaicFormat format) {
+  bool half = format == simd::DemosaicFormat::HALF_BGR || format == simd::DemosaicFormat::HALF_RGB;
+  image.create(half ? raw.size() / 2 : raw.size(), CV_8UC3);
+  simd::demosaic_8u(raw.data, raw.cols, raw.rows, raw.step, image.data, image.step, simd::BayerPattern::RG, format);
+}
+
+/**
+ * @brief 以 simd::color_mask_8u 实现的色差掩码，BayerRG 排列
+ * @param [in] raw 源图像
+ * @param [out] image 输出掩码
+ * @param color 目标灯条颜色
+ */
+void MaskSIMD(cv::Mat REF_IN raw, cv::Mat REF_OUT image, simd::LightColor color) {
+  image.create(raw.size() / 2, CV_8UC1);
+  simd::color_mask_8u(raw.data, raw.cols, raw.rows, raw.step, image.data, image.step,
+                      simd::BayerPattern::RG, color, kMaskThreshold, true);
+}
+
+/**
+ * @brief 大恒 Dx 库邻域插值实现，BayerRG 排列
+ * @param [in] raw 源图像
+ * @param [out] image 输出图像
+ * @param order 输出通道顺序
+ */
+void DxReference(cv::Mat REF_IN raw, cv::Mat REF_OUT image, DX_RGB_CHANNEL_ORDER order) {
+  image.create(raw.size(), CV_8UC3);
+  DxRaw8toRGB24Ex(raw.data, image.data, raw.cols, raw.rows, RAW2RGB_NEIGHBOUR, BAYERRG, false, order);
+}
+
+/**
+ * @note OpenCV 以第二行第二、三列命名 Bayer 排列，其 BayerBG 即相机 SDK 中的 BayerRG
+ * @note 色差掩码的 OpenCV 对照为现有做法，即全分辨率解马赛克后逐通道相减并二值化
+ */
+std::vector<Case> Cases() {
+  return {
+      {"bgr",
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { DemosaicSIMD(raw, image, simd::DemosaicFormat::BGR); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { cv::cvtColor(raw, image, cv::COLOR_BayerBG2BGR); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { DxReference(raw, image, DX_ORDER_BGR); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { cv::cvtColor(raw, image, cv::COLOR_BayerBG2BGR); }},
+      {"rgb",
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { DemosaicSIMD(raw, image, simd::DemosaicFormat::RGB); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { cv::cvtColor(raw, image, cv::COLOR_BayerBG2RGB); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { DxReference(raw, image, DX_ORDER_RGB); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { cv::cvtColor(raw, image, cv::COLOR_BayerBG2RGB); }},
+      {"half_bgr",
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { DemosaicSIMD(raw, image, simd::DemosaicFormat::HALF_BGR); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) {
+         cv::Mat full;
+         cv::cvtColor(raw, full, cv::COLOR_BayerBG2BGR);
+         cv::resize(full, image, {}, 0.5, 0.5, cv::INTER_AREA);
+       },
+       nullptr,
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { HalfReference(raw, image, false); }},
+      {"half_rgb",
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { DemosaicSIMD(raw, image, simd::DemosaicFormat::HALF_RGB); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) {
+         cv::Mat full;
+         cv::cvtColor(raw, full, cv::COLOR_BayerBG2RGB);
+         cv::resize(full, image, {}, 0.5, 0.5, cv::INTER_AREA);
+       },
+       nullptr,
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { HalfReference(raw, image, true); }},
+      {"mask_red",
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { MaskSIMD(raw, image, simd::LightColor::RED); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { MaskOpenCV(raw, image, true); },
+       nullptr,
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { MaskReference(raw, image, true); }},
+      {"mask_blue",
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { MaskSIMD(raw, image, simd::LightColor::BLUE); },
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { MaskOpenCV(raw, image, false); },
+       nullptr,
+       [](cv::Mat REF_IN raw, cv::Mat REF_OUT image) { MaskReference(raw, image, false); }},
+  };
+}
+}
+
+bool benchmark::demosaic::DemosaicBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open demosaic benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int repeats = 0;
+  baseline_["WIDTH"] >> size_.width;
+  baseline_["HEIGHT"] >> size_.height;
+  baseline_["REPEATS"] >> repeats;
+  if (size_.width < 4 || size_.height < 4 || size_.width % 2 || size_.height % 2 || repeats <= 0) {
+    LOG(ERROR) << "Invalid image size or repeat count in demosaic benchmark baseline. "
+               << "Image width and height must be even numbers no less than 4.";
+    baseline_.release();
+    return false;
+  }
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "demosaic");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized demosaic benchmark with " << size_.width << "x" << size_.height
+            << " images and " << repeats_ << " repeats.";
+  return true;
+}
+
+int benchmark::demosaic::DemosaicBenchmark::Run() {
+  cv::Mat raw(size_, CV_8UC1);
+  std::mt19937 random_engine(0);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  for (auto it = raw.begin<uchar>(); it != raw.end<uchar>(); ++it)
+    *it = static_cast<uchar>(distribution(random_engine));
+  int num_threads = cv::getNumThreads();
+  cv::setNumThreads(1);
+  LOG(INFO) << std::left << std::setw(12) << "FORMAT" << std::right
+            << std::setw(12) << "SIMD(ms)" << std::setw(12) << "OPENCV(ms)" << std::setw(12) << "DX(ms)"
+            << std::setw(10) << "SPEEDUP" << std::setw(10) << "MAX DIFF";
+  size_t regressions = 0;
+  for (auto &&c : Cases()) {
+    cv::Mat simd_image, opencv_image, dx_image, exact_image;
+    double simd_time = MeasureTime([&]() { c.simd(raw, simd_image); }, repeats_);
+    double opencv_time = MeasureTime([&]() { c.opencv(raw, opencv_image); }, repeats_);
+    double dx_time = c.dx ? MeasureTime([&]() { c.dx(raw, dx_image); }, repeats_) : 0;
+    c.exact(raw, exact_image);
+    double max_diff = cv::norm(simd_image, exact_image, cv::NORM_INF);
+    double speedup = opencv_time / simd_time;
+    std::ostringstream dx_ms;
+    if (c.dx) dx_ms << std::fixed << std::setprecision(3) << dx_time * 1e-6;
+    else dx_ms << "-";
+    LOG(INFO) << std::left << std::setw(12) << c.name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << simd_time * 1e-6 << std::setw(12) << opencv_time * 1e-6 << std::setw(12) << dx_ms.str()
+              << std::setw(10) << std::setprecision(2) << speedup
+              << std::setw(10) << std::setprecision(0) << max_diff;
+    auto baseline = platform_baseline_[c.name];
+    if (baseline.empty()) continue;
+    double baseline_max_diff = 0, baseline_min_speedup = 0;
+    baseline["MAX_DIFF"] >> baseline_max_diff;
+    baseline["MIN_SPEEDUP"] >> baseline_min_speedup;
+    if (max_diff > baseline_max_diff) {
+      LOG(ERROR) << c.name << " accuracy regressed: max difference " << max_diff
+                 << " exceeds baseline " << baseline_max_diff << ".";
+      ++regressions;
+    }
+#if NDEBUG
+    if (speedup < baseline_min_speedup) {
+      LOG(ERROR) << c.name << " speed regressed: speedup " << speedup
+                 << " is below baseline " << baseline_min_speedup << ".";
+      ++regressions;
+    }
+#endif
+  }
+  cv::setNumThreads(num_threads);
+  if (regressions) {
+    LOG(ERROR) << regressions << " demosaic format(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All demosaic formats passed baseline on " << Platform() << ".";
+  return 0;
+}
@@ -0,0 +1,30 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_DEMOSAIC_BENCHMARK_DEMOSAIC_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_DEMOSAIC_BENCHMARK_DEMOSAIC_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::demosaic {
+/**
+ * @brief Bayer 解马赛克基准测试类，在合成 BayerRG8 图像上对比 simd::demosaic_8u、simd::color_mask_8u 与 OpenCV、大恒 Dx 库的速度
+ * @details 全分辨率输出以 OpenCV 双线性插值为参考，半分辨率输出和色差掩码以逐像素标量实现为参考，统计最大像素差；
+ *   任一输出格式的最大像素差超过基准值，或相对 OpenCV 的加速比低于基准值（仅 Release 构建检查）时，测试失败
+ * @note OpenCV 限制为单线程运行，以便与单线程的 SIMD 实现对比
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("demosaic") @endcode 获取该类的公共接口指针
+ */
+class DemosaicBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<DemosaicBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  cv::Size size_;                   ///< 合成图像尺寸
+  size_t repeats_{};                ///< 计时重复次数
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_DEMOSAIC_BENCHMARK_DEMOSAIC_H_
@@ -0,0 +1,190 @@
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <glog/logging.h>
+#include <opencv2/imgproc.hpp>
+#include "detector-base/detector-base.h"
+#include "benchmark-detector.h"
+
+benchmark::Registry<benchmark::detector::DetectorBenchmark>
+    benchmark::detector::DetectorBenchmark::registry_("detector");
+
+namespace {
+constexpr int kGridSize = 4;  ///< 合成装甲板网格的行列数
+
+/**
+ * @brief 生成合成测试图像
+ * @details 装甲板按网格排列，各行中心位于图像高度的奇数倍 1/8 处，与 8 条带分块的接缝行重合，使灯条跨越接缝；
+ *   两灯条之间绘制编号贴纸，使其能通过分类器
+ * @param size 图像尺寸
+ * @param speckles 反光噪点数量
+ * @return BGR 图像，红色灯条
+ */
+cv::Mat SyntheticImage(cv::Size size, int speckles) {
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<float> length_distribution(24, 64), tilt_distribution(-10, 10);
+  cv::Mat image(size, CV_8UC3);
+  cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(50));
+  auto draw_light_bar = [&](cv::Point2f REF_IN center, float length, float tilt) {
+    cv::Point2f vertexes[4];
+    cv::RotatedRect(center, cv::Size2f(std::max(3.f, length / 7), length), tilt).points(vertexes);
+    std::vector<cv::Point> polygon;
+    for (auto &&p : vertexes) polygon.emplace_back(cvRound(p.x), cvRound(p.y));
+    cv::fillConvexPoly(image, polygon, cv::Scalar(60, 80, 250));
+  };
+  for (auto row = 0; row < kGridSize; ++row)
+    for (auto col = 0; col < kGridSize; ++col) {
+      float length = length_distribution(random_engine), tilt = tilt_distribution(random_engine);
+      // 小装甲板灯条间距约为灯条长度的 2.3 倍，大装甲板约为 4.2 倍
+      float distance = length * ((row + col) % 3 ? 2.3f : 4.2f);
+      cv::Point2f center(static_cast<float>(size.width * (2 * col + 1)) / (2 * kGridSize),
+                         static_cast<float>(size.height * (2 * row + 1)) / (2 * kGridSize));
+      draw_light_bar(center - cv::Point2f(distance / 2, 0), length, tilt);
+      draw_light_bar(center + cv::Point2f(distance / 2, 0), length, tilt);
+      auto text = std::to_string((row + col) % 5 + 1);
+      double font_scale = 1.2 * length / 22;
+      int thickness = std::max(1, cvRound(length / 8)), baseline;
+      auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, thickness, &baseline);
+      cv::Point origin(cvRound(center.x - text_size.width / 2.f), cvRound(center.y + text_size.height / 2.f));
+      cv::putText(image, text, origin, cv::FONT_HERSHEY_SIMPLEX, font_scale, cv::Scalar::all(200), thickness);
+    }
+  std::uniform_int_distribution<int> x_distribution(0, size.width - 4), y_distribution(0, size.height - 4),
+      speckle_distribution(1, 3);
+  for (auto i = 0; i < speckles; ++i) {
+    cv::Point p(x_distribution(random_engine), y_distribution(random_engine));
+    auto s = speckle_distribution(random_engine);
+    cv::rectangle(image, cv::Rect(p, cv::Size(s, s)), cv::Scalar(30, 60, 240), -1);
+  }
+  return image;
+}
+
+/**
+ * @brief 比较两组识别结果是否完全一致
+ * @param [in] a 识别结果
+ * @param [in] b 识别结果
+ * @return 装甲板数量、顺序、类型和角点坐标是否全部相同
+ */
+bool SameArmors(std::vector<Armor> REF_IN a, std::vector<Armor> REF_IN b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](Armor REF_IN x, Armor REF_IN y) {
+    return x.Size() == y.Size() && x.Vertexes() == y.Vertexes();
+  });
+}
+}
+
+bool benchmark::detector::DetectorBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open detector benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int repeats = 0;
+  baseline_["WIDTH"] >> size_.width;
+  baseline_["HEIGHT"] >> size_.height;
+  baseline_["REPEATS"] >> repeats;
+  baseline_["SPECKLES"] >> speckles_;
+  baseline_["DETECTOR_CONFIG"] >> detector_config_;
+  baseline_["COORD_CONFIG"] >> coord_config_;
+  baseline_["THREADS"] >> threads_;
+  if (size_.width < 4 || size_.height < 4 || size_.width % 2 || size_.height % 2 || repeats <= 0) {
+    LOG(ERROR) << "Invalid image size or repeat count in detector benchmark baseline. "
+               << "Image width and height must be even numbers no less than 4.";
+    baseline_.release();
+    return false;
+  }
+  if (detector_config_.empty() || coord_config_.empty()) {
+    LOG(ERROR) << "Detector or coordinate configuration not found in detector benchmark baseline.";
+    baseline_.release();
+    return false;
+  }
+  if (threads_.empty() || std::any_of(threads_.begin(), threads_.end(), [](int t) { return t < 1; })) {
+    LOG(ERROR) << "Invalid thread counts in detector benchmark baseline.";
+    baseline_.release();
+    return false;
+  }
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "detector");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized detector benchmark with " << size_.width << "x" << size_.height
+            << " images and " << repeats_ << " repeats.";
+  return true;
+}
+
+int benchmark::detector::DetectorBenchmark::Run() {
+  cv::Mat intrinsic_mat = (cv::Mat_<double>(3, 3) << 1500, 0, size_.width / 2, 0, 1500, size_.height / 2, 0, 0, 1);
+  coordinate::CoordSolver coord_solver;
+  if (!coord_solver.Initialize(coord_config_, intrinsic_mat, cv::Mat::zeros(1, 5, CV_64F))) {
+    LOG(ERROR) << "Failed to initialize coordinate solver.";
+    return 1;
+  }
+  std::unique_ptr<::detector::Detector> detector;
+  detector.reset(::detector::CreateDetector("armor"));
+  if (!detector || !detector->Initialize(detector_config_)) {
+    LOG(ERROR) << "Failed to initialize armor detector.";
+    return 1;
+  }
+
+  std::vector<std::pair<std::string, Frame>> cases(2);
+  cases[0].first = "bayer";
+  cases[1].first = "bgr";
+  cases[1].second.image = SyntheticImage(size_, speckles_);
+  cases[0].second.bayer = Mosaic(cases[1].second.image);
+  cases[0].second.bayer_pattern = simd::BayerPattern::RG;
+
+  int num_threads = cv::getNumThreads();
+  cv::setNumThreads(1);
+  auto cores = std::thread::hardware_concurrency();
+  LOG(INFO) << std::left << std::setw(8) << "INPUT" << std::right << std::setw(8) << "THREADS"
+            << std::setw(12) << "TIME(ms)" << std::setw(10) << "SPEEDUP" << std::setw(8) << "ARMORS"
+            << std::setw(12) << "IDENTICAL";
+  size_t regressions = 0;
+  for (auto &&[name, frame] : cases) {
+    std::vector<Armor> reference_armors;
+    double reference_time = 0;
+    std::vector<double> baseline_min_speedup;
+    platform_baseline_[name]["MIN_SPEEDUP"] >> baseline_min_speedup;
+    for (size_t i = 0; i < threads_.size(); ++i) {
+      detector->SetThreads(threads_[i]);
+      std::vector<Armor> armors;
+      // 每次重复都从未处理过的帧复制，金字塔图层与彩色图像不会从上一次重复的缓存中取得
+      double time = MeasureTime([&]() {
+        auto fresh_frame = frame;
+        detector->Unlock();
+        detector->Detect(fresh_frame, simd::LightColor::RED, coord_solver, {0, 0, 0}, armors);
+      }, repeats_);
+      if (!i) {
+        reference_armors = armors;
+        reference_time = time;
+      }
+      bool identical = SameArmors(armors, reference_armors);
+      double speedup = reference_time / time;
+      LOG(INFO) << std::left << std::setw(8) << name << std::right << std::setw(8) << threads_[i]
+                << std::fixed << std::setprecision(3) << std::setw(12) << time * 1e-6
+                << std::setw(10) << std::setprecision(2) << speedup << std::setw(8) << armors.size()
+                << std::setw(12) << (identical ? "yes" : "NO");
+      if (!identical) {
+        LOG(ERROR) << name << " results with " << threads_[i] << " threads differ from "
+                   << threads_.front() << " thread(s).";
+        ++regressions;
+      }
+#if NDEBUG
+      if (i < baseline_min_speedup.size() && static_cast<unsigned>(threads_[i]) <= cores
+          && speedup < baseline_min_speedup[i]) {
+        LOG(ERROR) << name << " speed regressed with " << threads_[i] << " threads: speedup " << speedup
+                   << " is below baseline " << baseline_min_speedup[i] << ".";
+        ++regressions;
+      }
+#endif
+    }
+  }
+  cv::setNumThreads(num_threads);
+  if (cores < static_cast<unsigned>(*std::max_element(threads_.begin(), threads_.end())))
+    LOG(WARNING) << "Only " << cores << " cores available. Speedup with more threads is not checked.";
+  if (regressions) {
+    LOG(ERROR) << regressions << " detector case(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All detector cases passed baseline on " << Platform() << ".";
+  return 0;
+}
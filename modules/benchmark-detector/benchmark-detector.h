@@ -0,0 +1,33 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_DETECTOR_BENCHMARK_DETECTOR_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_DETECTOR_BENCHMARK_DETECTOR_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::detector {
+/**
+ * @brief 装甲板识别器全图搜索基准测试类，测量分块并行搜索在不同线程数下的耗时与加速比
+ * @details 在合成图像上放置装甲板灯条和大量细小反光噪点，分别以 BayerRG8 帧和 BGR 帧输入；
+ *   任一线程数下的识别结果与单线程不完全一致，或相对单线程的加速比低于基准值（仅 Release 构建且核心数足够时检查）时，测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("detector") @endcode 获取该类的公共接口指针
+ */
+class DetectorBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<DetectorBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  cv::Size size_;                   ///< 合成图像尺寸
+  size_t repeats_{};                ///< 计时重复次数
+  int speckles_{};                  ///< 反光噪点数量
+  std::string detector_config_;     ///< 识别器配置文件路径
+  std::string coord_config_;        ///< 坐标系配置文件路径
+  std::vector<int> threads_;        ///< 待测线程数列表，首项为加速比的参照
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_DETECTOR_BENCHMARK_DETECTOR_H_
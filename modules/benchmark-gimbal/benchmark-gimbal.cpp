@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <glog/logging.h>
+#include "common/frame.h"
+#include "serial/serial.h"
+#include "gimbal-simulator/gimbal-simulator.h"
+#include "latency-compensator/latency-compensator.h"
+#include "benchmark-gimbal.h"
+
+benchmark::Registry<benchmark::gimbal::GimbalBenchmark> benchmark::gimbal::GimbalBenchmark::registry_("gimbal");
+
+namespace {
+constexpr auto kSampleInterval = std::chrono::milliseconds(1);  ///< 两帧之间采样真实姿态的间隔
+
+/**
+ * @brief 计算云台姿态相对目标的偏差
+ * @param [in] attitude 云台姿态欧拉角
+ * @param [in] target 目标姿态欧拉角
+ * @return yaw、pitch 偏差的合成角度，单位：rad
+ */
+double AimError(coordinate::EAngle REF_IN attitude, coordinate::EAngle REF_IN target) {
+  return std::hypot(std::remainder(attitude[1] - target[1], 2 * M_PI), attitude[2] - target[2]);
+}
+}
+
+bool benchmark::gimbal::GimbalBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open gimbal benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  baseline_["FRAME_RATE"] >> frame_rate_;
+  baseline_["PROCESSING_TIME"] >> processing_time_;
+  baseline_["STEPS"] >> steps_;
+  baseline_["STEP_ANGLE"] >> step_angle_;
+  baseline_["STEP_INTERVAL"] >> step_interval_;
+  baseline_["SETTLE_TOLERANCE"] >> settle_tolerance_;
+  baseline_["TRACK_AMPLITUDE"] >> track_amplitude_;
+  baseline_["TRACK_FREQUENCY"] >> track_frequency_;
+  baseline_["TRACK_DURATION"] >> track_duration_;
+  baseline_["GIMBAL_CONFIG"] >> gimbal_config_;
+  baseline_["LATENCY_CONFIG"] >> latency_config_;
+  if (frame_rate_ <= 0 || processing_time_ < 0 || processing_time_ * frame_rate_ >= 1 || steps_ <= 0
+      || step_angle_ <= 0 || step_interval_ <= 0 || settle_tolerance_ <= 0 || track_amplitude_ <= 0
+      || track_frequency_ <= 0 || track_duration_ * track_frequency_ < 2) {
+    LOG(ERROR) << "Invalid frame rate, processing time, step or tracking settings in gimbal benchmark baseline. "
+               << "Processing must fit in a frame and tracking must last at least 2 periods.";
+    baseline_.release();
+    return false;
+  }
+  if (gimbal_config_.empty() || latency_config_.empty()) {
+    LOG(ERROR) << "Gimbal or latency configuration not found in gimbal benchmark baseline.";
+    baseline_.release();
+    return false;
+  }
+  platform_baseline_ = PlatformBaseline(baseline_, "gimbal");
+#if !NDEBUG
+  LOG(WARNING) << "Latency compensation gain is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized gimbal benchmark at " << frame_rate_ << " fps with " << processing_time_ * 1e3
+            << " ms processing load.";
+  return true;
+}
+
+int benchmark::gimbal::GimbalBenchmark::Run() {
+  gimbal_simulator::GimbalSimulator simulator;
+  if (!simulator.Initialize(gimbal_config_) || !simulator.Start()) {
+    LOG(ERROR) << "Failed to start gimbal simulator.";
+    return 1;
+  }
+  ::serial::Serial serial;
+  if (!serial.Open(simulator.Port())) {
+    LOG(ERROR) << "Failed to open gimbal simulator as serial port.";
+    return 1;
+  }
+
+  // 运行一次闭环视觉循环：target 将时间（s）映射为目标姿态，compensate 为 true 时按指令延迟外推目标，
+  // 每次采样真实姿态时以时间与偏差调用 on_sample
+  auto run_loop = [&](std::function<coordinate::EAngle(double)> REF_IN target, double duration, bool compensate,
+                      std::function<void(double, double)> REF_IN on_sample) -> bool {
+    latency_compensator::LatencyCompensator compensator;
+    if (!compensator.Initialize(latency_config_)) return false;
+    const auto frame_period = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / frame_rate_));
+    const auto processing_period = std::chrono::nanoseconds(static_cast<int64_t>(processing_time_ * 1e9));
+    const auto start_time = std::chrono::steady_clock::now();
+    auto seconds = [&]() {
+      return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_time).count()) * 1e-9;
+    };
+    auto next_frame_time = start_time;
+    for (double time = 0; time < duration; time = seconds()) {
+      if (std::chrono::steady_clock::now() >= next_frame_time) {
+        next_frame_time += frame_period;
+        auto receive_time = Frame::HostTime();
+        ReceivePacket packet{};
+        if (serial.ReadData(packet))
+          compensator.UpdateAttitude({packet.roll, packet.yaw, packet.pitch}, receive_time);
+        // 忙等待模拟识别负载，与真实主循环一样占用 CPU
+        auto processing_end_time = std::chrono::steady_clock::now() + processing_period;
+        while (std::chrono::steady_clock::now() < processing_end_time);
+        auto aim = target(time + (compensate ? compensator.CommandDelay() : 0));
+        SendPacket command{};
+        command.yaw = static_cast<float>(aim[1]);
+        command.pitch = static_cast<float>(aim[2]);
+        serial.WriteData(command);
+        compensator.RecordLatency(receive_time, Frame::HostTime());
+      } else
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+            kSampleInterval, next_frame_time - std::chrono::steady_clock::now()));
+      auto sample_time = seconds();
+      on_sample(sample_time, AimError(simulator.Attitude(), target(sample_time)));
+    }
+    return true;
+  };
+
+  auto baseline = platform_baseline_;
+  size_t regressions = 0;
+
+  // 阶跃：目标在 step_angle 与 0 之间来回跳变，稳定时间为每次跳变后最后一次超出容差的时刻
+  std::vector<double> settling_times(steps_, 0);
+  std::vector<bool> settled(steps_, true);
+  auto step_target = [&](double time) -> coordinate::EAngle {
+    auto step = static_cast<int>(time / step_interval_);
+    return {0, step % 2 ? 0 : step_angle_, 0};
+  };
+  auto on_step_sample = [&](double time, double error) {
+    auto step = static_cast<int>(time / step_interval_);
+    if (step >= steps_) return;
+    settled[step] = error <= settle_tolerance_;
+    if (!settled[step]) settling_times[step] = time - step * step_interval_;
+  };
+  if (!run_loop(step_target, steps_ * step_interval_, false, on_step_sample)) {
+    LOG(ERROR) << "Failed to initialize latency compensator.";
+    return 1;
+  }
+  auto unsettled = std::count(settled.begin(), settled.end(), false);
+  double mean_settling_ms = 0, max_settling_ms = 0;
+  for (auto settling_time : settling_times) {
+    mean_settling_ms += settling_time * 1e3 / steps_;
+    max_settling_ms = std::max(max_settling_ms, settling_time * 1e3);
+  }
+  LOG(INFO) << std::fixed << std::setprecision(1) << "Step: settling " << mean_settling_ms << " ms on average, "
+            << max_settling_ms << " ms at most, " << unsettled << " / " << steps_ << " steps unsettled.";
+  if (unsettled) {
+    LOG(ERROR) << unsettled << " steps did not settle within " << step_interval_ << " s.";
+    ++regressions;
+  }
+  if (!baseline["STEP"].empty()) {
+    double baseline_max_settling = 0;
+    baseline["STEP"]["MAX_SETTLING_MS"] >> baseline_max_settling;
+    if (mean_settling_ms > baseline_max_settling) {
+      LOG(ERROR) << "Settling time regressed: " << mean_settling_ms << " ms exceeds baseline "
+                 << baseline_max_settling << " ms.";
+      ++regressions;
+    }
+  }
+
+  // 跟踪：跳过第一个周期的收敛过程，统计稳态均方根误差
+  auto track_target = [&](double time) -> coordinate::EAngle {
+    return {0, track_amplitude_ * std::sin(2 * M_PI * track_frequency_ * time), 0};
+  };
+  double rms_errors[2]{};
+  for (auto compensate : {false, true}) {
+    double squared_error = 0, max_error = 0;
+    size_t samples = 0;
+    auto on_track_sample = [&](double time, double error) {
+      if (time < 1 / track_frequency_) return;
+      squared_error += error * error;
+      max_error = std::max(max_error, error);
+      ++samples;
+    };
+    if (!run_loop(track_target, track_duration_, compensate, on_track_sample)) {
+      LOG(ERROR) << "Failed to initialize latency compensator.";
+      return 1;
+    }
+    rms_errors[compensate] = std::sqrt(squared_error / static_cast<double>(std::max<size_t>(samples, 1)));
+    LOG(INFO) << std::fixed << std::setprecision(2) << "Track " << (compensate ? "compensated" : "raw")
+              << ": RMS error " << rms_errors[compensate] * 1e3 << " mrad, max " << max_error * 1e3 << " mrad.";
+  }
+  if (!baseline["TRACK"].empty()) {
+    double baseline_max_rms_error = 0, baseline_min_reduction = 0;
+    baseline["TRACK"]["MAX_RMS_ERROR_MRAD"] >> baseline_max_rms_error;
+    baseline["TRACK"]["MIN_ERROR_REDUCTION"] >> baseline_min_reduction;
+    if (rms_errors[1] * 1e3 > baseline_max_rms_error) {
+      LOG(ERROR) << "Tracking error regressed: " << rms_errors[1] * 1e3 << " mrad exceeds baseline "
+                 << baseline_max_rms_error << " mrad.";
+      ++regressions;
+    }
+#if NDEBUG
+    // 两次运行的误差都受调度抖动影响，只在补偿的收益明显低于基准值时判定退化
+    auto reduction = 1 - rms_errors[1] / rms_errors[0];
+    if (reduction < baseline_min_reduction) {
+      LOG(ERROR) << "Latency compensation regressed: tracking error reduced by " << reduction * 1e2
+                 << "%, below baseline " << baseline_min_reduction * 1e2 << "%.";
+      ++regressions;
+    }
+#endif
+  }
+
+  serial.Close();
+  simulator.Stop();
+  if (regressions) {
+    LOG(ERROR) << regressions << " gimbal case(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All gimbal cases passed baseline on " << Platform() << ".";
+  return 0;
+}
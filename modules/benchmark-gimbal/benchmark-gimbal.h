@@ -0,0 +1,40 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_GIMBAL_BENCHMARK_GIMBAL_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_GIMBAL_BENCHMARK_GIMBAL_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::gimbal {
+/**
+ * @brief 闭环瞄准基准测试类，以云台下位机模拟器代替机器人，测量从指令到云台到位的稳定时间与跟踪误差
+ * @details 视觉循环以固定帧率运行：读取串口姿态，忙等待模拟识别负载，按合成目标计算指令并异步发送；
+ *   两帧之间每毫秒采样一次模拟器的真实姿态与目标的偏差；阶跃测试中目标在两个角度间来回跳变，
+ *   跟踪测试中目标做正弦运动，分别在不补偿与按 LatencyCompensator 的指令延迟外推目标时各运行一次；
+ *   平均稳定时间、补偿后的均方根误差高于基准值，或补偿减小误差的比例低于基准值（仅 Release 构建检查）时，测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("gimbal") @endcode 获取该类的公共接口指针
+ */
+class GimbalBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<GimbalBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  double frame_rate_{};             ///< 视觉循环帧率，单位：Hz
+  double processing_time_{};        ///< 每帧模拟的识别耗时，单位：s
+  int steps_{};                     ///< 阶跃次数
+  double step_angle_{};             ///< 阶跃幅度，单位：rad
+  double step_interval_{};          ///< 相邻阶跃的间隔，单位：s
+  double settle_tolerance_{};       ///< 视为到位的最大偏差，单位：rad
+  double track_amplitude_{};        ///< 正弦运动的幅度，单位：rad
+  double track_frequency_{};        ///< 正弦运动的频率，单位：Hz
+  double track_duration_{};         ///< 每次跟踪测试的时长，单位：s
+  std::string gimbal_config_;       ///< 云台模拟器配置文件路径
+  std::string latency_config_;      ///< 延迟补偿器配置文件路径
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_GIMBAL_BENCHMARK_GIMBAL_H_
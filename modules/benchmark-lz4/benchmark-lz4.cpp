@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <glog/logging.h>
+#include <opencv2/imgproc.hpp>
+#include "raw-recording/lz4.h"
+#include "benchmark-lz4.h"
+
+benchmark::Registry<benchmark::lz4::LZ4Benchmark> benchmark::lz4::LZ4Benchmark::registry_("lz4");
+
+namespace {
+constexpr int kLightBars = 40;           ///< 合成画面中的灯条数量
+constexpr double kBlackLevel = 8;        ///< 合成画面的背景亮度
+constexpr double kNoiseSigma = 2;        ///< 读出噪声标准差
+constexpr size_t kMaxShortSize = 600;    ///< 长度边界测试的最大字节数，超过两个长度扩展字节
+constexpr size_t kMaxRunLength = 300;    ///< 随机帧中重复段与字面量的最大长度
+constexpr size_t kMaxRunOffset = 70000;  ///< 随机帧中重复段的最大距离，超过 LZ4 的最大匹配距离
+constexpr size_t kTruncations = 64;      ///< 均匀分布的截断长度数量
+constexpr size_t kTailTruncations = 64;  ///< 逐字节截断的末尾字节数
+constexpr size_t kGuardSize = 64;        ///< 解压缓冲区末尾的哨兵字节数
+constexpr uint8_t kGuardByte = 0xA5;     ///< 哨兵字节的值
+
+/**
+ * @brief 生成短曝光下的合成比赛画面
+ * @details 暗背景叠加读出噪声（负值截断为 0），随机散布红蓝灯条，与实际录制的原始帧一样以接近黑色的像素为主
+ * @param size 图像尺寸
+ * @return BGR 图像
+ */
+cv::Mat SyntheticScene(cv::Size size) {
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<float> x_distribution(0, static_cast<float>(size.width)),
+      y_distribution(0, static_cast<float>(size.height)), length_distribution(24, 96), tilt_distribution(-20, 20);
+  cv::Mat image(size, CV_8UC3, cv::Scalar::all(kBlackLevel)), noise(size, CV_8UC3);
+  for (auto k = 0; k < kLightBars; ++k) {
+    float length = length_distribution(random_engine);
+    cv::Point2f center(x_distribution(random_engine), y_distribution(random_engine)), vertexes[4];
+    cv::RotatedRect(center, cv::Size2f(length / 5, length), tilt_distribution(random_engine)).points(vertexes);
+    std::vector<cv::Point> polygon;
+    for (auto &&p : vertexes) polygon.emplace_back(cvRound(p.x), cvRound(p.y));
+    cv::fillConvexPoly(image, polygon, k % 2 ? cv::Scalar(250, 180, 60) : cv::Scalar(60, 80, 250));
+  }
+  cv::randn(noise, cv::Scalar::all(0), cv::Scalar::all(kNoiseSigma));
+  image += noise;
+  return image;
+}
+
+/**
+ * @brief 生成重复段与字面量交替的随机数据
+ * @details 每段随机选择随机字面量、单字节重复或复制之前的数据，覆盖长度扩展字节、重叠匹配与超出最大匹配距离的重复
+ * @param size 字节数
+ * @param [in,out] random_engine 随机数引擎
+ * @return 随机数据
+ */
+std::vector<uint8_t> RandomRuns(size_t size, std::mt19937 REF_OUT random_engine) {
+  std::uniform_int_distribution<size_t> kind_distribution(0, 2), length_distribution(1, kMaxRunLength);
+  std::uniform_int_distribution<int> byte_distribution(0, 255);
+  std::vector<uint8_t> data;
+  data.reserve(size + kMaxRunLength);
+  while (data.size() < size) {
+    auto kind = kind_distribution(random_engine), length = length_distribution(random_engine);
+    if (kind == 0 || data.empty())
+      for (size_t i = 0; i < length; ++i) data.push_back(static_cast<uint8_t>(byte_distribution(random_engine)));
+    else if (kind == 1)
+      data.insert(data.end(), length, static_cast<uint8_t>(byte_distribution(random_engine)));
+    else {
+      auto offset = std::uniform_int_distribution<size_t>(1, std::min(data.size(), kMaxRunOffset))(random_engine);
+      // 距离小于长度时与正在写入的部分重叠，逐字节复制
+      for (size_t i = 0; i < length; ++i) data.push_back(data[data.size() - offset]);
+    }
+  }
+  data.resize(size);
+  return data;
+}
+
+/**
+ * @brief 解压到末尾带哨兵字节的缓冲区
+ * @param [in] src 压缩数据
+ * @param raw_size 原始数据字节数
+ * @param [out] output 解压缓冲区，末尾附加 kGuardSize 个哨兵字节
+ * @param [out] overflow 是否改写了哨兵字节
+ * @return 是否解压成功
+ */
+bool GuardedDecompress(std::vector<uint8_t> REF_IN src, size_t raw_size,
+                       std::vector<uint8_t> REF_OUT output, bool REF_OUT overflow) {
+  output.assign(raw_size + kGuardSize, kGuardByte);
+  bool decompressed = raw_recording::lz4::Decompress(src.data(), src.size(), output.data(), raw_size);
+  overflow = std::any_of(output.begin() + static_cast<std::ptrdiff_t>(raw_size), output.end(),
+                         [](uint8_t byte) { return byte != kGuardByte; });
+  return decompressed;
+}
+
+/**
+ * @brief 压缩数据
+ * @param [in] data 原始数据
+ * @return 压缩结果，缓冲区按最坏情况分配，压缩失败时为空
+ */
+std::vector<uint8_t> Compress(std::vector<uint8_t> REF_IN data) {
+  std::vector<uint8_t> compressed(raw_recording::lz4::CompressBound(data.size()));
+  compressed.resize(raw_recording::lz4::Compress(data.data(), data.size(), compressed.data(), compressed.size()));
+  return compressed;
+}
+
+/**
+ * @brief 检查压缩再解压的结果与原始数据逐字节一致，且解压未写出缓冲区
+ * @param [in] data 原始数据
+ * @param [in] compressed 压缩结果
+ * @return 是否一致
+ */
+bool RoundTrip(std::vector<uint8_t> REF_IN data, std::vector<uint8_t> REF_IN compressed) {
+  std::vector<uint8_t> output;
+  bool overflow;
+  return !compressed.empty() && GuardedDecompress(compressed, data.size(), output, overflow) && !overflow
+      && std::equal(data.begin(), data.end(), output.begin());
+}
+}
+
+bool benchmark::lz4::LZ4Benchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open lz4 benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int repeats = 0;
+  baseline_["WIDTH"] >> size_.width;
+  baseline_["HEIGHT"] >> size_.height;
+  baseline_["REPEATS"] >> repeats;
+  baseline_["CORRUPTIONS"] >> corruptions_;
+  if (size_.width < 4 || size_.height < 4 || size_.width % 2 || size_.height % 2 || repeats <= 0
+      || corruptions_ < 0) {
+    LOG(ERROR) << "Invalid image size, repeat count or corruption count in lz4 benchmark baseline. "
+               << "Image width and height must be even numbers no less than 4.";
+    baseline_.release();
+    return false;
+  }
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "lz4");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized lz4 benchmark with " << size_.width << "x" << size_.height << " frames, "
+            << repeats_ << " repeats and " << corruptions_ << " corruptions.";
+  return true;
+}
+
+int benchmark::lz4::LZ4Benchmark::Run() {
+  auto bayer = Mosaic(SyntheticScene(size_));
+  auto frame_size = static_cast<size_t>(size_.area());
+  std::mt19937 random_engine(0);
+  std::uniform_int_distribution<int> byte_distribution(0, 255);
+  std::vector<uint8_t> incompressible(frame_size);
+  for (auto &&byte : incompressible) byte = static_cast<uint8_t>(byte_distribution(random_engine));
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> cases{
+      {"bayer", std::vector<uint8_t>(bayer.datastart, bayer.dataend)},
+      {"random", RandomRuns(frame_size, random_engine)},
+      {"incompressible", std::move(incompressible)}};
+
+  LOG(INFO) << std::left << std::setw(16) << "FRAME" << std::right << std::setw(8) << "RATIO"
+            << std::setw(16) << "COMPRESS(MB/s)" << std::setw(18) << "DECOMPRESS(MB/s)" << std::setw(10) << "EXACT";
+  size_t regressions = 0;
+  for (auto &&[name, data] : cases) {
+    std::vector<uint8_t> compressed(raw_recording::lz4::CompressBound(frame_size)), output(frame_size);
+    size_t compressed_size = 0;
+    double compress_time = MeasureTime([&]() {
+      compressed_size = raw_recording::lz4::Compress(data.data(), frame_size, compressed.data(), compressed.size());
+    }, repeats_);
+    compressed.resize(compressed_size);
+    double decompress_time = MeasureTime([&]() {
+      raw_recording::lz4::Decompress(compressed.data(), compressed_size, output.data(), frame_size);
+    }, repeats_);
+    bool exact = RoundTrip(data, compressed);
+    double ratio = compressed_size ? static_cast<double>(frame_size) / static_cast<double>(compressed_size) : 0;
+    // 字节数除以纳秒数为 GB/s
+    double compress_speed = static_cast<double>(frame_size) / compress_time * 1e3;
+    double decompress_speed = static_cast<double>(frame_size) / decompress_time * 1e3;
+    LOG(INFO) << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << ratio << std::setprecision(0) << std::setw(16) << compress_speed
+              << std::setw(18) << decompress_speed << std::setw(10) << (exact ? "yes" : "no");
+    if (!exact) {
+      LOG(ERROR) << name << " frame does not survive a compression round trip.";
+      ++regressions;
+    }
+    auto baseline = platform_baseline_[name];
+    if (baseline.empty()) continue;
+    double baseline_min_ratio = 0, baseline_min_compress = 0, baseline_min_decompress = 0;
+    baseline["MIN_RATIO"] >> baseline_min_ratio;
+    baseline["MIN_COMPRESS_MBPS"] >> baseline_min_compress;
+    baseline["MIN_DECOMPRESS_MBPS"] >> baseline_min_decompress;
+    if (ratio < baseline_min_ratio) {
+      LOG(ERROR) << name << " compression ratio regressed: " << ratio
+                 << " is below baseline " << baseline_min_ratio << ".";
+      ++regressions;
+    }
+#if NDEBUG
+    if (compress_speed < baseline_min_compress || decompress_speed < baseline_min_decompress) {
+      LOG(ERROR) << name << " speed regressed: " << compress_speed << " / " << decompress_speed
+                 << " MB/s is below baseline " << baseline_min_compress << " / " << baseline_min_decompress
+                 << " MB/s.";
+      ++regressions;
+    }
+#endif
+  }
+
+  // 长度边界：块末尾至少 5 字节字面量，长度字段在 15 与 15 + 255 处增加扩展字节
+  size_t short_failures = 0;
+  for (size_t size = 0; size <= kMaxShortSize; ++size) {
+    auto data = RandomRuns(size, random_engine);
+    if (!RoundTrip(data, Compress(data))) ++short_failures;
+  }
+  if (short_failures) {
+    LOG(ERROR) << short_failures << " of " << kMaxShortSize + 1 << " short inputs do not survive a round trip.";
+    ++regressions;
+  }
+
+  // 截断与长度不符的输入必须被拒绝，截断到每个长度需要平方级时间，只取均匀分布的长度与末尾逐字节的长度
+  auto &&bayer_data = cases.front().second;
+  auto bayer_compressed = Compress(bayer_data);
+  std::vector<size_t> truncations;
+  for (size_t k = 0; k < kTruncations; ++k) truncations.push_back(bayer_compressed.size() * k / kTruncations);
+  for (size_t k = 1; k <= std::min(kTailTruncations, bayer_compressed.size()); ++k)
+    truncations.push_back(bayer_compressed.size() - k);
+  size_t accepted = 0, overflows = 0;
+  std::vector<uint8_t> output;
+  bool overflow;
+  for (auto length : truncations) {
+    auto end = bayer_compressed.begin() + static_cast<std::ptrdiff_t>(length);
+    std::vector<uint8_t> truncated(bayer_compressed.begin(), end);
+    accepted += GuardedDecompress(truncated, frame_size, output, overflow);
+    overflows += overflow;
+  }
+  for (auto raw_size : {frame_size - 1, frame_size + 1}) {
+    accepted += GuardedDecompress(bayer_compressed, raw_size, output, overflow);
+    overflows += overflow;
+  }
+  if (accepted) {
+    LOG(ERROR) << accepted << " truncated or mismatched inputs were accepted by decompression.";
+    ++regressions;
+  }
+
+  // 随机改写字节后数据可能仍然合法，只要求不写出输出缓冲区；越界读取须以 AddressSanitizer 构建检查
+  size_t corrupted_accepted = 0;
+  std::uniform_int_distribution<size_t> position_distribution(0, bayer_compressed.size() - 1), count_distribution(1, 4);
+  for (auto k = 0; k < corruptions_; ++k) {
+    auto corrupted = bayer_compressed;
+    for (auto n = count_distribution(random_engine); n; --n)
+      corrupted[position_distribution(random_engine)] = static_cast<uint8_t>(byte_distribution(random_engine));
+    corrupted_accepted += GuardedDecompress(corrupted, frame_size, output, overflow);
+    overflows += overflow;
+  }
+  LOG(INFO) << truncations.size() + 2 << " truncated or mismatched inputs rejected, " << corrupted_accepted
+            << " of " << corruptions_ << " corrupted inputs still decoded, " << overflows << " output overflows.";
+  if (overflows) {
+    LOG(ERROR) << overflows << " malformed inputs wrote past the decompression buffer.";
+    ++regressions;
+  }
+  if (regressions) {
+    LOG(ERROR) << regressions << " lz4 check(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All lz4 checks passed baseline on " << Platform() << ".";
+  return 0;
+}
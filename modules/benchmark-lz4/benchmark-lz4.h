@@ -0,0 +1,32 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_LZ4_BENCHMARK_LZ4_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_LZ4_BENCHMARK_LZ4_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::lz4 {
+/**
+ * @brief 原始录像 LZ4 编解码基准测试类，检查 raw_recording::lz4 的往返一致性、对异常输入的防护与压缩解压速度
+ * @details 对合成 BayerRG8 帧、随机长度重复段与字面量交替的随机帧、均匀随机的不可压缩帧分别压缩再解压，并逐字节比对，
+ *   另对 0 到数百字节的各种长度做往返，覆盖长度扩展字节与块末尾字面量的边界；随后把压缩后的 Bayer 帧截断、改错长度或随机改写字节后解压，
+ *   截断与长度不符必须返回失败，改写后的数据无论成败都不得写出输出缓冲区；
+ *   任一往返不一致、防护失效，或压缩比、压缩解压速度低于基准值（速度仅 Release 构建检查）时，测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("lz4") @endcode 获取该类的公共接口指针
+ */
+class LZ4Benchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<LZ4Benchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  cv::Size size_;                   ///< 合成图像尺寸
+  size_t repeats_{};                ///< 计时重复次数
+  int corruptions_{};               ///< 随机改写压缩数据的次数
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_LZ4_BENCHMARK_LZ4_H_
@@ -0,0 +1,146 @@
+#include <iomanip>
+#include <random>
+#include <glog/logging.h>
+#include "outpost-predictor/outpost-predictor.h"
+#include "benchmark-outpost.h"
+
+benchmark::Registry<benchmark::outpost::OutpostBenchmark>
+    benchmark::outpost::OutpostBenchmark::registry_("outpost");
+
+namespace {
+const coordinate::CTVec kOutpostAxis(0.8, -1.2, 6.0);  ///< 前哨站旋转中心的世界坐标
+constexpr double kInitialYaw = 0.3;                    ///< 0 号装甲板的初始朝向，单位：rad
+}
+
+bool benchmark::outpost::OutpostBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open outpost benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int repeats = 0;
+  baseline_["REPEATS"] >> repeats;
+  baseline_["FRAMES"] >> frames_;
+  baseline_["FRAME_RATE"] >> frame_rate_;
+  baseline_["SPEED"] >> speed_;
+  baseline_["YAW_NOISE"] >> yaw_noise_;
+  baseline_["POSITION_NOISE"] >> position_noise_;
+  baseline_["DROP_RATE"] >> drop_rate_;
+  baseline_["FLIGHT_TIME"] >> flight_time_;
+  baseline_["OUTPOST_CONFIG"] >> outpost_config_;
+  if (repeats <= 0 || frames_ < 10 || frame_rate_ <= 0 || speed_ <= 0 || yaw_noise_ < 0 || position_noise_ < 0
+      || drop_rate_ < 0 || drop_rate_ >= 1 || flight_time_ < 0) {
+    LOG(ERROR) << "Invalid repeat count, frame count, speed, noise, drop rate or flight time "
+               << "in outpost benchmark baseline. At least 10 frames are required.";
+    baseline_.release();
+    return false;
+  }
+  if (outpost_config_.empty()) {
+    LOG(ERROR) << "Outpost configuration not found in outpost benchmark baseline.";
+    baseline_.release();
+    return false;
+  }
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "outpost");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized outpost benchmark with " << frames_ << " frames and " << repeats_ << " repeats.";
+  return true;
+}
+
+int benchmark::outpost::OutpostBenchmark::Run() {
+  ::outpost_predictor::Param param;
+  if (!param.Initialize(outpost_config_)) {
+    LOG(ERROR) << "Failed to read outpost configurations.";
+    return 1;
+  }
+  double step = 2 * M_PI / param.plates, line_of_sight = std::atan2(kOutpostAxis.x(), kOutpostAxis.z());
+  auto frame_time_ns = static_cast<uint64_t>(1e9 / frame_rate_);
+  LOG(INFO) << std::left << std::setw(8) << "CASE" << std::right << std::setw(12) << "UPDATE(us)"
+            << std::setw(14) << "SPEED ERROR" << std::setw(14) << "FACING(ms)";
+  size_t regressions = 0;
+  for (std::string direction : {"CW", "CCW"}) {
+    double speed = direction == "CW" ? speed_ : -speed_;
+    // 真实朝向在命中时刻相对视线的偏角，取最近的装甲板
+    auto true_angle = [&](uint64_t time_stamp) {
+      return std::remainder(kInitialYaw + speed * static_cast<double>(time_stamp) * 1e-9 - line_of_sight, step);
+    };
+    ::outpost_predictor::OutpostPredictor predictor;
+    if (!predictor.Initialize(outpost_config_)) {
+      LOG(ERROR) << "Failed to initialize outpost predictor.";
+      return 1;
+    }
+    // 每个方向使用相同的随机种子，保证观测噪声一致
+    std::mt19937 random_engine(0);
+    std::normal_distribution<double> noise_distribution(0, 1);
+    std::uniform_real_distribution<double> drop_distribution(0, 1);
+    auto observe = [&](int frame_index) {
+      auto time_stamp = frame_index * frame_time_ns;
+      // 偏离视线超过半个装甲板间隔的装甲板被遮挡，观测的总是最接近正对的装甲板
+      double yaw = line_of_sight + true_angle(time_stamp);
+      if (drop_distribution(random_engine) < drop_rate_) return;
+      coordinate::CTVec ctv_plate = kOutpostAxis - param.radius * coordinate::CTVec(std::sin(yaw), 0, std::cos(yaw));
+      for (auto k = 0; k < 3; ++k) ctv_plate[k] += position_noise_ * noise_distribution(random_engine);
+      predictor.Update(ctv_plate, yaw + yaw_noise_ * noise_distribution(random_engine), time_stamp);
+    };
+
+    // 跳过收敛阶段，只统计稳态误差
+    int warm_up_frames = frames_ / 10;
+    size_t predictions = 0;
+    double max_speed_error = 0, facing_squared_error = 0;
+    for (auto frame_index = 0; frame_index < frames_; ++frame_index) {
+      observe(frame_index);
+      ::outpost_predictor::FireWindow fire_window;
+      if (frame_index < warm_up_frames || !predictor.Predict(frame_index * frame_time_ns, flight_time_, fire_window))
+        continue;
+      max_speed_error = std::max(max_speed_error, std::abs(predictor.Speed() - speed));
+      double facing_error = true_angle(fire_window.facing_time) / speed;
+      facing_squared_error += facing_error * facing_error;
+      ++predictions;
+    }
+    if (!predictions) {
+      LOG(ERROR) << direction << " outpost predictor never converged.";
+      ++regressions;
+      continue;
+    }
+    double facing_error_ms = std::sqrt(facing_squared_error / static_cast<double>(predictions)) * 1e3;
+
+    // 计时时继续沿时间轴推进，每帧更新一次并预测开火窗口
+    int frame_index = frames_;
+    double frame_time = MeasureTime([&]() {
+      observe(frame_index);
+      ::outpost_predictor::FireWindow fire_window;
+      predictor.Predict(frame_index * frame_time_ns, flight_time_, fire_window);
+      ++frame_index;
+    }, repeats_);
+    LOG(INFO) << std::left << std::setw(8) << direction << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << frame_time * 1e-3 << std::setw(14) << max_speed_error
+              << std::setw(14) << facing_error_ms;
+    auto baseline = platform_baseline_[direction];
+    if (baseline.empty()) continue;
+    double baseline_max_speed_error = 0, baseline_max_facing_error = 0, baseline_max_time = 0;
+    baseline["MAX_SPEED_ERROR"] >> baseline_max_speed_error;
+    baseline["MAX_FACING_ERROR_MS"] >> baseline_max_facing_error;
+    baseline["MAX_TIME_US"] >> baseline_max_time;
+    if (max_speed_error > baseline_max_speed_error || facing_error_ms > baseline_max_facing_error) {
+      LOG(ERROR) << direction << " accuracy regressed: speed error " << max_speed_error << " rad/s and facing error "
+                 << facing_error_ms << " ms exceed baseline " << baseline_max_speed_error << " rad/s and "
+                 << baseline_max_facing_error << " ms.";
+      ++regressions;
+    }
+#if NDEBUG
+    if (frame_time * 1e-3 > baseline_max_time) {
+      LOG(ERROR) << direction << " speed regressed: " << frame_time * 1e-3 << " us exceeds baseline "
+                 << baseline_max_time << " us.";
+      ++regressions;
+    }
+#endif
+  }
+  if (regressions) {
+    LOG(ERROR) << regressions << " outpost case(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All outpost cases passed baseline on " << Platform() << ".";
+  return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_OUTPOST_BENCHMARK_OUTPOST_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_OUTPOST_BENCHMARK_OUTPOST_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::outpost {
+/**
+ * @brief 前哨站预测器基准测试类，测量单帧更新与开火窗口预测的耗时、转速与正对时刻的误差
+ * @details 前哨站以固定转速分别顺时针、逆时针旋转，每帧观测最接近正对射手的装甲板，朝向与位置加入高斯噪声并随机丢帧；
+ *   转速误差、正对时刻均方根误差高于基准值，或单帧耗时超过基准值（仅 Release 构建检查）时，测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("outpost") @endcode 获取该类的公共接口指针
+ */
+class OutpostBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<OutpostBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  size_t repeats_{};                ///< 计时重复次数
+  int frames_{};                    ///< 每个旋转方向的观测帧数
+  double frame_rate_{};             ///< 观测帧率，单位：Hz
+  double speed_{};                  ///< 前哨站转速，单位：rad/s
+  double yaw_noise_{};              ///< 装甲板朝向观测的标准差，单位：rad
+  double position_noise_{};         ///< 装甲板位置观测的标准差，单位：m
+  double drop_rate_{};              ///< 丢帧概率
+  double flight_time_{};            ///< 预测开火窗口所用的弹丸飞行时间，单位：s
+  std::string outpost_config_;      ///< 前哨站预测器配置文件路径
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_OUTPOST_BENCHMARK_OUTPOST_H_
@@ -0,0 +1,277 @@
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#include <glog/logging.h>
+#include "serial/serial.h"
+#include "benchmark-serial.h"
+
+benchmark::Registry<benchmark::serial::SerialBenchmark> benchmark::serial::SerialBenchmark::registry_("serial");
+
+namespace {
+constexpr int kPollInterval = 10;  ///< 模拟下位机检查停止信号的间隔，单位：ms
+
+/**
+ * @brief 向伪终端主端阻塞写入全部字节
+ * @param fd 伪终端主端文件描述符
+ * @param [in] data 数据首地址
+ * @param size 数据字节数
+ * @return 是否写入成功
+ */
+bool WriteAll(int fd, const uint8_t *data, size_t size) {
+  while (size) {
+    ssize_t write_count = write(fd, data, size);
+    if (write_count <= 0) return false;
+    data += write_count;
+    size -= write_count;
+  }
+  return true;
+}
+
+/**
+ * @brief 计算已排序样本的分位数
+ * @param [in] sorted 升序排列的样本
+ * @param percent 百分位，取值 [0, 100]
+ * @return 分位数，无样本时为 0
+ */
+double Percentile(std::vector<double> REF_IN sorted, double percent) {
+  if (sorted.empty()) return 0;
+  return sorted[static_cast<size_t>(percent / 100 * static_cast<double>(sorted.size() - 1) + 0.5)];
+}
+
+/// 计算两个时间点之间的秒数
+double Seconds(std::chrono::steady_clock::time_point start_time, std::chrono::steady_clock::time_point end_time) {
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count()) * 1e-9;
+}
+}
+
+bool benchmark::serial::SerialBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open serial benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  baseline_["ROUND_TRIPS"] >> round_trips_;
+  baseline_["PACKETS"] >> packets_;
+  baseline_["LOSS_RATE"] >> loss_rate_;
+  if (round_trips_ <= 0 || packets_ <= 0 || loss_rate_ < 0 || loss_rate_ >= 1) {
+    LOG(ERROR) << "Invalid round trip count, packet count or loss rate in serial benchmark baseline.";
+    baseline_.release();
+    return false;
+  }
+  platform_baseline_ = PlatformBaseline(baseline_, "serial");
+#if !NDEBUG
+  LOG(WARNING) << "Latency and throughput baselines are only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized serial benchmark with " << round_trips_ << " round trips and " << packets_ << " packets.";
+  return true;
+}
+
+int benchmark::serial::SerialBenchmark::Run() {
+  int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master_fd == -1 || grantpt(master_fd) == -1 || unlockpt(master_fd) == -1) {
+    LOG(ERROR) << "Failed to create pseudo terminal pair.";
+    if (master_fd != -1) close(master_fd);
+    return 1;
+  }
+  ::serial::Serial serial;
+  if (!serial.Open(ptsname(master_fd))) {
+    LOG(ERROR) << "Failed to open pseudo terminal as serial port.";
+    close(master_fd);
+    return 1;
+  }
+  auto baseline = platform_baseline_;
+  size_t regressions = 0;
+
+  // 往返：模拟下位机把每条指令的 yaw 写回，测量从写入指令到读出回复的时间
+  std::atomic_bool stop_flag{};
+  std::thread echo_thread([&]() {
+    ::serial::FrameParser parser;
+    std::array<uint8_t, ::serial::kMaxFrameSize> frame{};
+    auto on_frame = [&](::serial::PacketType type, const uint8_t *payload, size_t size) {
+      if (type != ::serial::PacketType::SEND || size != sizeof(SendPacket)) return;
+      SendPacket command;
+      memcpy(&command, payload, size);
+      ReceivePacket echo{};
+      echo.yaw = command.yaw;
+      WriteAll(master_fd, frame.data(),
+               ::serial::Pack(::serial::PacketType::RECEIVE, &echo, sizeof(ReceivePacket), frame.data()));
+    };
+    while (!stop_flag) {
+      pollfd poll_fd{master_fd, POLLIN, 0};
+      if (poll(&poll_fd, 1, kPollInterval) <= 0) continue;
+      ssize_t read_count = read(master_fd, parser.WriteBuffer(), parser.WriteCapacity());
+      if (read_count > 0) parser.Commit(read_count, on_frame);
+    }
+  });
+  std::vector<double> round_trip_times;
+  round_trip_times.reserve(round_trips_);
+  size_t timeouts = 0;
+  for (auto i = 0; i < round_trips_; ++i) {
+    SendPacket command{};
+    command.yaw = static_cast<float>(i);
+    ReceivePacket echo{};
+    auto start_time = std::chrono::steady_clock::now();
+    serial.WriteData(command);
+    bool received;
+    do received = serial.ReadData(echo);
+    while (received && echo.yaw != command.yaw);
+    if (!received) {
+      ++timeouts;
+      continue;
+    }
+    round_trip_times.push_back(Seconds(start_time, std::chrono::steady_clock::now()) * 1e6);
+  }
+  stop_flag = true;
+  echo_thread.join();
+  std::sort(round_trip_times.begin(), round_trip_times.end());
+  double p50 = Percentile(round_trip_times, 50), p99 = Percentile(round_trip_times, 99);
+  LOG(INFO) << std::fixed << std::setprecision(1) << "Round trip: P50 " << p50 << " us, P99 " << p99
+            << " us, max " << Percentile(round_trip_times, 100) << " us, " << timeouts << " timed out.";
+  if (timeouts) {
+    LOG(ERROR) << timeouts << " / " << round_trips_ << " commands were not echoed back in time.";
+    ++regressions;
+  }
+#if NDEBUG
+  if (!baseline["ROUND_TRIP"].empty()) {
+    double baseline_max_p50 = 0, baseline_max_p99 = 0;
+    baseline["ROUND_TRIP"]["MAX_P50_US"] >> baseline_max_p50;
+    baseline["ROUND_TRIP"]["MAX_P99_US"] >> baseline_max_p99;
+    if (p50 > baseline_max_p50 || p99 > baseline_max_p99) {
+      LOG(ERROR) << "Round trip latency regressed: P50 " << p50 << " us and P99 " << p99 << " us exceed baseline "
+                 << baseline_max_p50 << " us and " << baseline_max_p99 << " us.";
+      ++regressions;
+    }
+  }
+#endif
+
+  // 吞吐量：模拟下位机连续发送，伪终端缓冲区满时阻塞，测量读出全部数据包的速率
+  std::atomic_bool done_flag{};
+  std::thread stream_thread([&]() {
+    std::array<uint8_t, ::serial::kMaxFrameSize> frame{};
+    for (auto i = 0; i < packets_; ++i) {
+      ReceivePacket packet{};
+      packet.mode = i;
+      if (!WriteAll(master_fd, frame.data(),
+                    ::serial::Pack(::serial::PacketType::RECEIVE, &packet, sizeof(ReceivePacket), frame.data())))
+        break;
+    }
+    done_flag = true;
+  });
+  auto frames = serial.Parser().Frames();
+  auto start_time = std::chrono::steady_clock::now();
+  ReceivePacket packet{};
+  while (serial.Parser().Frames() - frames < static_cast<uint64_t>(packets_))
+    if (!serial.ReadData(packet) && done_flag) break;
+  double stream_time = Seconds(start_time, std::chrono::steady_clock::now());
+  stream_thread.join();
+  auto stream_frames = serial.Parser().Frames() - frames;
+  double throughput = static_cast<double>(stream_frames) / stream_time;
+  LOG(INFO) << std::fixed << std::setprecision(0) << "Throughput: " << throughput << " packets/s, "
+            << stream_frames << " / " << packets_ << " packets received.";
+  if (stream_frames < static_cast<uint64_t>(packets_)) {
+    LOG(ERROR) << packets_ - stream_frames << " packets were lost without injected byte loss.";
+    ++regressions;
+  }
+#if NDEBUG
+  if (!baseline["THROUGHPUT"].empty()) {
+    double baseline_min_throughput = 0;
+    baseline["THROUGHPUT"]["MIN_PACKETS_PER_SECOND"] >> baseline_min_throughput;
+    if (throughput < baseline_min_throughput) {
+      LOG(ERROR) << "Throughput regressed: " << throughput << " packets/s is below baseline "
+                 << baseline_min_throughput << " packets/s.";
+      ++regressions;
+    }
+  }
+#endif
+
+  serial.Close();
+  close(master_fd);
+
+  // 丢字节：按概率丢弃每个字节，以随机长度分块送入解析器，模拟每次 read() 读到的字节数；
+  // 在每帧解析出的位置按序号逐帧核对，完整到达的帧都应被解析，损坏或重复的帧不应被接受
+  std::mt19937 random_engine(0);
+  std::bernoulli_distribution drop_distribution(loss_rate_);
+  auto loss_packet = [](int i) {
+    ReceivePacket packet{};
+    packet.mode = i;
+    packet.yaw = static_cast<float>(i);
+    packet.pitch = -static_cast<float>(i);
+    return packet;
+  };
+  std::vector<uint8_t> stream;
+  std::vector<bool> intact(packets_), parsed(packets_);
+  std::array<uint8_t, ::serial::kMaxFrameSize> frame{};
+  for (auto i = 0; i < packets_; ++i) {
+    auto sent_packet = loss_packet(i);
+    auto size = ::serial::Pack(::serial::PacketType::RECEIVE, &sent_packet, sizeof(ReceivePacket), frame.data());
+    auto stream_size = stream.size();
+    for (size_t k = 0; k < size; ++k)
+      if (!drop_distribution(random_engine)) stream.push_back(frame[k]);
+    intact[i] = stream.size() - stream_size == size;
+  }
+  ::serial::FrameParser parser;
+  size_t accepted_corruptions = 0;
+  // 丢失的字节恰为帧尾的 0xA5 时，下一帧的同步字节会补上它，该帧仍完整无误，故按内容而非是否丢字节判断损坏
+  auto on_frame = [&](::serial::PacketType type, const uint8_t *payload, size_t size) {
+    ReceivePacket received_packet{};
+    if (type != ::serial::PacketType::RECEIVE || size != sizeof(ReceivePacket)) {
+      ++accepted_corruptions;
+      return;
+    }
+    memcpy(&received_packet, payload, size);
+    auto i = received_packet.mode;
+    auto sent_packet = loss_packet(i);
+    if (i < 0 || i >= packets_ || parsed[i] || memcmp(&received_packet, &sent_packet, sizeof(ReceivePacket))) {
+      ++accepted_corruptions;
+      return;
+    }
+    parsed[i] = true;
+  };
+  std::uniform_int_distribution<size_t> chunk_distribution(1, 2 * ::serial::kMaxFrameSize);
+  for (size_t offset = 0; offset < stream.size();) {
+    auto chunk = std::min({chunk_distribution(random_engine), parser.WriteCapacity(), stream.size() - offset});
+    memcpy(parser.WriteBuffer(), stream.data() + offset, chunk);
+    parser.Commit(chunk, on_frame);
+    offset += chunk;
+  }
+  size_t intact_frames = 0, loss_frames = 0;
+  for (auto i = 0; i < packets_; ++i) {
+    intact_frames += intact[i];
+    loss_frames += intact[i] && parsed[i];
+  }
+  double recovery = intact_frames ? static_cast<double>(loss_frames) / static_cast<double>(intact_frames) : 1;
+  LOG(INFO) << std::fixed << std::setprecision(4) << "Byte loss: " << loss_frames << " / " << intact_frames
+            << " intact frames parsed (recovery " << recovery << "), " << intact_frames - loss_frames
+            << " intact frames missing from the sequence, " << parser.BadFrames() << " corrupted frames rejected, "
+            << parser.SkippedBytes() << " bytes skipped, " << accepted_corruptions
+            << " corrupted or duplicated frames accepted.";
+  if (accepted_corruptions) {
+    LOG(ERROR) << accepted_corruptions << " corrupted or duplicated frames passed the frame check.";
+    ++regressions;
+  }
+  if (!baseline["LOSS"].empty()) {
+    double baseline_min_recovery = 0;
+    baseline["LOSS"]["MIN_RECOVERY"] >> baseline_min_recovery;
+    if (recovery < baseline_min_recovery) {
+      LOG(ERROR) << "Resynchronization regressed: recovery " << recovery << " is below baseline "
+                 << baseline_min_recovery << ".";
+      ++regressions;
+    }
+  }
+
+  if (regressions) {
+    LOG(ERROR) << regressions << " serial case(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All serial cases passed baseline on " << Platform() << ".";
+  return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_SERIAL_BENCHMARK_SERIAL_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_SERIAL_BENCHMARK_SERIAL_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::serial {
+/**
+ * @brief 串口收发基准测试类，以伪终端对代替下位机，测量收发往返延迟、持续接收吞吐量与丢字节时的重新同步能力
+ * @details serial::Serial 打开伪终端从端，另一线程在主端模拟下位机：往返测试中把每条指令的 yaw 原样写回，
+ *   吞吐量测试中连续发送数据包；丢字节测试按概率丢弃每个字节后分块直接送入 serial::FrameParser，逐帧核对序号与内容；
+ *   往返延迟分位数或吞吐量劣于基准值（仅 Release 构建检查）、完整帧的解析比例低于基准值或接受了损坏的数据包时，测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("serial") @endcode 获取该类的公共接口指针
+ */
+class SerialBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<SerialBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  int round_trips_{};               ///< 往返测试的指令数
+  int packets_{};                   ///< 吞吐量与丢字节测试中模拟下位机发送的数据包数
+  double loss_rate_{};              ///< 丢字节测试中每个字节被丢弃的概率
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_SERIAL_BENCHMARK_SERIAL_H_
@@ -0,0 +1,336 @@
+#include <iomanip>
+#include <random>
+#include <glog/logging.h>
+#include "simd/simd.h"
+#include "benchmark-simd.h"
+
+benchmark::Registry<benchmark::simd::SIMDBenchmark> benchmark::simd::SIMDBenchmark::registry_("simd");
+
+namespace {
+/**
+ * @brief 待测函数描述
+ * @tparam T 浮点类型
+ */
+template<class T>
+struct Kernel {
+  std::string name;                                                ///< 函数名，同时作为基准数据的键
+  T lo, hi;                                                        ///< 输入取值范围
+  size_t outputs;                                                  ///< 输出数量，sincos 类函数为 2
+  void (*simd)(const T *x, const T *y, T *out, size_t n);          ///< SIMD 实现，批量处理 n 个输入
+  void (*ref)(const T *x, const T *y, T *out, size_t n);           ///< 标准库实现，用于速度对比
+  long double (*exact)(long double x, long double y, size_t k);    ///< 高精度参考值，k 为输出序号
+  T period{};                                                      ///< 非零时一半样本取在其整数倍附近，用于检验范围约简
+};
+
+constexpr double kWideRange = 1647099.3291652855;  ///< 双精度三角函数的约简定义域 2^20 * pi / 2
+
+/**
+ * @brief 计算以 ULP 为单位的误差
+ * @tparam T 浮点类型
+ * @param value 待测值
+ * @param exact 高精度参考值
+ * @return ULP 误差
+ */
+template<class T>
+double ULPError(T value, long double exact) {
+  if (std::isnan(value) || std::isnan(exact)) return std::isnan(value) == std::isnan(exact) ? 0 : INFINITY;
+  T rounded = static_cast<T>(exact);
+  T ulp = std::nextafter(std::abs(rounded), std::numeric_limits<T>::infinity()) - std::abs(rounded);
+  return static_cast<double>(std::abs(static_cast<long double>(value) - exact) / ulp);
+}
+
+std::vector<Kernel<float>> FloatKernels() {
+  return {
+      {"sin_cos_4f", -M_PI, M_PI, 2,
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; i += 4) ::simd::sin_cos_4f(x + i, out + i, out + n + i);
+       },
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = sinf(x[i]), out[n + i] = cosf(x[i]);
+       },
+       [](long double x, long double, size_t k) { return k ? cosl(x) : sinl(x); }},
+      {"sin_4f", -M_PI, M_PI, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::sin_4f(out + i);
+       },
+       [](const float *x, const float *, float *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = sinf(x[i]); },
+       [](long double x, long double, size_t) { return sinl(x); }},
+      {"sin_f", -M_PI, M_PI, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::sin_f(x[i]);
+       },
+       [](const float *x, const float *, float *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = sinf(x[i]); },
+       [](long double x, long double, size_t) { return sinl(x); }},
+      {"cos_4f", -M_PI, M_PI, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::cos_4f(out + i);
+       },
+       [](const float *x, const float *, float *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = cosf(x[i]); },
+       [](long double x, long double, size_t) { return cosl(x); }},
+      {"cos_f", -M_PI, M_PI, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::cos_f(x[i]);
+       },
+       [](const float *x, const float *, float *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = cosf(x[i]); },
+       [](long double x, long double, size_t) { return cosl(x); }},
+      {"tan_4f", -1.4, 1.4, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::tan_4f(out + i);
+       },
+       [](const float *x, const float *, float *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = tanf(x[i]); },
+       [](long double x, long double, size_t) { return tanl(x); }},
+      {"cot_4f", 0.1, 1.5, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::cot_4f(out + i);
+       },
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = 1.f / tanf(x[i]);
+       },
+       [](long double x, long double, size_t) { return 1.l / tanl(x); }},
+      {"atan_4f", -20, 20, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::atan_4f(out + i);
+       },
+       [](const float *x, const float *, float *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = atanf(x[i]); },
+       [](long double x, long double, size_t) { return atanl(x); }},
+      {"atan2_4f", -20, 20, 1,
+       [](const float *x, const float *y, float *out, size_t n) {
+         for (size_t i = 0; i < n; i += 4) ::simd::atan2_4f(y + i, x + i, out + i);
+       },
+       [](const float *x, const float *y, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = atan2f(y[i], x[i]);
+       },
+       [](long double x, long double y, size_t) { return atan2l(y, x); }},
+      {"atan2_f", -20, 20, 1,
+       [](const float *x, const float *y, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::atan2_f(y[i], x[i]);
+       },
+       [](const float *x, const float *y, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = atan2f(y[i], x[i]);
+       },
+       [](long double x, long double y, size_t) { return atan2l(y, x); }},
+      {"sqrt_f", 0, 400, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::sqrt_f(x[i]);
+       },
+       [](const float *x, const float *, float *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = sqrtf(x[i]); },
+       [](long double x, long double, size_t) { return sqrtl(x); }},
+      {"rsqrt_f", 1e-2, 400, 1,
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::rsqrt_f(x[i]);
+       },
+       [](const float *x, const float *, float *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = 1.f / sqrtf(x[i]);
+       },
+       [](long double x, long double, size_t) { return 1.l / sqrtl(x); }},
+  };
+}
+
+std::vector<Kernel<double>> DoubleKernels() {
+  std::vector<Kernel<double>> kernels = {
+      {"sin_cos_2d", -M_PI, M_PI, 2,
+       [](const double *x, const double *, double *out, size_t n) {
+         for (size_t i = 0; i < n; i += 2) ::simd::sin_cos_2d(x + i, out + i, out + n + i);
+       },
+       [](const double *x, const double *, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = sin(x[i]), out[n + i] = cos(x[i]);
+       },
+       [](long double x, long double, size_t k) { return k ? cosl(x) : sinl(x); }},
+      {"sin_cos_4d", -M_PI, M_PI, 2,
+       [](const double *x, const double *, double *out, size_t n) {
+         for (size_t i = 0; i < n; i += 4) ::simd::sin_cos_4d(x + i, out + i, out + n + i);
+       },
+       [](const double *x, const double *, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = sin(x[i]), out[n + i] = cos(x[i]);
+       },
+       [](long double x, long double, size_t k) { return k ? cosl(x) : sinl(x); }},
+      {"sin_4d", -M_PI, M_PI, 1,
+       [](const double *x, const double *, double *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::sin_4d(out + i);
+       },
+       [](const double *x, const double *, double *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = sin(x[i]); },
+       [](long double x, long double, size_t) { return sinl(x); }},
+      {"sin_d", -M_PI, M_PI, 1,
+       [](const double *x, const double *, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::sin_d(x[i]);
+       },
+       [](const double *x, const double *, double *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = sin(x[i]); },
+       [](long double x, long double, size_t) { return sinl(x); }},
+      {"cos_4d", -M_PI, M_PI, 1,
+       [](const double *x, const double *, double *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::cos_4d(out + i);
+       },
+       [](const double *x, const double *, double *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = cos(x[i]); },
+       [](long double x, long double, size_t) { return cosl(x); }},
+      {"cos_d", -M_PI, M_PI, 1,
+       [](const double *x, const double *, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::cos_d(x[i]);
+       },
+       [](const double *x, const double *, double *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = cos(x[i]); },
+       [](long double x, long double, size_t) { return cosl(x); }},
+      {"atan2_2d", -20, 20, 1,
+       [](const double *x, const double *y, double *out, size_t n) {
+         for (size_t i = 0; i < n; i += 2) ::simd::atan2_2d(y + i, x + i, out + i);
+       },
+       [](const double *x, const double *y, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = atan2(y[i], x[i]);
+       },
+       [](long double x, long double y, size_t) { return atan2l(y, x); }},
+      {"atan2_4d", -20, 20, 1,
+       [](const double *x, const double *y, double *out, size_t n) {
+         for (size_t i = 0; i < n; i += 4) ::simd::atan2_4d(y + i, x + i, out + i);
+       },
+       [](const double *x, const double *y, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = atan2(y[i], x[i]);
+       },
+       [](long double x, long double y, size_t) { return atan2l(y, x); }},
+      {"atan2_d", -20, 20, 1,
+       [](const double *x, const double *y, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::atan2_d(y[i], x[i]);
+       },
+       [](const double *x, const double *y, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = atan2(y[i], x[i]);
+       },
+       [](long double x, long double y, size_t) { return atan2l(y, x); }},
+      {"sqrt_4d", 0, 400, 1,
+       [](const double *x, const double *, double *out, size_t n) {
+         std::copy(x, x + n, out);
+         for (size_t i = 0; i < n; i += 4) ::simd::sqrt_4d(out + i);
+       },
+       [](const double *x, const double *, double *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = sqrt(x[i]); },
+       [](long double x, long double, size_t) { return sqrtl(x); }},
+      {"sqrt_d", 0, 400, 1,
+       [](const double *x, const double *, double *out, size_t n) {
+         for (size_t i = 0; i < n; ++i) out[i] = ::simd::sqrt_d(x[i]);
+       },
+       [](const double *x, const double *, double *out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = sqrt(x[i]); },
+       [](long double x, long double, size_t) { return sqrtl(x); }},
+  };
+  // 三角函数另在整个约简定义域内检验，pi / 2 整数倍附近约简后的余项最小，约简误差的相对影响最大
+  for (size_t i = 0, n = kernels.size(); i < n; ++i) {
+    if (!kernels[i].name.starts_with("sin") && !kernels[i].name.starts_with("cos")) continue;
+    auto wide_kernel = kernels[i];
+    wide_kernel.name += "_wide";
+    wide_kernel.lo = -kWideRange;
+    wide_kernel.hi = kWideRange;
+    wide_kernel.period = M_PI_2;
+    kernels.push_back(wide_kernel);
+  }
+  return kernels;
+}
+
+/**
+ * @brief 获取待测函数列表
+ * @tparam T 浮点类型
+ * @return 待测函数列表
+ */
+template<class T>
+std::vector<Kernel<T>> Kernels();
+
+template<>
+std::vector<Kernel<float>> Kernels() { return FloatKernels(); }
+
+template<>
+std::vector<Kernel<double>> Kernels() { return DoubleKernels(); }
+}
+
+bool benchmark::simd::SIMDBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open SIMD benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int samples = 0, repeats = 0;
+  baseline_["SAMPLES"] >> samples;
+  baseline_["REPEATS"] >> repeats;
+  if (samples <= 0 || samples % 4 || repeats <= 0) {
+    LOG(ERROR) << "Invalid sample or repeat count in SIMD benchmark baseline. Sample count must be a multiple of 4.";
+    baseline_.release();
+    return false;
+  }
+  samples_ = static_cast<size_t>(samples);
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "SIMD");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized SIMD benchmark with " << samples_ << " samples and " << repeats_ << " repeats.";
+  return true;
+}
+
+int benchmark::simd::SIMDBenchmark::Run() {
+  LOG(INFO) << std::left << std::setw(16) << "FUNCTION" << std::right
+            << std::setw(12) << "SIMD(ns)" << std::setw(12) << "LIBM(ns)" << std::setw(10) << "SPEEDUP"
+            << std::setw(12) << "MAX ULP" << std::setw(12) << "MEAN ULP" << std::setw(16) << "WORST INPUT";
+  size_t regressions = RunKernels<float>() + RunKernels<double>();
+  if (regressions) {
+    LOG(ERROR) << regressions << " SIMD function(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All SIMD functions passed baseline on " << Platform() << ".";
+  return 0;
+}
+
+template<class T>
+size_t benchmark::simd::SIMDBenchmark::RunKernels() {
+  std::mt19937 random_engine(0);
+  std::vector<T> x(samples_), y(samples_), simd_out(2 * samples_), ref_out(2 * samples_);
+  size_t regressions = 0;
+  for (auto &&kernel : Kernels<T>()) {
+    std::uniform_real_distribution<T> distribution(kernel.lo, kernel.hi), offset(-1, 1);
+    std::uniform_int_distribution<int> offset_exponent(0, 40);
+    for (size_t i = 0; i < samples_; ++i) {
+      x[i] = distribution(random_engine);
+      y[i] = distribution(random_engine);
+      if (kernel.period != 0 && i % 2)
+        x[i] = std::round(x[i] / kernel.period) * kernel.period
+            + std::ldexp(offset(random_engine), -offset_exponent(random_engine));
+    }
+    double simd_time = MeasureTime([&]() { kernel.simd(x.data(), y.data(), simd_out.data(), samples_); }, repeats_);
+    double ref_time = MeasureTime([&]() { kernel.ref(x.data(), y.data(), ref_out.data(), samples_); }, repeats_);
+    double max_ulp = 0, sum_ulp = 0;
+    T worst_x = 0;
+    for (size_t k = 0; k < kernel.outputs; ++k)
+      for (size_t i = 0; i < samples_; ++i) {
+        double ulp = ULPError(simd_out[k * samples_ + i], kernel.exact(x[i], y[i], k));
+        sum_ulp += ulp;
+        if (ulp > max_ulp) {
+          max_ulp = ulp;
+          worst_x = x[i];
+        }
+      }
+    double simd_ns = simd_time / static_cast<double>(samples_), ref_ns = ref_time / static_cast<double>(samples_);
+    double speedup = ref_time / simd_time;
+    LOG(INFO) << std::left << std::setw(16) << kernel.name << std::right << std::fixed
+              << std::setw(12) << std::setprecision(3) << simd_ns << std::setw(12) << ref_ns
+              << std::setw(10) << std::setprecision(2) << speedup
+              << std::setw(12) << std::setprecision(2) << max_ulp
+              << std::setw(12) << std::setprecision(3) << sum_ulp / static_cast<double>(kernel.outputs * samples_)
+              << std::setw(16) << std::setprecision(6) << worst_x;
+    auto baseline = platform_baseline_[kernel.name];
+    if (baseline.empty()) continue;
+    double baseline_max_ulp = 0, baseline_min_speedup = 0;
+    baseline["MAX_ULP"] >> baseline_max_ulp;
+    baseline["MIN_SPEEDUP"] >> baseline_min_speedup;
+    if (max_ulp > baseline_max_ulp) {
+      LOG(ERROR) << kernel.name << " accuracy regressed: max error " << max_ulp
+                 << " ULP exceeds baseline " << baseline_max_ulp << " ULP.";
+      ++regressions;
+    }
+#if NDEBUG
+    if (speedup < baseline_min_speedup) {
+      LOG(ERROR) << kernel.name << " speed regressed: speedup " << speedup
+                 << " is below baseline " << baseline_min_speedup << ".";
+      ++regressions;
+    }
+#endif
+  }
+  return regressions;
+}
@@ -0,0 +1,39 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_SIMD_BENCHMARK_SIMD_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_SIMD_BENCHMARK_SIMD_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::simd {
+/**
+ * @brief SIMD 数学函数基准测试类，对比 simd:: 各函数与 <cmath> 的速度和 ULP 误差
+ * @details 精度以 long double 标准库结果为参考，在实际输入范围内稠密采样，双精度三角函数另以 *_wide 项在整个约简定义域内采样，
+ *   其中一半样本取在 pi / 2 整数倍附近；
+ *   任一函数的最大 ULP 误差超过基准值，或相对标准库的加速比低于基准值（仅 Release 构建检查）时，测试失败
+ * @note 标准库对照循环与 simd.cpp 相同，以 -fno-unsafe-math-optimizations 编译，不会被自动向量化
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("simd") @endcode 获取该类的公共接口指针
+ */
+class SIMDBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  /**
+   * @brief 测试一组同类型函数
+   * @tparam T 浮点类型
+   * @return 退化的函数数量
+   */
+  template<class T>
+  size_t RunKernels();
+
+  static Registry<SIMDBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  size_t samples_{};                ///< 每个函数的采样数量
+  size_t repeats_{};                ///< 计时重复次数
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_SIMD_BENCHMARK_SIMD_H_
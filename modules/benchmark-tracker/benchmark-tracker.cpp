@@ -0,0 +1,164 @@
+#include <iomanip>
+#include <random>
+#include <glog/logging.h>
+#include "tracker/tracker.h"
+#include "benchmark-tracker.h"
+
+benchmark::Registry<benchmark::tracker::TrackerBenchmark>
+    benchmark::tracker::TrackerBenchmark::registry_("tracker");
+
+namespace {
+/// 单帧测量样本
+struct Sample {
+  coordinate::CTVec ctv_truth;  ///< 真实位置
+  coordinate::STVec stv_world;  ///< 带噪声的测量值
+};
+
+/**
+ * @brief 生成正弦运动目标的测量序列
+ * @details 目标在约 5 m 外横移（振幅 0.5 m，周期 2 s）并前后移动（振幅 0.3 m，周期 3 s），模拟小陀螺以外的常见机动
+ * @param [in] measurement_noise 测量标准差，依次为：水平角 rad、俯仰角 rad、距离的相对误差
+ * @param phase 运动初相位，区分不同目标
+ * @param steps 测量帧数
+ * @param frame_rate 测量帧率，单位：Hz
+ * @param [in,out] random_engine 随机数引擎
+ * @param [out] samples 测量序列
+ */
+void SyntheticSamples(coordinate::STVec REF_IN measurement_noise, double phase, int steps, double frame_rate,
+                      std::mt19937 REF_OUT random_engine, std::vector<Sample> REF_OUT samples) {
+  std::normal_distribution<double> noise_distribution(0, 1);
+  samples.resize(steps);
+  for (auto k = 0; k < steps; ++k) {
+    double t = k / frame_rate;
+    auto &&sample = samples[k];
+    sample.ctv_truth << 0.5 * std::sin(M_PI * t + phase), -0.2, 5 + 0.3 * std::sin(2 * M_PI * t / 3 + phase);
+    sample.stv_world = coordinate::CoordSolver::CTVecToSTVec(sample.ctv_truth);
+    sample.stv_world.x() += measurement_noise.x() * noise_distribution(random_engine);
+    sample.stv_world.y() += measurement_noise.y() * noise_distribution(random_engine);
+    sample.stv_world.z() *= 1 + measurement_noise.z() * noise_distribution(random_engine);
+  }
+}
+
+/**
+ * @brief 对一种运动模型执行精度与耗时测试
+ * @tparam T 跟踪器类型
+ * @param [in] param 跟踪器参数
+ * @param [in] sequences 每个目标的测量序列
+ * @param frame_rate 测量帧率，单位：Hz
+ * @param [in] measure_time 计时函数
+ * @param [out] error_ratio 滤波后位置均方根误差与原始测量均方根误差之比
+ * @return 单个目标单次更新的耗时，单位：ns
+ */
+template<class T>
+double RunModel(::tracker::Param REF_IN param,
+                std::vector<std::vector<Sample>> REF_IN sequences,
+                double frame_rate,
+                std::function<double(std::function<void()> REF_IN)> REF_IN measure_time,
+                double REF_OUT error_ratio) {
+  auto frame_time_ns = static_cast<uint64_t>(1e9 / frame_rate);
+  std::vector<T> trackers(sequences.size());
+  for (auto &&tracker : trackers) tracker.SetParam(param);
+  // 跳过收敛阶段，只统计稳态误差
+  size_t steps = sequences.front().size(), warm_up_steps = steps / 10;
+  double raw_squared_error = 0, filtered_squared_error = 0;
+  for (size_t k = 0; k < steps; ++k)
+    for (size_t i = 0; i < trackers.size(); ++i) {
+      auto &&sample = sequences[i][k];
+      trackers[i].Update(sample.stv_world, k * frame_time_ns);
+      if (k < warm_up_steps) continue;
+      raw_squared_error += (coordinate::CoordSolver::STVecToCTVec(sample.stv_world) - sample.ctv_truth).squaredNorm();
+      filtered_squared_error += (trackers[i].Position(k * frame_time_ns) - sample.ctv_truth).squaredNorm();
+    }
+  error_ratio = std::sqrt(filtered_squared_error / raw_squared_error);
+
+  // 计时时继续沿时间轴推进，测量值循环使用序列中的数据
+  size_t step = steps;
+  double frame_time = measure_time([&]() {
+    for (size_t i = 0; i < trackers.size(); ++i)
+      trackers[i].Update(sequences[i][step % steps].stv_world, step * frame_time_ns);
+    ++step;
+  });
+  return frame_time / static_cast<double>(trackers.size());
+}
+}
+
+bool benchmark::tracker::TrackerBenchmark::Initialize(std::string REF_IN config_file) {
+  baseline_.open(config_file, cv::FileStorage::READ);
+  if (!baseline_.isOpened()) {
+    LOG(ERROR) << "Failed to open tracker benchmark baseline file " << config_file << ".";
+    return false;
+  }
+  int repeats = 0;
+  baseline_["REPEATS"] >> repeats;
+  baseline_["TRACKS"] >> tracks_;
+  baseline_["STEPS"] >> steps_;
+  baseline_["FRAME_RATE"] >> frame_rate_;
+  baseline_["TRACKER_CONFIG"] >> tracker_config_;
+  if (repeats <= 0 || tracks_ <= 0 || steps_ < 10 || frame_rate_ <= 0) {
+    LOG(ERROR) << "Invalid repeat count, track count, step count or frame rate in tracker benchmark baseline. "
+               << "At least 10 steps are required.";
+    baseline_.release();
+    return false;
+  }
+  if (tracker_config_.empty()) {
+    LOG(ERROR) << "Tracker configuration not found in tracker benchmark baseline.";
+    baseline_.release();
+    return false;
+  }
+  repeats_ = static_cast<size_t>(repeats);
+  platform_baseline_ = PlatformBaseline(baseline_, "tracker");
+#if !NDEBUG
+  LOG(WARNING) << "Speed baseline is only checked in release builds.";
+#endif
+  LOG(INFO) << "Initialized tracker benchmark with " << tracks_ << " tracks, " << steps_ << " steps and "
+            << repeats_ << " repeats.";
+  return true;
+}
+
+int benchmark::tracker::TrackerBenchmark::Run() {
+  auto measure_time = [&](std::function<void()> REF_IN func) { return MeasureTime(func, repeats_); };
+  LOG(INFO) << std::left << std::setw(8) << "MODEL" << std::right << std::setw(12) << "UPDATE(us)"
+            << std::setw(14) << "ERROR RATIO";
+  size_t regressions = 0;
+  for (std::string model : {"CV", "CA"}) {
+    ::tracker::Param param;
+    if (!param.Initialize(tracker_config_, model)) {
+      LOG(ERROR) << "Failed to read " << model << " tracker configurations.";
+      return 1;
+    }
+    // 每种模型使用相同的随机种子，保证测量序列一致
+    std::mt19937 random_engine(0);
+    std::vector<std::vector<Sample>> sequences(tracks_);
+    for (auto i = 0; i < tracks_; ++i)
+      SyntheticSamples(param.measurement_noise, 2 * M_PI * i / tracks_, steps_, frame_rate_, random_engine,
+                       sequences[i]);
+    double error_ratio, update_time = model == "CV"
+        ? RunModel<::tracker::CVTracker>(param, sequences, frame_rate_, measure_time, error_ratio)
+        : RunModel<::tracker::CATracker>(param, sequences, frame_rate_, measure_time, error_ratio);
+    LOG(INFO) << std::left << std::setw(8) << model << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << update_time * 1e-3 << std::setw(14) << error_ratio;
+    auto baseline = platform_baseline_[model];
+    if (baseline.empty()) continue;
+    double baseline_max_error_ratio = 0, baseline_max_time = 0;
+    baseline["MAX_ERROR_RATIO"] >> baseline_max_error_ratio;
+    baseline["MAX_TIME_US"] >> baseline_max_time;
+    if (error_ratio > baseline_max_error_ratio) {
+      LOG(ERROR) << model << " accuracy regressed: error ratio " << error_ratio
+                 << " exceeds baseline " << baseline_max_error_ratio << ".";
+      ++regressions;
+    }
+#if NDEBUG
+    if (update_time * 1e-3 > baseline_max_time) {
+      LOG(ERROR) << model << " speed regressed: " << update_time * 1e-3 << " us exceeds baseline "
+                 << baseline_max_time << " us.";
+      ++regressions;
+    }
+#endif
+  }
+  if (regressions) {
+    LOG(ERROR) << regressions << " tracker case(s) regressed against baseline on " << Platform() << ".";
+    return 1;
+  }
+  LOG(INFO) << "All tracker cases passed baseline on " << Platform() << ".";
+  return 0;
+}
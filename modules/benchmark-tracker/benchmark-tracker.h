@@ -0,0 +1,32 @@
+#ifndef SRM_IC_2023_MODULES_BENCHMARK_TRACKER_BENCHMARK_TRACKER_H_
+#define SRM_IC_2023_MODULES_BENCHMARK_TRACKER_BENCHMARK_TRACKER_H_
+
+#include <opencv2/core/persistence.hpp>
+#include "benchmark-base/benchmark-base.h"
+
+namespace benchmark::tracker {
+/**
+ * @brief 目标跟踪器基准测试类，测量匀速、匀加速模型的单次更新耗时与滤波精度
+ * @details 多个目标在世界坐标系中做正弦运动，测量值按跟踪器配置的噪声水平加入高斯噪声；
+ *   滤波后位置误差与原始测量误差之比高于基准值，或单个目标的平均更新耗时超过基准值（仅 Release 构建检查）时，测试失败
+ * @warning 禁止直接构造此类，请使用 @code benchmark::CreateBenchmark("tracker") @endcode 获取该类的公共接口指针
+ */
+class TrackerBenchmark final : public Benchmark {
+ public:
+  bool Initialize(std::string REF_IN config_file) final;
+  int Run() final;
+
+ private:
+  static Registry<TrackerBenchmark> registry_;  ///< 基准测试注册信息
+
+  cv::FileStorage baseline_;        ///< 基准数据
+  cv::FileNode platform_baseline_;  ///< 当前平台的基准数据，为空时跳过退化检查
+  size_t repeats_{};                ///< 计时重复次数
+  int tracks_{};                    ///< 同时跟踪的目标数量
+  int steps_{};                     ///< 每个目标的测量帧数
+  double frame_rate_{};             ///< 测量帧率，单位：Hz
+  std::string tracker_config_;      ///< 跟踪器配置文件路径
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_BENCHMARK_TRACKER_BENCHMARK_TRACKER_H_
@@ -25,20 +25,6 @@
     return false;                             \
   }
 
-#define GX_START_STOP_STREAM_CHECK_STATUS(status_code)  \
-  if ((status_code) != GX_STATUS_SUCCESS) {             \
-    if (raw_16_to_8_cache_) {                           \
-      delete[] raw_16_to_8_cache_;                      \
-      raw_16_to_8_cache_ = nullptr;                     \
-    }                                                   \
-    if (raw_8_to_rgb_24_cache_) {                       \
-      delete[] raw_8_to_rgb_24_cache_;                  \
-      raw_8_to_rgb_24_cache_ = nullptr;                 \
-    }                                                   \
-    LOG(ERROR) << GetErrorInfo(status_code);            \
-    return false;                                       \
-  }
-
 uint16_t camera::dh::DHCamera::camera_count_ = 0;
 camera::Registry<camera::dh::DHCamera> camera::dh::DHCamera::registry_("DHCamera");
 
@@ -154,10 +140,8 @@ bool camera::dh::DHCamera::StartStream() {
   if (!device_) return false;
   if (stream_running_) return false;
   ExportConfigurationFile("../cache/" + serial_number_ + ".txt");
-  raw_8_to_rgb_24_cache_ = new unsigned char[payload_size_ * 3];
-  raw_16_to_8_cache_ = new unsigned char[payload_size_];
   GX_STATUS status_code = GXStreamOn(device_);
-  GX_START_STOP_STREAM_CHECK_STATUS(status_code)
+  GX_CHECK_STATUS(status_code)
   stream_running_ = true;
   LOG(INFO) << serial_number_ << "'s stream started.";
   return true;
@@ -168,15 +152,7 @@ bool camera::dh::DHCamera::StopStream() {
   if (!stream_running_) return false;
   stream_running_ = false;
   GX_STATUS status_code = GXStreamOff(device_);
-  GX_START_STOP_STREAM_CHECK_STATUS(status_code)
-  if (raw_16_to_8_cache_ != nullptr) {
-    delete[] raw_16_to_8_cache_;
-    raw_16_to_8_cache_ = nullptr;
-  }
-  if (raw_8_to_rgb_24_cache_ != nullptr) {
-    delete[] raw_8_to_rgb_24_cache_;
-    raw_8_to_rgb_24_cache_ = nullptr;
-  }
+  GX_CHECK_STATUS(status_code)
   LOG(INFO) << serial_number_ << "'s stream stopped.";
   return true;
 }
@@ -252,11 +228,10 @@ void camera::dh::DHCamera::DefaultCaptureCallback(GX_FRAME_CALLBACK_PARAM *frame
     LOG(ERROR) << GetErrorInfo(frame_callback->status);
     return;
   }
-  if (!self->Raw8Raw16ToRGB24(frame_callback)) return;
   Frame frame;
-  cv::Mat image(frame_callback->nHeight, frame_callback->nWidth, CV_8UC3, self->raw_8_to_rgb_24_cache_);
-  frame.image = image.clone();
+  if (!self->RawToBayer8(frame_callback, frame)) return;
   frame.time_stamp = frame_callback->nTimestamp;
+  frame.receive_time = Frame::HostTime();
   for (auto p : self->callback_list_)
     (*p.first)(p.second, frame);
   self->buffer_.Push(std::move(frame));
@@ -269,17 +244,8 @@ void *camera::dh::DHCamera::DaemonThreadFunction(void *obj) {
     if (!self->IsConnected()) {
       LOG(ERROR) << self->serial_number_ << " is disconnected unexpectedly.";
       LOG(INFO) << "Preparing for reconnection...";
-      if (self->stream_running_) {
+      if (self->stream_running_)
         GXStreamOff(self->device_);
-        if (self->raw_16_to_8_cache_) {
-          delete[] self->raw_16_to_8_cache_;
-          self->raw_16_to_8_cache_ = nullptr;
-        }
-        if (self->raw_8_to_rgb_24_cache_) {
-          delete[] self->raw_8_to_rgb_24_cache_;
-          self->raw_8_to_rgb_24_cache_ = nullptr;
-        }
-      }
       self->UnregisterCaptureCallback();
       --camera_count_;
       GXCloseDevice(self->device_);
@@ -292,20 +258,10 @@ void *camera::dh::DHCamera::DaemonThreadFunction(void *obj) {
       while (!self->OpenCamera(self->serial_number_, "../cache/" + self->serial_number_ + ".txt"))
         sleep(1);
       if (self->stream_running_) {
-        self->raw_8_to_rgb_24_cache_ = new unsigned char[self->payload_size_ * 3];
-        self->raw_16_to_8_cache_ = new unsigned char[self->payload_size_];
         GX_STATUS status_code = GXStreamOn(self->device_);
         if (status_code != GX_STATUS_SUCCESS) {
           LOG(ERROR) << GetErrorInfo(status_code);
           GXStreamOff(self->device_);
-          if (self->raw_16_to_8_cache_) {
-            delete[] self->raw_16_to_8_cache_;
-            self->raw_16_to_8_cache_ = nullptr;
-          }
-          if (self->raw_8_to_rgb_24_cache_) {
-            delete[] self->raw_8_to_rgb_24_cache_;
-            self->raw_8_to_rgb_24_cache_ = nullptr;
-          }
           self->stream_running_ = false;
         }
       }
@@ -392,24 +348,36 @@ std::string camera::dh::DHCamera::GetErrorInfo(GX_STATUS error_status_code) {
   return error_info;
 }
 
-bool camera::dh::DHCamera::Raw8Raw16ToRGB24(GX_FRAME_CALLBACK_PARAM *frame_callback) {
-  VxInt32 dx_status_code;
+bool camera::dh::DHCamera::RawToBayer8(GX_FRAME_CALLBACK_PARAM *frame_callback, Frame REF_OUT frame) {
+  switch (color_filter_) {
+    case GX_COLOR_FILTER_BAYER_RG: {
+      frame.bayer_pattern = simd::BayerPattern::RG;
+      break;
+    }
+    case GX_COLOR_FILTER_BAYER_GB: {
+      frame.bayer_pattern = simd::BayerPattern::GB;
+      break;
+    }
+    case GX_COLOR_FILTER_BAYER_GR: {
+      frame.bayer_pattern = simd::BayerPattern::GR;
+      break;
+    }
+    case GX_COLOR_FILTER_BAYER_BG: {
+      frame.bayer_pattern = simd::BayerPattern::BG;
+      break;
+    }
+    default: {
+      LOG(ERROR) << "Color filter of this camera is not supported.";
+      return false;
+    }
+  }
   switch (frame_callback->nPixelFormat) {
     case GX_PIXEL_FORMAT_BAYER_GR8:
     case GX_PIXEL_FORMAT_BAYER_RG8:
     case GX_PIXEL_FORMAT_BAYER_GB8:
     case GX_PIXEL_FORMAT_BAYER_BG8: {
-      dx_status_code = DxRaw8toRGB24Ex((unsigned char *) frame_callback->pImgBuf,
-                                       raw_8_to_rgb_24_cache_,
-                                       frame_callback->nWidth,
-                                       frame_callback->nHeight,
-                                       RAW2RGB_NEIGHBOUR,
-                                       DX_PIXEL_COLOR_FILTER(color_filter_),
-                                       false, DX_ORDER_BGR);
-      if (dx_status_code != DX_OK) {
-        LOG(ERROR) << "DxRaw8toRGB24Ex failed with error " << std::to_string(dx_status_code) << ".";
-        return false;
-      }
+      cv::Mat image(frame_callback->nHeight, frame_callback->nWidth, CV_8UC1, (void *) frame_callback->pImgBuf);
+      frame.bayer = image.clone();
       break;
     }
     case GX_PIXEL_FORMAT_BAYER_GR10:
@@ -420,24 +388,14 @@ bool camera::dh::DHCamera::Raw8Raw16ToRGB24(GX_FRAME_CALLBACK_PARAM *frame_callb
     case GX_PIXEL_FORMAT_BAYER_RG12:
     case GX_PIXEL_FORMAT_BAYER_GB12:
     case GX_PIXEL_FORMAT_BAYER_BG12: {
-      dx_status_code = DxRaw16toRaw8((unsigned char *) frame_callback->pImgBuf,
-                                     raw_16_to_8_cache_,
-                                     frame_callback->nWidth,
-                                     frame_callback->nHeight,
-                                     DX_BIT_2_9);
-      if (dx_status_code != DX_OK) {
-        LOG(ERROR) << "DxRaw8toRGB24 failed with error " << std::to_string(dx_status_code) << ".";
-        return false;
-      }
-      dx_status_code = DxRaw8toRGB24Ex(raw_16_to_8_cache_,
-                                       raw_8_to_rgb_24_cache_,
-                                       frame_callback->nWidth,
-                                       frame_callback->nHeight,
-                                       RAW2RGB_NEIGHBOUR,
-                                       DX_PIXEL_COLOR_FILTER(color_filter_),
-                                       false, DX_ORDER_BGR);
+      frame.bayer.create(frame_callback->nHeight, frame_callback->nWidth, CV_8UC1);
+      VxInt32 dx_status_code = DxRaw16toRaw8((unsigned char *) frame_callback->pImgBuf,
+                                             frame.bayer.data,
+                                             frame_callback->nWidth,
+                                             frame_callback->nHeight,
+                                             DX_BIT_2_9);
       if (dx_status_code != DX_OK) {
-        LOG(ERROR) << "DxRaw8toRGB24Ex failed with error " << std::to_string(dx_status_code) << ".";
+        LOG(ERROR) << "DxRaw16toRaw8 failed with error " << std::to_string(dx_status_code) << ".";
         return false;
       }
       break;
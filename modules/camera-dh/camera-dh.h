@@ -36,16 +36,14 @@ class DHCamera final : public Camera {
   bool SetGainValueDHImplementation(double gain);
   bool SetGainAuto(GX_GAIN_AUTO_ENTRY gx_gain_auto_entry);
   static std::string GetErrorInfo(GX_STATUS error_status_code);
-  bool Raw8Raw16ToRGB24(GX_FRAME_CALLBACK_PARAM *frame_callback);
+  bool RawToBayer8(GX_FRAME_CALLBACK_PARAM *frame_callback, Frame REF_OUT frame);
 
   static Registry<DHCamera> registry_;  ///< 相机注册信息
   static uint16_t camera_count_;        ///< 全局相机计数
 
-  GX_DEV_HANDLE device_{};                  ///< 设备句柄
-  int64_t color_filter_{};                  ///< 像素颜色格式
-  int64_t payload_size_{};                  ///< 数据包大小
-  unsigned char *raw_8_to_rgb_24_cache_{};  ///< 颜色转换缓存
-  unsigned char *raw_16_to_8_cache_{};      ///< 颜色转换缓存
+  GX_DEV_HANDLE device_{};  ///< 设备句柄
+  int64_t color_filter_{};  ///< 像素颜色格式
+  int64_t payload_size_{};  ///< 数据包大小
 };
 }
 
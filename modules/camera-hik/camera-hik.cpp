@@ -1,5 +1,4 @@
 #include <glog/logging.h>
-#include <opencv2/imgproc.hpp>
 #include <MvCameraControl.h>
 #include "camera-hik.h"
 
@@ -197,8 +196,8 @@ void camera::hik::HikCamera::ImageCallbackEx(unsigned char *image_data, MV_FRAME
   switch (frame_info->enPixelType) {
     case PixelType_Gvsp_BayerRG8: {
       cv::Mat image(frame_info->nHeight, frame_info->nWidth, CV_8UC1, image_data);
-      frame.image = image.clone();
-      cv::cvtColor(frame.image, frame.image, cv::COLOR_BayerRG2RGB);
+      frame.bayer = image.clone();
+      frame.bayer_pattern = simd::BayerPattern::RG;
       break;
     }
     case PixelType_Gvsp_BGR8_Packed: {
@@ -211,6 +210,7 @@ void camera::hik::HikCamera::ImageCallbackEx(unsigned char *image_data, MV_FRAME
   frame.time_stamp = (uint64_t) frame_info->nDevTimeStampHigh;
   frame.time_stamp <<= 32;
   frame.time_stamp += frame_info->nDevTimeStampLow;
+  frame.receive_time = Frame::HostTime();
   for (auto p : self->callback_list_)
     (*p.first)(p.second, frame);
   self->buffer_.Push(std::move(frame));
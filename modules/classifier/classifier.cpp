@@ -0,0 +1,107 @@
+#include <glog/logging.h>
+#include <opencv2/imgproc.hpp>
+#include "classifier.h"
+
+namespace {
+constexpr int kWarpHeight = 28;          ///< 透视变换结果高度
+constexpr float kLightTop = 7;           ///< 灯条上端点在变换结果中的纵坐标
+constexpr float kLightBottom = 19;       ///< 灯条下端点在变换结果中的纵坐标
+constexpr int kWarpWidth[2] = {32, 54};  ///< 小装甲板、大装甲板变换结果宽度，灯条位于左右边缘
+}
+
+bool classifier::Classifier::Initialize(std::string REF_IN weights_file, int max_batch) {
+  cv::FileStorage weights;
+  weights.open(weights_file, cv::FileStorage::READ);
+  if (!weights.isOpened()) {
+    LOG(ERROR) << "Failed to open classifier weights file " << weights_file << ".";
+    return false;
+  }
+  if (!Initialize(weights.root(), max_batch)) {
+    LOG(ERROR) << "Failed to load classifier weights from " << weights_file << ".";
+    return false;
+  }
+  return true;
+}
+
+bool classifier::Classifier::Initialize(cv::FileNode REF_IN weights, int max_batch) {
+  std::vector<int> input_size;
+  cv::Mat fc1_bias, fc2_bias;
+  weights["INPUT_SIZE"] >> input_size;
+  weights["CLASSES"] >> classes_;
+  weights["FC1_WEIGHTS"] >> fc1_weights_;
+  weights["FC1_BIAS"] >> fc1_bias;
+  weights["FC2_WEIGHTS"] >> fc2_weights_;
+  weights["FC2_BIAS"] >> fc2_bias;
+  if (input_size.size() != 2 || input_size[1] != kWarpHeight || input_size[0] <= 0 || input_size[0] > kWarpWidth[0]) {
+    LOG(ERROR) << "Invalid classifier input size. Height must be " << kWarpHeight
+               << " and width must be no more than " << kWarpWidth[0] << ".";
+    return false;
+  }
+  patch_size_ = {input_size[0], input_size[1]};
+  if (fc1_weights_.type() != CV_32F || fc2_weights_.type() != CV_32F
+      || fc1_bias.type() != CV_32F || fc2_bias.type() != CV_32F
+      || fc1_weights_.cols != patch_size_.area() || static_cast<int>(fc1_bias.total()) != fc1_weights_.rows
+      || fc2_weights_.cols != fc1_weights_.rows || fc2_weights_.rows != static_cast<int>(classes_.size())
+      || static_cast<int>(fc2_bias.total()) != fc2_weights_.rows) {
+    LOG(ERROR) << "Classifier weights do not match the network structure.";
+    return false;
+  }
+  if (max_batch <= 0) {
+    LOG(ERROR) << "Invalid classifier batch size " << max_batch << ".";
+    return false;
+  }
+  max_batch_ = max_batch;
+  cv::repeat(fc1_bias.reshape(1, 1), max_batch_, 1, fc1_bias_);
+  cv::repeat(fc2_bias.reshape(1, 1), max_batch_, 1, fc2_bias_);
+  batch_.create(max_batch_, patch_size_.area(), CV_32F);
+  hidden_.create(max_batch_, fc1_weights_.rows, CV_32F);
+  output_.create(max_batch_, fc2_weights_.rows, CV_32F);
+  patch_.create(patch_size_, CV_8UC1);
+  LOG(INFO) << "Initialized armor classifier with " << classes_.size() << " classes and "
+            << fc1_weights_.rows << " hidden units.";
+  return true;
+}
+
+void classifier::Classifier::Classify(cv::Mat REF_IN image, std::vector<Candidate> REF_OUT candidates) {
+  for (size_t begin = 0; begin < candidates.size(); begin += max_batch_) {
+    auto n = std::min(candidates.size() - begin, static_cast<size_t>(max_batch_));
+    for (size_t i = 0; i < n; ++i) {
+      cv::Mat row = batch_.row(static_cast<int>(i));
+      ExtractPatch(image, candidates[begin + i], row);
+    }
+    Infer(batch_.rowRange(0, static_cast<int>(n)), candidates.data() + begin);
+  }
+}
+
+void classifier::Classifier::ExtractPatch(cv::Mat REF_IN image, Candidate REF_IN candidate, cv::Mat REF_OUT row) {
+  int index = candidate.size == Armor::ArmorSize::BIG;
+  auto width = static_cast<float>(kWarpWidth[index]);
+  cv::Point2f target_vertexes[4] = {{0, kLightBottom}, {0, kLightTop},
+                                    {width - 1, kLightTop}, {width - 1, kLightBottom}};
+  auto transform = cv::getPerspectiveTransform(candidate.vertexes.data(), target_vertexes);
+  cv::warpPerspective(image, warp_[index], transform, {kWarpWidth[index], kWarpHeight});
+  auto roi = warp_[index].colRange((kWarpWidth[index] - patch_size_.width) / 2,
+                                   (kWarpWidth[index] + patch_size_.width) / 2);
+  if (roi.channels() == 3) {
+    cv::cvtColor(roi, gray_, cv::COLOR_BGR2GRAY);
+    cv::threshold(gray_, patch_, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+  } else
+    cv::threshold(roi, patch_, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+  patch_.reshape(1, 1).convertTo(row, CV_32F, 1. / 255);
+}
+
+void classifier::Classifier::Infer(cv::Mat REF_IN batch, Candidate *candidates) {
+  auto n = batch.rows;
+  cv::Mat hidden = hidden_.rowRange(0, n), output = output_.rowRange(0, n);
+  cv::gemm(batch, fc1_weights_, 1, fc1_bias_.rowRange(0, n), 1, hidden, cv::GEMM_2_T);
+  cv::max(hidden, 0, hidden);
+  cv::gemm(hidden, fc2_weights_, 1, fc2_bias_.rowRange(0, n), 1, output, cv::GEMM_2_T);
+  for (auto i = 0; i < n; ++i) {
+    auto logits = output.ptr<float>(i);
+    auto id = static_cast<int>(std::max_element(logits, logits + output.cols) - logits);
+    float sum = 0;
+    for (auto j = 0; j < output.cols; ++j) sum += std::exp(logits[j] - logits[id]);
+    candidates[i].id = id;
+    candidates[i].confidence = 1 / sum;
+  }
+}
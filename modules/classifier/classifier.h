@@ -0,0 +1,86 @@
+#ifndef SRM_IC_2023_MODULES_CLASSIFIER_CLASSIFIER_H_
+#define SRM_IC_2023_MODULES_CLASSIFIER_CLASSIFIER_H_
+
+#include <opencv2/core/mat.hpp>
+#include <opencv2/core/persistence.hpp>
+#include "common/armor.h"
+
+namespace classifier {
+/// 待分类的装甲板候选
+struct Candidate {
+  std::array<cv::Point2f, 4> vertexes;  ///< 四个图像坐标点，顺序同 Armor
+  Armor::ArmorSize size;                ///< 装甲板类型
+  int id;                               ///< 分类结果，0 表示负样本
+  float confidence;                     ///< 分类置信度
+};
+
+/**
+ * @brief 装甲板编号分类器
+ * @details 将每个候选两灯条之间的图案透视变换到固定尺寸，Otsu 二值化后按行展开，
+ *   整帧候选打包为一个连续批次，经两层全连接网络（ReLU、softmax）一次性推理；
+ *   所有缓冲区按最大批次预先分配，推理过程不分配内存
+ */
+class Classifier final {
+ public:
+  Classifier() = default;
+  ~Classifier() = default;
+
+  /// 类别名称，下标即编号
+  attr_reader_ref(classes_, Classes)
+
+  /**
+   * @brief 初始化分类器
+   * @param [in] weights_file 权重文件路径
+   * @param max_batch 单次推理的最大候选数，超出时分批推理
+   * @return 是否初始化成功
+   */
+  bool Initialize(std::string REF_IN weights_file, int max_batch);
+
+  /**
+   * @brief 从已读取的权重节点初始化分类器
+   * @param [in] weights 权重节点，键名与权重文件相同
+   * @param max_batch 单次推理的最大候选数，超出时分批推理
+   * @return 是否初始化成功
+   */
+  bool Initialize(cv::FileNode REF_IN weights, int max_batch);
+
+  /**
+   * @brief 对一帧中的全部候选分类
+   * @param [in] image 灰度或三通道 BGR 图像，原始 Bayer 图像须先解马赛克
+   * @param [in,out] candidates 候选列表，写入 id 和 confidence
+   */
+  void Classify(cv::Mat REF_IN image, std::vector<Candidate> REF_OUT candidates);
+
+ private:
+  /**
+   * @brief 提取候选的归一化图案，写入批次中的一行
+   * @param [in] image 源图像
+   * @param [in] candidate 候选
+   * @param [out] row 批次中的一行
+   */
+  void ExtractPatch(cv::Mat REF_IN image, Candidate REF_IN candidate, cv::Mat REF_OUT row);
+
+  /**
+   * @brief 对批次执行推理
+   * @param [in] batch 输入批次，每行一个候选
+   * @param [out] candidates 对应的候选，写入 id 和 confidence
+   */
+  void Infer(cv::Mat REF_IN batch, Candidate *candidates);
+
+  std::vector<std::string> classes_;  ///< 类别名称
+  cv::Size patch_size_;               ///< 输入图案尺寸
+  int max_batch_{};                   ///< 单次推理的最大候选数
+  cv::Mat fc1_weights_;               ///< 第一层权重，hidden x input
+  cv::Mat fc1_bias_;                  ///< 第一层偏置，按最大批次逐行复制，max_batch x hidden
+  cv::Mat fc2_weights_;               ///< 第二层权重，classes x hidden
+  cv::Mat fc2_bias_;                  ///< 第二层偏置，按最大批次逐行复制，max_batch x classes
+  cv::Mat warp_[2];                   ///< 透视变换结果缓存，分别对应小装甲板和大装甲板宽度
+  cv::Mat gray_;                      ///< 灰度转换缓存
+  cv::Mat patch_;                     ///< 二值化图案缓存
+  cv::Mat batch_;                     ///< 输入批次缓存，max_batch x input
+  cv::Mat hidden_;                    ///< 隐藏层缓存，max_batch x hidden
+  cv::Mat output_;                    ///< 输出层缓存，max_batch x classes
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_CLASSIFIER_CLASSIFIER_H_
@@ -3,8 +3,19 @@
 
 DEFINE_string(controller_type, "hero", "controller type");
 DEFINE_string(video_source_type, "file", "video source type");
+DEFINE_string(pacing, "", "offline video pacing, realtime, max or step, use video source configuration when empty");
+DEFINE_double(seek, 0, "start offline video at this time in seconds");
+DEFINE_int64(seek_frame, -1, "start offline video at this frame index, overrides --seek when not negative");
+DEFINE_string(benchmark_type, "", "benchmark type, run benchmark instead of controller when set");
 DEFINE_bool(record, false, "record ui to video in cache directory");
+DEFINE_bool(record_raw, false, "record raw frames with time stamps and serial data in cache directory for replay");
+DEFINE_bool(record_lz4, false, "compress raw recording with lz4, requires --record_raw");
+DEFINE_bool(telemetry, false, "log serial packets and solver results to binary telemetry in cache directory");
+DEFINE_string(decode_telemetry, "", "telemetry segment file, decode it to <file>.csv instead of running controller");
 DEFINE_bool(serial, false, "open serial control");
+DEFINE_string(serial_port, "", "serial device path, search for /dev/ttyACM* when empty");
+DEFINE_bool(simulate_gimbal, false, "connect serial to a simulated gimbal MCU instead of a device, requires --serial");
+DEFINE_bool(soak, false, "sample memory, files, threads and stage latency periodically and warn on upward drifts");
 DEFINE_bool(ui, true, "with opencv ui window");
 
 cli::CliArgParser &cli_argv = cli::CliArgParser::Instance();
@@ -24,8 +35,19 @@ void cli::CliArgParser::Parse(int argc, char **argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   controller_type_ = FLAGS_controller_type;
   video_source_type_ = FLAGS_video_source_type;
+  pacing_ = FLAGS_pacing;
+  seek_ = FLAGS_seek;
+  seek_frame_ = FLAGS_seek_frame;
+  benchmark_type_ = FLAGS_benchmark_type;
   std::ostringstream cli_flags;
   record_ = FLAGS_record;
+  record_raw_ = FLAGS_record_raw;
+  record_lz4_ = FLAGS_record_lz4;
+  telemetry_ = FLAGS_telemetry;
+  decode_telemetry_ = FLAGS_decode_telemetry;
   serial_ = FLAGS_serial;
+  serial_port_ = FLAGS_serial_port;
+  simulate_gimbal_ = FLAGS_simulate_gimbal;
+  soak_ = FLAGS_soak;
   ui_ = FLAGS_ui;
 }
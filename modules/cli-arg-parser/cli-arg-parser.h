@@ -17,10 +17,32 @@ class CliArgParser final {
   attr_reader_ref(controller_type_, ControllerType)
   /// 视频源类型
   attr_reader_ref(video_source_type_, VideoSourceType)
+  /// 离线视频源的帧释放节奏，为空时使用视频源配置
+  attr_reader_ref(pacing_, Pacing)
+  /// 离线视频源的起始时刻，单位 s
+  attr_reader_val(seek_, Seek)
+  /// 离线视频源的起始帧，为负时使用起始时刻
+  attr_reader_val(seek_frame_, SeekFrame)
+  /// 基准测试类型，非空时只运行基准测试
+  attr_reader_ref(benchmark_type_, BenchmarkType)
   /// 是否开启视频录制
   attr_reader_val(record_, Record)
+  /// 是否录制原始帧
+  attr_reader_val(record_raw_, RecordRaw)
+  /// 是否以 LZ4 压缩原始录像
+  attr_reader_val(record_lz4_, RecordLZ4)
+  /// 是否记录遥测日志
+  attr_reader_val(telemetry_, Telemetry)
+  /// 待解码的遥测分段文件，非空时只解码为 CSV
+  attr_reader_ref(decode_telemetry_, DecodeTelemetry)
   /// 是否开启串口通信
   attr_reader_val(serial_, Serial)
+  /// 串口设备路径，为空时自动查找
+  attr_reader_ref(serial_port_, SerialPort)
+  /// 是否以云台下位机模拟器代替串口设备
+  attr_reader_val(simulate_gimbal_, SimulateGimbal)
+  /// 是否监视长时间运行中的资源占用与处理耗时
+  attr_reader_val(soak_, Soak)
   /// 是否显示界面
   attr_reader_val(ui_, UI)
 
@@ -38,8 +60,19 @@ class CliArgParser final {
 
   std::string controller_type_;    ///< 机器人类型
   std::string video_source_type_;  ///< 视频源类型
+  std::string pacing_;             ///< 离线视频源的帧释放节奏
+  double seek_{};                  ///< 离线视频源的起始时刻
+  int64_t seek_frame_{};           ///< 离线视频源的起始帧
+  std::string benchmark_type_;     ///< 基准测试类型
   bool record_{};                  ///< 是否开启视频录制
+  bool record_raw_{};              ///< 是否录制原始帧
+  bool record_lz4_{};              ///< 是否以 LZ4 压缩原始录像
+  bool telemetry_{};               ///< 是否记录遥测日志
+  std::string decode_telemetry_;   ///< 待解码的遥测分段文件
   bool serial_{};                  ///< 是否开启串口通信
+  std::string serial_port_;        ///< 串口设备路径
+  bool simulate_gimbal_{};         ///< 是否以云台下位机模拟器代替串口设备
+  bool soak_{};                    ///< 是否监视长时间运行中的资源占用与处理耗时
   bool ui_{};                      ///< 是否显示界面
 };
 }
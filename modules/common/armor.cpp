@@ -4,7 +4,8 @@
 Armor::Armor(std::array<cv::Point2f, 4> REF_IN vertexes,
              coordinate::CoordSolver REF_IN coord_solver,
              coordinate::EAngle REF_IN euler_angle,
-             ArmorSize size) : size_(size) {
+             ArmorSize size,
+             int id) : size_(size), id_(id) {
   for (auto i = 0; i < 4; ++i) vertexes_[i] = vertexes[i];
   std::array<coordinate::Point3D, 4> p3d_world;
   switch (size_) {
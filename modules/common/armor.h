@@ -16,11 +16,13 @@ class Armor final {
    * @param [in] coord_solver 坐标系求解方式
    * @param [in] euler_angle 当前云台姿态欧拉角
    * @param size 装甲板类型
+   * @param id 装甲板编号，0 表示未分类
    */
   Armor(std::array<cv::Point2f, 4> REF_IN vertexes,
         coordinate::CoordSolver REF_IN coord_solver,
         coordinate::EAngle REF_IN euler_angle,
-        ArmorSize size);
+        ArmorSize size,
+        int id = 0);
 
   /// 图像上的四个角点
   attr_reader_ref(vertexes_, Vertexes)
@@ -38,12 +40,15 @@ class Armor final {
   attr_reader_ref(pnp_info_.ea_cam, EAngleCam)
   /// 装甲板类型
   attr_reader_val(size_, Size)
+  /// 装甲板编号，0 表示未分类
+  attr_reader_val(id_, ID)
 
  private:
   std::array<cv::Point2f, 4> vertexes_;  ///< 图像上的四个角点
   coordinate::PnPInfo pnp_info_;        ///< PnP 求解信息，记录当前装甲板的相机坐标和世界坐标
   cv::Point2f center_;                  ///< 装甲板中心在图像上的位置
   ArmorSize size_;                      ///< 装甲板类型
+  int id_;                              ///< 装甲板编号，0 表示未分类
 };
 
 #endif  // SRM_IC_2023_MODULES_COMMON_ARMOR_H_
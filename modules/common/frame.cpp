@@ -0,0 +1,71 @@
+#include <chrono>
+#include <opencv2/imgproc.hpp>
+#include "frame.h"
+
+uint64_t Frame::HostTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+cv::Mat &Frame::Image() {
+  if (image.empty() && !bayer.empty()) {
+    image.create(bayer.size(), CV_8UC3);
+    simd::demosaic_8u(bayer.data, bayer.cols, bayer.rows, bayer.step,
+                      image.data, image.step, bayer_pattern, simd::DemosaicFormat::BGR);
+  }
+  return image;
+}
+
+cv::Size Frame::Size() const {
+  return bayer.empty() ? image.size() : bayer.size();
+}
+
+BayerPlane Frame::Plane(BayerChannel channel) const {
+  if (bayer.empty()) return {nullptr, 0, 0, 0};
+  // 红色像素在 2x2 单元中的位置，蓝色像素与其对角，G1 与其同行，G2 与其同列
+  int row = bayer_pattern == simd::BayerPattern::GB || bayer_pattern == simd::BayerPattern::BG,
+      col = bayer_pattern == simd::BayerPattern::GR || bayer_pattern == simd::BayerPattern::BG;
+  switch (channel) {
+    case BayerChannel::R: break;
+    case BayerChannel::G1: col = 1 - col;
+      break;
+    case BayerChannel::G2: row = 1 - row;
+      break;
+    case BayerChannel::B: row = 1 - row;
+      col = 1 - col;
+      break;
+  }
+  return {bayer.ptr<uchar>(row) + col, bayer.rows / 2, bayer.cols / 2, 2 * bayer.step};
+}
+
+const cv::Mat &Frame::Level(int level) const {
+  static const cv::Mat empty;
+  if (level < 1 || level > kPyramidLevels) return empty;
+  auto &&cache = pyramid_[level - 1];
+  if (!cache.empty()) return cache;
+  auto size = Size();
+  if (size.width >> level == 0 || size.height >> level == 0) return empty;
+  // Bayer 帧始终由原始图像合成第 1 层，结果与是否已解马赛克无关
+  if (level == 1 && !bayer.empty()) {
+    cache.create(size.height / 2, size.width / 2, CV_8UC3);
+    if (!simd::demosaic_8u(bayer.data, bayer.cols & ~1, bayer.rows & ~1, bayer.step,
+                           cache.data, cache.step, bayer_pattern, simd::DemosaicFormat::HALF_BGR))
+      cache.release();
+    return cache;
+  }
+  auto &&source = level == 1 ? image : Level(level - 1);
+  if (source.empty()) return empty;
+  cv::resize(source, cache, {size.width >> level, size.height >> level}, 0, 0, cv::INTER_AREA);
+  return cache;
+}
+
+cv::Mat Frame::Crop(cv::Rect REF_IN roi, cv::Mat REF_OUT buffer) const {
+  if (roi.empty() || (roi & cv::Rect({0, 0}, Size())) != roi) return {};
+  if (!image.empty()) return image(roi);
+  if (roi.x % 2 || roi.y % 2) return {};
+  buffer.create(roi.size(), CV_8UC3);
+  if (!simd::demosaic_8u(bayer.ptr<uchar>(roi.y) + roi.x, roi.width, roi.height, bayer.step,
+                         buffer.data, buffer.step, bayer_pattern, simd::DemosaicFormat::BGR))
+    return {};
+  return buffer;
+}
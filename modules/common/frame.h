@@ -1,14 +1,95 @@
 #ifndef SRM_IC_2023_MODULES_COMMON_FRAME_H_
 #define SRM_IC_2023_MODULES_COMMON_FRAME_H_
 
+#include <array>
 #include <opencv2/core/mat.hpp>
+#include "simd/simd.h"
 #include "packet.h"
 
-/// 帧信息结构体
+/// Bayer 阵列中的颜色通道，G1 与 R 同行，G2 与 B 同行
+enum class BayerChannel { R, G1, G2, B };
+
+/// Bayer 单色平面视图，与原始 Bayer 图像共享内存，尺寸为原始图像的一半
+struct BayerPlane {
+  const uchar *data;  ///< 平面左上角像素地址
+  int rows;           ///< 平面行数
+  int cols;           ///< 平面列数
+  size_t step;        ///< 平面行字节数，为原始图像行字节数的两倍，同一行相邻像素相距 2 字节
+
+  /**
+   * @brief 读取平面中的像素
+   * @param row 平面行坐标
+   * @param col 平面列坐标
+   * @return 像素值
+   */
+  uchar operator()(int row, int col) const { return data[row * step + 2 * col]; }
+};
+
+/**
+ * @brief 帧信息结构体
+ * @details 相机输出 Bayer 图像时只保存原始图像，彩色图像在首次调用 Image() 时才解马赛克，
+ *   无界面、不录制时整个处理流程不会产生全分辨率彩色图像；
+ *   降采样的金字塔图层同样在首次请求时计算并缓存在帧内，全分辨率局部图像由 Crop() 按需生成
+ * @warning 图像数据被替换时须整体重新赋值帧对象，以清空金字塔缓存
+ */
 struct Frame {
-  cv::Mat image;                 ///< 获取的图像
-  ReceivePacket receive_packet;  ///< 串口接收的信息
-  uint64_t time_stamp;           ///< 时间戳，单位 ns
+  static constexpr int kPyramidLevels = 4;  ///< 金字塔缓存的最高层级
+
+  cv::Mat image;                       ///< 彩色图像 (BGR)，Bayer 帧在首次调用 Image() 前为空
+  cv::Mat bayer;                       ///< 原始 8 位 Bayer 图像，非 Bayer 帧为空
+  simd::BayerPattern bayer_pattern{};  ///< 原始图像的 Bayer 阵列排列
+  ReceivePacket receive_packet{};      ///< 串口接收的信息
+  uint64_t time_stamp{};               ///< 时间戳，单位 ns
+  uint64_t receive_time{};             ///< 主机收到帧的时间，取自 HostTime()，单位 ns
+
+  /**
+   * @brief 获取主机单调时钟的当前时间
+   * @details 相机时间戳取自设备时钟，无法与主机上的事件比较；主机侧的延迟统一以此时钟测量
+   * @return 当前时间，单位 ns
+   */
+  static uint64_t HostTime();
+
+  /**
+   * @brief 获取彩色图像，Bayer 帧在首次调用时解马赛克
+   * @return 彩色图像的引用
+   */
+  cv::Mat &Image();
+
+  /**
+   * @brief 获取图像尺寸，不触发解马赛克
+   * @return 图像尺寸
+   */
+  cv::Size Size() const;
+
+  /**
+   * @brief 获取 Bayer 单色平面视图，不复制数据
+   * @param channel 颜色通道
+   * @return 平面视图，非 Bayer 帧返回空视图
+   */
+  BayerPlane Plane(BayerChannel channel) const;
+
+  /**
+   * @brief 获取金字塔图层，每层在每帧内至多计算一次
+   * @details Bayer 帧的第 1 层将每个 2x2 单元合并为一个像素，不经过全分辨率解马赛克；
+   *   彩色帧的第 1 层和所有帧的更高层由上一层按 2x2 区域平均降采样得到
+   * @param level 层级，取值 [1, kPyramidLevels]，第 level 层的长宽为原图的 1 / 2^level（向下取整）
+   * @return BGR 图像的引用，原图过小时为空
+   * @note 首次请求时写入缓存，多线程读取前须先在单线程中请求一次
+   */
+  const cv::Mat &Level(int level) const;
+
+  /**
+   * @brief 获取全分辨率彩色图像的一块区域
+   * @details 已有彩色图像时返回其子图，不复制数据；Bayer 帧只将该区域解马赛克到调用者的缓冲区，不影响 Image() 的结果，
+   *   区域边界处按区域内像素插值
+   * @param [in] roi 区域，Bayer 帧须按 2 像素对齐且长宽为不小于 4 的偶数
+   * @param [out] buffer Bayer 帧的解马赛克缓冲区，尺寸不变时重复使用
+   * @return BGR 图像，区域不合法时为空
+   */
+  cv::Mat Crop(cv::Rect REF_IN roi, cv::Mat REF_OUT buffer) const;
+
+ private:
+  mutable std::array<cv::Mat, kPyramidLevels> pyramid_;  ///< 金字塔图层缓存，下标 k 为第 k + 1 层
 };
 
 /// 帧回调函数类型
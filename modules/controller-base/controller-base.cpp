@@ -2,6 +2,11 @@
 #include "controller-base.h"
 #include "cli-arg-parser/cli-arg-parser.h"
 
+controller::Controller::~Controller() {
+  // 取图回调在相机线程中使用串口与录像，先停止视频源，再析构其余成员
+  video_source_.reset();
+}
+
 bool controller::Controller::Initialize(std::string REF_IN type_name) {
   video_source_.reset(video_source::CreateVideoSource(cli_argv.VideoSourceType()));
   if (!video_source_) {
@@ -13,37 +18,98 @@ bool controller::Controller::Initialize(std::string REF_IN type_name) {
     video_source_.reset();
     return false;
   }
+  if (!cli_argv.Pacing().empty()) {
+    video_source::Pacing pacing;
+    if (!video_source::ParsePacing(cli_argv.Pacing(), pacing) || !video_source_->SetPacing(pacing)) {
+      LOG(ERROR) << "Pacing " << cli_argv.Pacing() << " is not supported by " << cli_argv.VideoSourceType()
+                 << " video source.";
+      video_source_.reset();
+      return false;
+    }
+  }
+  if (video_source_->FramePacing() != video_source::Pacing::REAL_TIME)
+    LOG(WARNING) << "Frames are not released in real time. Latency statistics do not reflect a live camera.";
+  if (video_source_->FramePacing() == video_source::Pacing::STEP && !cli_argv.UI())
+    LOG(WARNING) << "Step pacing without UI releases frames without waiting for key presses.";
   if (!coord_solver_.Initialize("../config/" + type_name + "/coord-init.yaml",
                                 video_source_->IntrinsicMat(), video_source_->DistortionMat())) {
     LOG(ERROR) << "Failed to initialize coordinate solver.";
     video_source_.reset();
     return false;
   }
+  // 同一次运行的日志与录像文件使用相同的时间后缀
+  time_t t = time(nullptr);
+  char t_str[32];
+  strftime(t_str, sizeof(t_str), "%Y-%m-%d-%H.%M.%S", localtime(&t));
+  if (cli_argv.Telemetry()) {
+    if (!telemetry_.Open("../cache/" + type_name + "-" + t_str)) {
+      LOG(ERROR) << "Failed to open telemetry log.";
+      video_source_.reset();
+      return false;
+    }
+  }
+  if (cli_argv.Soak() && !soak_monitor_.Initialize("../config/" + type_name + "/soak-init.yaml")) {
+    LOG(ERROR) << "Failed to initialize soak monitor.";
+    video_source_.reset();
+    return false;
+  }
+  if (cli_argv.SimulateGimbal() && !cli_argv.Serial())
+    LOG(WARNING) << "Gimbal simulator is ignored without serial communication.";
   if (cli_argv.Serial()) {
+    auto serial_port = cli_argv.SerialPort();
+    if (cli_argv.SimulateGimbal()) {
+      gimbal_simulator_ = std::make_unique<gimbal_simulator::GimbalSimulator>();
+      if (!gimbal_simulator_->Initialize("../config/" + type_name + "/gimbal-init.yaml")
+          || !gimbal_simulator_->Start()) {
+        LOG(ERROR) << "Failed to start gimbal simulator.";
+        video_source_.reset();
+        gimbal_simulator_.reset();
+        return false;
+      }
+      serial_port = gimbal_simulator_->Port();
+    }
     serial_ = std::make_unique<serial::Serial>();
-    if (!serial_->Open()) {
+    serial_->SetTelemetry(&telemetry_);
+    serial::DeviceFilter device_filter;
+    if (!device_filter.Initialize("../config/" + type_name + "/serial-init.yaml")
+        || !serial_->Open(serial_port, device_filter)) {
       LOG(ERROR) << "Failed to open serial communication.";
       video_source_.reset();
       serial_->Close();
       return false;
     }
   }
+  // 录像须在注册回调之前打开，回调在相机线程中写入
+  if (cli_argv.RecordLZ4() && !cli_argv.RecordRaw())
+    LOG(WARNING) << "LZ4 compression is ignored without raw recording.";
+  if (cli_argv.RecordRaw())
+    raw_writer_.Open("../cache/" + type_name + "-" + t_str + ".srmraw", cli_argv.RecordLZ4());
   video_source_->RegisterFrameCallback(&FrameCallback, this);
   Frame frame;
   while (!video_source_->GetFrame(frame)) sleep(1);
-  if (cli_argv.Record()) {
-    time_t t = time(nullptr);
-    char t_str[32];
-    strftime(t_str, sizeof(t_str), "%Y-%m-%d-%H.%M.%S", localtime(&t));
-    std::string video_file = "../cache/" + type_name + "-" + t_str + ".mp4";
-    video_writer_.Open("../cache/" + type_name + "-" + t_str + ".mp4", {frame.image.cols, frame.image.rows});
+  // 取得第一帧以确定图像尺寸之后再跳转，主循环取到的第一帧即为跳转的目标帧
+  if (cli_argv.SeekFrame() >= 0 || cli_argv.Seek() > 0) {
+    bool seek_done = cli_argv.SeekFrame() >= 0
+                     ? video_source_->Seek(static_cast<size_t>(cli_argv.SeekFrame()))
+                     : video_source_->Seek(std::chrono::nanoseconds(static_cast<int64_t>(cli_argv.Seek() * 1e9)));
+    if (!seek_done) {
+      LOG(ERROR) << "Failed to seek " << cli_argv.VideoSourceType() << " video source.";
+      video_source_.reset();
+      if (serial_) serial_->Close();
+      gimbal_simulator_.reset();
+      return false;
+    }
   }
+  if (cli_argv.Record())
+    video_writer_.Open("../cache/" + type_name + "-" + t_str + ".mp4", frame.Size());
   LOG(INFO) << "Initialized base environment of " << type_name << " controller.";
   return true;
 }
 
 std::function<void(void *obj, Frame &)> controller::Controller::FrameCallback = [](void *obj, Frame &frame) {
   auto self = static_cast<Controller *>(obj);
-  if (self->serial_ && !self->serial_->ReadData(frame.receive_packet))
+  // 断开期间由串口监视线程重连，不逐帧报告
+  if (self->serial_ && !self->serial_->ReadData(frame.receive_packet) && self->serial_->Connected())
     LOG(WARNING) << "Failed to read data from serial port in frame callback function.";
+  self->raw_writer_.Write(frame);
 };
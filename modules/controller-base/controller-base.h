@@ -2,6 +2,10 @@
 #define SRM_IC_2023_MODULES_CONTROLLER_BASE_CONTROLLER_BASE_H_
 
 #include "serial/serial.h"
+#include "gimbal-simulator/gimbal-simulator.h"
+#include "telemetry/telemetry.h"
+#include "raw-recording/raw-recording.h"
+#include "soak-monitor/soak-monitor.h"
 #include "video-source-base/video-source-base.h"
 #include "video-writer/video-writer.h"
 #include "coordinate/coordinate.h"
@@ -17,7 +21,7 @@ class Controller {
   friend void::SignalHandler(int);
  public:
   Controller() = default;
-  virtual ~Controller() = default;
+  virtual ~Controller();
 
   /**
    * @brief 初始化机器人
@@ -36,11 +40,15 @@ class Controller {
 
   static std::atomic_bool exit_signal_;  ///< 主循环退出信号
 
-  std::unique_ptr<video_source::VideoSource> video_source_;  ///< 视频源
-  std::unique_ptr<serial::Serial> serial_;                   ///< 串口
-  coordinate::CoordSolver coord_solver_;                     ///< 坐标求解器
-  Frame frame_;                                              ///< 帧数据
-  video_writer::VideoWriter video_writer_;                   ///< 视频写入接口
+  std::unique_ptr<video_source::VideoSource> video_source_;              ///< 视频源
+  telemetry::TelemetryLog telemetry_;                                    ///< 遥测日志，须在串口之后析构
+  std::unique_ptr<gimbal_simulator::GimbalSimulator> gimbal_simulator_;  ///< 云台下位机模拟器，须在串口之后析构
+  std::unique_ptr<serial::Serial> serial_;                               ///< 串口
+  coordinate::CoordSolver coord_solver_;                                 ///< 坐标求解器
+  Frame frame_;                                                          ///< 帧数据
+  video_writer::VideoWriter video_writer_;                               ///< 视频写入接口
+  raw_recording::RawWriter raw_writer_;                                  ///< 原始录像写入接口
+  soak_monitor::SoakMonitor soak_monitor_;                               ///< 长时间运行监视器
 
  private:
   static std::function<void(void *, Frame &)> FrameCallback;  ///< 取图回调函数
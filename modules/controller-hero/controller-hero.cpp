@@ -8,9 +8,34 @@
 controller::Registry<controller::hero::HeroController> controller::hero::HeroController::registry_("hero");
 
 bool controller::hero::HeroController::Initialize() {
-  bool ret = controller::Controller::Initialize("hero");
-  if (ret) LOG(INFO) << "Initialized hero controller.";
-  return ret;
+  if (!controller::Controller::Initialize("hero")) return false;
+  detector_.reset(detector::CreateDetector("armor"));
+  if (!detector_) {
+    LOG(ERROR) << "Failed to create armor detector.";
+    return false;
+  }
+  if (!detector_->Initialize("../config/hero/detector-init.yaml")) {
+    LOG(ERROR) << "Failed to initialize armor detector.";
+    detector_.reset();
+    return false;
+  }
+  if (!associator_.Initialize("../config/hero/association-init.yaml")) {
+    LOG(ERROR) << "Failed to initialize multi-target associator.";
+    detector_.reset();
+    return false;
+  }
+  if (!outpost_predictor_.Initialize("../config/hero/outpost-init.yaml")) {
+    LOG(ERROR) << "Failed to initialize outpost predictor.";
+    detector_.reset();
+    return false;
+  }
+  if (!compensator_.Initialize("../config/hero/latency-init.yaml")) {
+    LOG(ERROR) << "Failed to initialize latency compensator.";
+    detector_.reset();
+    return false;
+  }
+  LOG(INFO) << "Initialized hero controller.";
+  return true;
 }
 
 int controller::hero::HeroController::Run() {
@@ -64,19 +89,19 @@ int controller::hero::HeroController::Run() {
     ss_fps << std::fixed << std::setprecision(0) << show_fps;
     if (!pause && show_warning) {
       if (cli_argv.Record()) {
-        cv::Mat image = frame_.image.clone();
+        cv::Mat image = frame_.Image().clone();
         video_writer_.Write(std::move(image));
         ++rec_frame_count;
       }
       if (cli_argv.UI()) {
-        cv::putText(frame_.image, frame_time_str(frame_.time_stamp),
+        cv::putText(frame_.Image(), frame_time_str(frame_.time_stamp),
                     cv::Point(0, 24), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 192, 0));
-        cv::putText(frame_.image, "FPS: " + ss_fps.str(),
+        cv::putText(frame_.Image(), "FPS: " + ss_fps.str(),
                     cv::Point(0, 48), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 192, 0));
         if (cli_argv.Record())
-          cv::putText(frame_.image, "REC: " + std::to_string(rec_frame_count), cv::Point(0, 72),
+          cv::putText(frame_.Image(), "REC: " + std::to_string(rec_frame_count), cv::Point(0, 72),
                       cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 0, 192));
-        cv::imshow(title, frame_.image);
+        cv::imshow(title, frame_.Image());
       }
     }
   };
@@ -95,7 +120,9 @@ int controller::hero::HeroController::Run() {
 
   auto check_key = [&]() {
     if (cli_argv.UI()) {
-      auto key = cv::waitKey(1);
+      // 逐帧调试时等待按键后再取下一帧
+      auto step = video_source_->FramePacing() == video_source::Pacing::STEP && !pause;
+      auto key = cv::waitKey(step ? 0 : 1);
       if (key == 'q') {
         LOG(INFO) << "CONTROL MSG: QUIT";
         exit_signal_ = true;
@@ -116,73 +143,135 @@ int controller::hero::HeroController::Run() {
     }
   });
 
-  auto fix_aim_point = [&](Armor REF_IN armor, ballistic_solver::CVec REF_IN intrinsic_v)
-      -> ballistic_solver::CVec {
+  auto fix_aim_point = [&](coordinate::CTVec REF_IN target, ballistic_solver::CVec REF_IN intrinsic_v,
+                           double REF_OUT flight_time) -> ballistic_solver::CVec {
     ballistic_solver::BallisticInfo solution;
     double error;
-    if (ballistic_solver.Solve(armor.CTVecWorld(), frame_.receive_packet.bullet_speed, intrinsic_v, solution, error)) {
+    flight_time = 0;
+    if (ballistic_solver.Solve(target, frame_.receive_packet.bullet_speed, intrinsic_v, solution, error)) {
+      flight_time = solution.t;
       auto target_pic = coord_solver_.CamToPic(coord_solver_.WorldToCam(
           solution.x, coordinate::CoordSolver::EAngleToRMat(current_attitude)));
-      cv::circle(frame_.image, target_pic, 2, cv::Scalar(192, 0, 192), 2);
       auto v_0_pic = coord_solver_.CamToPic(coord_solver_.WorldToCam(
           coordinate::CoordSolver::STVecToCTVec(solution.v_0),
           coordinate::CoordSolver::EAngleToRMat(current_attitude)));
-      cv::circle(frame_.image, v_0_pic, 2, cv::Scalar(0, 0, 192), 2);
+      if (cli_argv.UI()) {
+        cv::circle(frame_.Image(), target_pic, 2, cv::Scalar(192, 0, 192), 2);
+        cv::circle(frame_.Image(), v_0_pic, 2, cv::Scalar(0, 0, 192), 2);
+      }
       return solution.v_0;
     } else return {0, 0, 0};
   };
 
   auto draw_armor = [&](Armor REF_IN armor) {
     for (size_t i = 0; i < 4; ++i)
-      cv::line(frame_.image, armor.Vertexes()[i], armor.Vertexes()[(i + 1) % 4], cv::Scalar(0, 192, 0), 2);
-    cv::circle(frame_.image, coord_solver_.CamToPic(armor.CTVecCam()), 2, cv::Scalar(0, 192, 0), 2);
+      cv::line(frame_.Image(), armor.Vertexes()[i], armor.Vertexes()[(i + 1) % 4], cv::Scalar(0, 192, 0), 2);
+    cv::circle(frame_.Image(), coord_solver_.CamToPic(armor.CTVecCam()), 2, cv::Scalar(0, 192, 0), 2);
+    if (armor.ID())
+      cv::putText(frame_.Image(), std::to_string(armor.ID()), armor.Vertexes()[1],
+                  cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 192, 0));
   };
 
+  // 回放与图片序列带有录制时的串口信息，只在没有弹速时填入默认值
   std::function<void(void *, Frame &)> patch_default_bullet_speed = [](void *, Frame &frame) -> void {
-    frame.receive_packet.bullet_speed = 14;
+    if (frame.receive_packet.bullet_speed <= 0) frame.receive_packet.bullet_speed = 14;
   };
   if (!cli_argv.Serial())
     video_source_->RegisterFrameCallback(&patch_default_bullet_speed, this);
 
-  cv::Point2f armor_center{45, 40};
-  cv::MouseCallback on_mouse = [](int event, int x, int y, int flags, void *userdata) -> void {
-    static bool armor_locked = false;
-    switch (event) {
-      case cv::EVENT_MOUSEMOVE:
-        if (!armor_locked) {
-          auto center = (cv::Point2f *) userdata;
-          center->x = static_cast<float>(x);
-          center->y = static_cast<float>(y);
-        }
-        break;
-      case cv::EVENT_LBUTTONDOWN: armor_locked = true;
-        break;
-      case cv::EVENT_RBUTTONDOWN: armor_locked = false;
-        break;
-      default: break;
-    }
-  };
-
-  if (cli_argv.UI()) {
+  if (cli_argv.UI())
     cv::namedWindow("HERO");
-    cv::setMouseCallback("HERO", on_mouse, &armor_center);
-  }
 
+  std::vector<Armor> armors;
+  uint64_t last_time_stamp = 0, last_latency_log_time = Frame::HostTime();
+  double flight_time = 0;
+  uint64_t stage_start_time = 0;
+  // 记录一个处理阶段的耗时，并以当前时间作为下一阶段的开始
+  auto record_stage = [&](soak_monitor::Stage stage) {
+    auto host_time = Frame::HostTime();
+    soak_monitor_.Record(stage, host_time - stage_start_time);
+    stage_start_time = host_time;
+  };
   while (!exit_signal_) {
     start_count_fps();
-    update_frame_data();
-
-    if (cli_argv.UI() && !pause && show_warning) {
-      std::array<cv::Point2f, 4> armor_vertexes = {cv::Point2f{-45, -40}, {45, -40}, {45, 40}, {-45, 40}};
-      for (auto &&p : armor_vertexes) p += armor_center;
-      Armor armor{armor_vertexes, coord_solver_, current_attitude, Armor::ArmorSize::SMALL};
-      draw_armor(armor);
-      fix_aim_point(armor, {0, 0, 0});
+    stage_start_time = Frame::HostTime();
+    if (update_frame_data()) {
+      record_stage(soak_monitor::Stage::FRAME);
+      // 串口发送的是自身颜色，识别对方颜色的灯条
+      auto enemy_color = frame_.receive_packet.color == 0 ? simd::LightColor::BLUE : simd::LightColor::RED;
+      compensator_.UpdateAttitude(current_attitude, frame_.time_stamp);
+      detector_->Detect(frame_, enemy_color, coord_solver_, current_attitude, armors);
+      record_stage(soak_monitor::Stage::DETECT);
+      associator_.Update(armors, frame_.time_stamp, coord_solver_, current_attitude);
+      record_stage(soak_monitor::Stage::ASSOCIATE);
+      // 以锁定目标所属轨迹滤波后的位置瞄准，并把下一帧的预测位置交给识别器放置 ROI
+      auto target_track = armors.empty() ? nullptr : associator_.Find(associator_.DetectionTrackIDs().front());
+      if (target_track) {
+        auto &&tracker = target_track->tracker;
+        // 指令在处理、传输延迟后生效，弹丸再经飞行时间命中；飞行时间取上一帧的弹道解，逐帧收敛
+        auto fire_time_stamp = frame_.time_stamp + static_cast<uint64_t>(compensator_.CommandDelay() * 1e9);
+        auto hit_time_stamp = frame_.time_stamp + static_cast<uint64_t>(compensator_.LeadTime(flight_time) * 1e9);
+        SendPacket send_packet{};
+        ballistic_solver::CVec v_0;
+        coordinate::CTVec target;
+        outpost_predictor::FireWindow fire_window;
+        // 前哨站模式下瞄准正对射手的位置，指令生效时处于开火窗口内才开火
+        if (frame_.receive_packet.armor_kind)
+          outpost_predictor_.Update(armors.front(), coord_solver_, current_attitude, frame_.time_stamp);
+        if (frame_.receive_packet.armor_kind && outpost_predictor_.Predict(fire_time_stamp, flight_time, fire_window)) {
+          target = fire_window.ctv_aim;
+          v_0 = fix_aim_point(target, {0, 0, 0}, flight_time);
+          send_packet.fire = fire_window.begin == fire_time_stamp;
+          if (cli_argv.UI() && send_packet.fire)
+            cv::putText(frame_.Image(), "FIRE", cv::Point(0, 96), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 0, 192));
+        } else {
+          target = tracker.Position(hit_time_stamp);
+          v_0 = fix_aim_point(target, {0, 0, 0}, flight_time);
+        }
+        send_packet.yaw = static_cast<float>(v_0.x());
+        send_packet.pitch = static_cast<float>(v_0.y());
+        // 弹道无解时 v_0 为 0，不发送指令；开火指令作为一次性消息发送，不会被下一帧的指令覆盖
+        if (flight_time > 0 && serial_
+            && !(send_packet.fire ? serial_->WriteMessage(send_packet, 1) : serial_->WriteData(send_packet)))
+          LOG(WARNING) << "Failed to write data to serial port.";
+        telemetry_.Log(telemetry::SolverRecord{
+            frame_.time_stamp,
+            {static_cast<float>(target.x()), static_cast<float>(target.y()), static_cast<float>(target.z())},
+            send_packet.yaw, send_packet.pitch, static_cast<float>(flight_time),
+            static_cast<float>(compensator_.CommandDelay()), target_track->id, send_packet.fire});
+        compensator_.RecordLatency(frame_.receive_time, Frame::HostTime());
+        // 下一帧曝光时云台已按当前角速度转动，以外推的姿态投影目标
+        auto next_time_stamp = frame_.time_stamp + (frame_.time_stamp - std::min(last_time_stamp, frame_.time_stamp));
+        auto next_attitude = compensator_.PredictAttitude(
+            current_attitude, static_cast<double>(next_time_stamp - frame_.time_stamp) * 1e-9);
+        detector_->Predict(coord_solver_.CamToPic(coord_solver_.WorldToCam(
+            tracker.Position(next_time_stamp), coordinate::CoordSolver::EAngleToRMat(next_attitude))));
+        record_stage(soak_monitor::Stage::AIM);
+      }
+      soak_monitor_.Record(soak_monitor::Stage::TOTAL, Frame::HostTime() - frame_.receive_time);
+      last_time_stamp = frame_.time_stamp;
+      if (cli_argv.UI()) {
+        cv::rectangle(frame_.Image(), detector_->ROI(), cv::Scalar(192, 192, 0), 1);
+        for (auto &&armor : armors) draw_armor(armor);
+      }
+    }
+    if (compensator_.Samples() && Frame::HostTime() - last_latency_log_time > 1000000000) {
+      last_latency_log_time = Frame::HostTime();
+      LOG(INFO) << std::fixed << std::setprecision(2) << "Latency: " << compensator_.Latency() * 1e3 << " ms, P50 "
+                << compensator_.Percentile(50) * 1e3 << " ms, P90 " << compensator_.Percentile(90) * 1e3
+                << " ms, P99 " << compensator_.Percentile(99) * 1e3 << " ms.";
+      if (serial_) {
+        auto transmit_stats = serial_->Stats();
+        LOG(INFO) << std::fixed << std::setprecision(2) << "Serial queueing delay: "
+                  << transmit_stats.mean_delay * 1e3 << " ms, max " << transmit_stats.max_delay * 1e3 << " ms, "
+                  << transmit_stats.coalesced << " coalesced, " << transmit_stats.failed << " failed.";
+      }
     }
 
     update_window("HERO");
     stop_count_fps();
     check_key();
+    soak_monitor_.Update();
   }
 
   if (!cli_argv.Serial())
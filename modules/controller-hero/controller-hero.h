@@ -2,6 +2,10 @@
 #define SRM_IC_2023_MODULES_CONTROLLER_HERO_CONTROLLER_HERO_H_
 
 #include "controller-base/controller-base.h"
+#include "detector-base/detector-base.h"
+#include "association/association.h"
+#include "outpost-predictor/outpost-predictor.h"
+#include "latency-compensator/latency-compensator.h"
 
 namespace controller::hero {
 /**
@@ -15,6 +19,11 @@ class HeroController final : public Controller {
 
  private:
   static Registry<HeroController> registry_;  ///< 主控注册信息
+
+  std::unique_ptr<detector::Detector> detector_;           ///< 装甲板识别器
+  association::Associator associator_;                     ///< 多目标数据关联器
+  outpost_predictor::OutpostPredictor outpost_predictor_;  ///< 前哨站预测器
+  latency_compensator::LatencyCompensator compensator_;    ///< 瞄准延迟补偿器
 };
 }
 
@@ -4,7 +4,8 @@
 #include <opencv2/core/eigen.hpp>
 #include "coordinate.h"
 
-#define USE_SIMD  ///< 使用 SIMD 加速数学计算，取消定义则使用标准数学计算
+#define USE_SIMD         ///< 使用 SIMD 加速数学计算，取消定义则使用标准数学计算
+#define USE_SIMD_DOUBLE  ///< 使用双精度 SIMD 计算，取消定义则使用单精度 SIMD 计算，仅在定义 USE_SIMD 时生效
 
 #ifdef USE_SIMD
 #include "simd/simd.h"
@@ -13,8 +14,24 @@
 coordinate::EAngle coordinate::CoordSolver::RMatToEAngle(RMat REF_IN rm) {
   constexpr double y_cos_threshold = 1e-6;
   double x, y, z;
-#ifdef USE_SIMD
-  auto y_cos = static_cast<double>(simd::sqrt_f(static_cast<float>(rm(0, 0) * rm(0, 0) + rm(1, 0) * rm(1, 0))));
+#if defined(USE_SIMD) && defined(USE_SIMD_DOUBLE)
+  // 开方使用标准库，编译为单条指令，比调用 simd:: 中的函数更快
+  double y_cos = sqrt(rm(0, 0) * rm(0, 0) + rm(1, 0) * rm(1, 0));
+  double atan2_y[4] = {-rm(1, 2), -rm(2, 0), rm(2, 1), rm(1, 0)},
+      atan2_x[4] = {rm(1, 1), y_cos, rm(2, 2), rm(0, 0)},
+      atan2_result[4];
+  simd::atan2_4d(atan2_y, atan2_x, atan2_result);
+  if (y_cos < y_cos_threshold) {
+    x = atan2_result[0];
+    y = atan2_result[1];
+    z = 0;
+  } else {
+    x = atan2_result[2];
+    y = atan2_result[1];
+    z = atan2_result[3];
+  }
+#elif defined(USE_SIMD)
+  auto y_cos = static_cast<double>(sqrtf(static_cast<float>(rm(0, 0) * rm(0, 0) + rm(1, 0) * rm(1, 0))));
   float atan2_y[4] = {-static_cast<float>(rm(1, 2)), -static_cast<float>(rm(2, 0)),
                       static_cast<float>(rm(2, 1)), static_cast<float>(rm(1, 0))},
       atan2_x[4] = {static_cast<float>(rm(1, 1)), static_cast<float>(y_cos),
@@ -47,7 +64,10 @@ coordinate::EAngle coordinate::CoordSolver::RMatToEAngle(RMat REF_IN rm) {
 
 coordinate::RMat coordinate::CoordSolver::EAngleToRMat(EAngle REF_IN ea) {
   RMat rm_z, rm_y, rm_x;
-#ifdef USE_SIMD
+#if defined(USE_SIMD) && defined(USE_SIMD_DOUBLE)
+  double ea_d[4] = {ea[0], ea[1], ea[2], 0}, ea_sin[4], ea_cos[4];
+  simd::sin_cos_4d(ea_d, ea_sin, ea_cos);
+#elif defined(USE_SIMD)
   float ea_f[4] = {static_cast<float>(ea[0]), static_cast<float>(ea[1]), static_cast<float>(ea[2]), 0},
       ea_sin_f[4], ea_cos_f[4];
   simd::sin_cos_4f(ea_f, ea_sin_f, ea_cos_f);
@@ -75,7 +95,13 @@ coordinate::RMat coordinate::CoordSolver::EAngleToRMat(EAngle REF_IN ea) {
 
 coordinate::CTVec coordinate::CoordSolver::STVecToCTVec(STVec REF_IN stv) {
   CTVec ctv;
-#ifdef USE_SIMD
+#if defined(USE_SIMD) && defined(USE_SIMD_DOUBLE)
+  double stv_sin_cos[2] = {stv.y(), stv.x()}, stv_sin[2], stv_cos[2];
+  simd::sin_cos_2d(stv_sin_cos, stv_sin, stv_cos);
+  ctv[0] = stv.z() * stv_cos[0] * stv_sin[1];
+  ctv[1] = -stv.z() * stv_sin[0];
+  ctv[2] = stv.z() * stv_cos[0] * stv_cos[1];
+#elif defined(USE_SIMD)
   float stv_sin_cos[4] = {static_cast<float>(stv.y()), static_cast<float>(stv.x()), 0, 0}, stv_sin[4], stv_cos[4];
   simd::sin_cos_4f(stv_sin_cos, stv_sin, stv_cos);
   auto y_cos = static_cast<double>(stv_cos[0]), y_sin = static_cast<double>(stv_sin[0]),
@@ -93,13 +119,20 @@ coordinate::CTVec coordinate::CoordSolver::STVecToCTVec(STVec REF_IN stv) {
 
 coordinate::STVec coordinate::CoordSolver::CTVecToSTVec(CTVec REF_IN ctv) {
   STVec stv;
-#ifdef USE_SIMD
+#if defined(USE_SIMD) && defined(USE_SIMD_DOUBLE)
+  double atan2_y[2] = {ctv.x(), -ctv.y()}, atan2_result[2],
+      atan2_x[2] = {ctv.z(), sqrt(ctv.x() * ctv.x() + ctv.z() * ctv.z())};
+  simd::atan2_2d(atan2_y, atan2_x, atan2_result);
+  stv[0] = atan2_result[0];
+  stv[1] = atan2_result[1];
+  stv[2] = sqrt(ctv.x() * ctv.x() + ctv.y() * ctv.y() + ctv.z() * ctv.z());
+#elif defined(USE_SIMD)
   float atan2_y[4] = {static_cast<float>(ctv.x()), static_cast<float>(-ctv.y()), 0, 0}, atan2_result[4], atan2_x[4] =
-      {static_cast<float>(ctv.z()), simd::sqrt_f(static_cast<float>(ctv.x() * ctv.x() + ctv.z() * ctv.z())), 0, 0};
+      {static_cast<float>(ctv.z()), sqrtf(static_cast<float>(ctv.x() * ctv.x() + ctv.z() * ctv.z())), 0, 0};
   simd::atan2_4f(atan2_y, atan2_x, atan2_result);
   stv[0] = static_cast<double>(atan2_result[0]);
   stv[1] = static_cast<double>(atan2_result[1]);
-  stv[2] = static_cast<double>(simd::sqrt_f(
+  stv[2] = static_cast<double>(sqrtf(
       static_cast<float>(ctv.x() * ctv.x() + ctv.y() * ctv.y() + ctv.z() * ctv.z())));
 #else
   stv[0] = atan2(ctv.x(), ctv.z());
@@ -0,0 +1,443 @@
+#include <numeric>
+#include <glog/logging.h>
+#include <opencv2/imgproc.hpp>
+#include "detector-armor.h"
+
+detector::Registry<detector::armor::ArmorDetector> detector::armor::ArmorDetector::registry_("armor");
+
+bool detector::armor::ArmorDetector::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage detector_init_config;
+  detector_init_config.open(config_file, cv::FileStorage::READ);
+  if (!detector_init_config.isOpened()) {
+    LOG(ERROR) << "Failed to open detector initialization file " << config_file << ".";
+    return false;
+  }
+  int color_threshold = 0;
+  std::vector<double> small_distance, big_distance, roi_scale;
+  detector_init_config["COLOR_THRESHOLD"] >> color_threshold;
+  detector_init_config["MIN_LIGHT_AREA"] >> min_light_area_;
+  detector_init_config["MIN_LIGHT_RATIO"] >> min_light_ratio_;
+  detector_init_config["MAX_LIGHT_RATIO"] >> max_light_ratio_;
+  detector_init_config["MAX_LIGHT_TILT"] >> max_light_tilt_;
+  detector_init_config["MIN_LENGTH_RATIO"] >> min_length_ratio_;
+  detector_init_config["MAX_ANGLE_DIFF"] >> max_angle_diff_;
+  detector_init_config["MAX_Y_OFFSET"] >> max_y_offset_;
+  detector_init_config["SMALL_ARMOR_DISTANCE"] >> small_distance;
+  detector_init_config["BIG_ARMOR_DISTANCE"] >> big_distance;
+  detector_init_config["ROI_SCALE"] >> roi_scale;
+  detector_init_config["FULL_SEARCH_INTERVAL"] >> full_search_interval_;
+  std::vector<double> zoom_region;
+  pyramid_level_ = -1;
+  detector_init_config["PYRAMID_LEVEL"] >> pyramid_level_;
+  detector_init_config["ZOOM_REGION"] >> zoom_region;
+  detector_init_config["ZOOM_MAX_HEIGHT"] >> zoom_max_height_;
+  int threads = -1;
+  detector_init_config["TILES"] >> tiles_;
+  detector_init_config["THREADS"] >> threads;
+  std::string classifier_weights;
+  int max_batch = 0;
+  detector_init_config["CLASSIFIER_WEIGHTS"] >> classifier_weights;
+  detector_init_config["MAX_BATCH"] >> max_batch;
+  detector_init_config["MIN_CONFIDENCE"] >> min_confidence_;
+  if (color_threshold <= 0 || color_threshold > 255) {
+    LOG(ERROR) << "Invalid color threshold " << color_threshold << ".";
+    return false;
+  }
+  if (small_distance.size() != 2 || big_distance.size() != 2) {
+    LOG(ERROR) << "Armor light bar distance configurations not found.";
+    return false;
+  }
+  if (roi_scale.size() != 2 || roi_scale[0] < 1 || roi_scale[1] < 1) {
+    LOG(ERROR) << "Invalid ROI scale configuration.";
+    return false;
+  }
+  if (full_search_interval_ <= 0) {
+    LOG(ERROR) << "Invalid full search interval " << full_search_interval_ << ".";
+    return false;
+  }
+  if (pyramid_level_ < 0 || pyramid_level_ > Frame::kPyramidLevels) {
+    LOG(ERROR) << "Invalid pyramid level " << pyramid_level_ << ". It must be in [0, " << Frame::kPyramidLevels << "].";
+    return false;
+  }
+  if (zoom_region.size() != 2 || zoom_region[0] < 0 || zoom_region[0] > 1 || zoom_region[1] < 0 || zoom_region[1] > 1
+      || zoom_max_height_ < 0) {
+    LOG(ERROR) << "Invalid digital zoom configuration.";
+    return false;
+  }
+  if (tiles_ <= 0 || threads < 0) {
+    LOG(ERROR) << "Invalid tile count " << tiles_ << " or thread count " << threads << ".";
+    return false;
+  }
+  if (classifier_weights.empty())
+    classifier_.reset();
+  else {
+    classifier_ = std::make_unique<classifier::Classifier>();
+    if (!classifier_->Initialize(classifier_weights, max_batch)) {
+      LOG(ERROR) << "Failed to initialize armor classifier.";
+      classifier_.reset();
+      return false;
+    }
+  }
+  color_threshold_ = static_cast<uchar>(color_threshold);
+  min_small_distance_ = small_distance[0];
+  max_small_distance_ = small_distance[1];
+  min_big_distance_ = big_distance[0];
+  max_big_distance_ = big_distance[1];
+  roi_scale_ = {static_cast<float>(roi_scale[0]), static_cast<float>(roi_scale[1])};
+  zoom_region_ = {static_cast<float>(zoom_region[0]), static_cast<float>(zoom_region[1])};
+  locked_ = false;
+  SetThreads(threads);
+  LOG(INFO) << "Initialized armor detector with " << tiles_ << " tiles and "
+            << thread_pool_->Threads() << " threads for full-frame search on pyramid level " << pyramid_level_ << ".";
+  return true;
+}
+
+bool detector::armor::ArmorDetector::Detect(Frame REF_IN frame,
+                                            simd::LightColor color,
+                                            coordinate::CoordSolver REF_IN coord_solver,
+                                            coordinate::EAngle REF_IN euler_angle,
+                                            std::vector<Armor> REF_OUT armors) {
+  armors.clear();
+  auto image_size = frame.Size();
+  if (image_size.empty()) {
+    locked_ = false;
+    return false;
+  }
+  if (locked_ && frames_since_full_search_ < full_search_interval_) {
+    // 远处的小目标在全分辨率下跟踪，近处目标与全图搜索使用相同的金字塔层级
+    int level = target_size_.height < zoom_max_height_ ? 0 : pyramid_level_;
+    roi_ = TrackingROI(image_size, level);
+    ++frames_since_full_search_;
+    if (!roi_.empty()) DetectInROI(frame, color, roi_, level, coord_solver, euler_angle, armors);
+  }
+  // 未锁定、到达全图搜索间隔或在 ROI 内丢失目标时，在同一帧内进行全图搜索
+  if (armors.empty()) {
+    roi_ = {{0, 0}, image_size};
+    frames_since_full_search_ = 0;
+    DetectInROI(frame, color, roi_, pyramid_level_, coord_solver, euler_angle, armors);
+  }
+  if (armors.empty()) {
+    locked_ = false;
+    return false;
+  }
+
+  auto vertexes_center = [](Armor REF_IN armor) {
+    auto &&v = armor.Vertexes();
+    return (v[0] + v[1] + v[2] + v[3]) / 4;
+  };
+  auto reference = locked_ ? target_center_
+                           : cv::Point2f(0.5f * static_cast<float>(image_size.width),
+                                         0.5f * static_cast<float>(image_size.height));
+  auto target = std::min_element(armors.begin(), armors.end(), [&](Armor REF_IN a, Armor REF_IN b) {
+    return cv::norm(vertexes_center(a) - reference) < cv::norm(vertexes_center(b) - reference);
+  });
+  std::iter_swap(armors.begin(), target);
+  target_center_ = vertexes_center(armors.front());
+  target_size_ = cv::boundingRect(armors.front().Vertexes()).size();
+  locked_ = true;
+  return true;
+}
+
+void detector::armor::ArmorDetector::Predict(cv::Point2f REF_IN center) {
+  target_center_ = center;
+}
+
+void detector::armor::ArmorDetector::SetThreads(size_t threads) {
+  thread_pool_ = std::make_unique<thread_pool::ThreadPool>(threads);
+}
+
+void detector::armor::ArmorDetector::DetectInROI(Frame REF_IN frame,
+                                                 simd::LightColor color,
+                                                 cv::Rect REF_IN roi,
+                                                 int level,
+                                                 coordinate::CoordSolver REF_IN coord_solver,
+                                                 coordinate::EAngle REF_IN euler_angle,
+                                                 std::vector<Armor> REF_OUT armors) {
+  std::vector<LightBar> light_bars;
+  bool full_frame = roi.size() == frame.Size();
+  // Bayer 帧的全分辨率解马赛克在条带边界处与整幅图像不一致，此时不分块
+  if (tiles_ > 1 && full_frame && (level > 0 || frame.bayer.empty()))
+    FindLightBarsTiled(frame, color, level, light_bars);
+  else {
+    auto scale = MakeMask(frame, color, roi, level, mask_, channels_, crop_);
+    if (scale) FindLightBars(scale, roi.tl(), light_bars);
+  }
+  if (full_frame && level > 0) FindLightBarsZoomed(frame, color, light_bars);
+  MatchLightBars(frame, light_bars, coord_solver, euler_angle, armors);
+}
+
+int detector::armor::ArmorDetector::MakeMask(Frame REF_IN frame, simd::LightColor color, cv::Rect REF_IN roi,
+                                             int level, cv::Mat REF_OUT mask, cv::Mat channels[3],
+                                             cv::Mat REF_OUT crop) const {
+  if (level == 1 && !frame.bayer.empty()) {
+    mask.create(roi.height / 2, roi.width / 2, CV_8UC1);
+    if (!simd::color_mask_8u(frame.bayer.ptr<uchar>(roi.y) + roi.x, roi.width, roi.height, frame.bayer.step,
+                             mask.data, mask.step, frame.bayer_pattern, color, color_threshold_, true)) {
+      DLOG(WARNING) << "Skipped too small ROI " << roi << ".";
+      return 0;
+    }
+    return 2;
+  }
+  cv::Mat source;
+  if (level == 0)
+    source = frame.Crop(roi, crop);
+  else {
+    auto &&level_image = frame.Level(level);
+    cv::Rect level_roi(roi.x >> level, roi.y >> level, roi.width >> level, roi.height >> level);
+    if (!level_roi.empty() && (level_roi & cv::Rect({0, 0}, level_image.size())) == level_roi)
+      source = level_image(level_roi);
+  }
+  if (source.empty()) {
+    DLOG(WARNING) << "Skipped too small ROI " << roi << " on pyramid level " << level << ".";
+    return 0;
+  }
+  cv::split(source, channels);
+  if (color == simd::LightColor::RED)
+    cv::subtract(channels[2], channels[0], mask);
+  else
+    cv::subtract(channels[0], channels[2], mask);
+  cv::threshold(mask, mask, color_threshold_, 255, cv::THRESH_BINARY);
+  return 1 << level;
+}
+
+void detector::armor::ArmorDetector::FindLightBars(int scale,
+                                                   cv::Point REF_IN offset,
+                                                   std::vector<LightBar> REF_OUT light_bars) {
+  std::vector<std::vector<cv::Point>> contours;
+  cv::findContours(mask_, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+  LightBar light_bar{};
+  for (auto &&contour : contours)
+    if (FitLightBar(contour, scale, offset, light_bar)) light_bars.push_back(light_bar);
+}
+
+void detector::armor::ArmorDetector::FindLightBarsTiled(Frame REF_IN frame,
+                                                        simd::LightColor color,
+                                                        int level,
+                                                        std::vector<LightBar> REF_OUT light_bars) {
+  auto image_size = frame.Size();
+  int scale = 1 << level, mask_rows = image_size.height / scale;
+  // 金字塔图层在首次请求时写入帧内缓存，须在分发到工作线程前生成
+  if (level > 1 || (level == 1 && frame.bayer.empty())) frame.Level(level);
+  // 每个条带至少包含 2 行掩码，保证 Bayer 子图高度不小于 4
+  auto tiles = static_cast<size_t>(std::max(1, std::min(tiles_, mask_rows / 2)));
+  auto band_begin = [&](size_t i) { return static_cast<int>(mask_rows * i / tiles); };
+  tile_data_.resize(tiles);
+
+  // 条带 i 覆盖掩码行 [begin(i), begin(i + 1)]，与下一条带重叠的末行即为接缝行；
+  // 不与接缝行相交的轮廓完整地位于条带内部，可直接在工作线程中拟合
+  thread_pool_->ParallelFor(tiles, [&](size_t i) {
+    auto &&tile = tile_data_[i];
+    tile.contours.clear();
+    tile.pieces.clear();
+    tile.light_bars.clear();
+    int begin = band_begin(i), end = i + 1 < tiles ? band_begin(i + 1) + 1 : mask_rows;
+    cv::Rect roi(0, begin * scale, image_size.width, (end - begin) * scale);
+    if (!MakeMask(frame, color, roi, level, tile.mask, tile.channels, tile.crop)) return;
+    cv::findContours(tile.mask, tile.contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE, {0, begin});
+    auto on_seam = [&](cv::Point REF_IN p) { return (i > 0 && p.y == begin) || (i + 1 < tiles && p.y == end - 1); };
+    LightBar light_bar{};
+    for (size_t j = 0; j < tile.contours.size(); ++j) {
+      auto &&contour = tile.contours[j];
+      if (std::any_of(contour.begin(), contour.end(), on_seam))
+        tile.pieces.push_back(j);
+      else if (FitLightBar(contour, scale, {0, 0}, light_bar))
+        tile.light_bars.push_back(light_bar);
+    }
+  });
+
+  // 外轮廓包含连通域在条带边界行上的全部像素，接缝两侧在同一像素处相交的轮廓片段属于同一连通域，以并查集合并；
+  // 合并后的点集与整幅图像上的轮廓具有相同的凸包，拟合结果与不分块时一致
+  std::vector<std::pair<size_t, size_t>> pieces;
+  std::vector<size_t> first_piece(tiles + 1);
+  for (size_t i = 0; i < tiles; ++i) {
+    first_piece[i] = pieces.size();
+    for (auto j : tile_data_[i].pieces) pieces.emplace_back(i, j);
+  }
+  first_piece[tiles] = pieces.size();
+  std::vector<size_t> parent(pieces.size());
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&](size_t k) {
+    while (parent[k] != k) k = parent[k] = parent[parent[k]];
+    return k;
+  };
+  auto piece_contour = [&](size_t k) -> auto && { return tile_data_[pieces[k].first].contours[pieces[k].second]; };
+  std::vector<int> owner(image_size.width / scale);
+  for (size_t i = 1; i < tiles; ++i) {
+    int seam = band_begin(i);
+    std::fill(owner.begin(), owner.end(), -1);
+    for (auto k = first_piece[i - 1]; k < first_piece[i]; ++k)
+      for (auto &&p : piece_contour(k))
+        if (p.y == seam) owner[p.x] = static_cast<int>(k);
+    for (auto k = first_piece[i]; k < first_piece[i + 1]; ++k)
+      for (auto &&p : piece_contour(k))
+        if (p.y == seam && owner[p.x] >= 0) parent[find(k)] = find(owner[p.x]);
+  }
+
+  for (auto &&tile : tile_data_)
+    light_bars.insert(light_bars.end(), tile.light_bars.begin(), tile.light_bars.end());
+  std::vector<std::vector<cv::Point>> merged_contours;
+  std::vector<int> merged_index(pieces.size(), -1);
+  for (size_t k = 0; k < pieces.size(); ++k) {
+    auto root = find(k);
+    if (merged_index[root] < 0) {
+      merged_index[root] = static_cast<int>(merged_contours.size());
+      merged_contours.emplace_back();
+    }
+    auto &&contour = merged_contours[merged_index[root]];
+    contour.insert(contour.end(), piece_contour(k).begin(), piece_contour(k).end());
+  }
+  LightBar light_bar{};
+  for (auto &&contour : merged_contours)
+    if (FitLightBar(contour, scale, {0, 0}, light_bar)) light_bars.push_back(light_bar);
+}
+
+void detector::armor::ArmorDetector::FindLightBarsZoomed(Frame REF_IN frame,
+                                                         simd::LightColor color,
+                                                         std::vector<LightBar> REF_OUT light_bars) {
+  auto image_size = frame.Size();
+  auto width = cvRound(zoom_region_.width * static_cast<float>(image_size.width)) & ~1,
+      height = cvRound(zoom_region_.height * static_cast<float>(image_size.height)) & ~1;
+  cv::Rect zoom(((image_size.width - width) / 2) & ~1, ((image_size.height - height) / 2) & ~1, width, height);
+  if (zoom.width < 4 || zoom.height < 4 || !MakeMask(frame, color, zoom, 0, mask_, channels_, crop_)) return;
+  std::vector<LightBar> zoom_light_bars;
+  FindLightBars(1, zoom.tl(), zoom_light_bars);
+  // 与区域边界相交的灯条可能被截断，交由粗搜索的结果处理；其余灯条以全分辨率结果替换粗搜索中的同一灯条
+  cv::Rect2f inner(static_cast<float>(zoom.x + 1), static_cast<float>(zoom.y + 1),
+                   static_cast<float>(zoom.width - 2), static_cast<float>(zoom.height - 2));
+  zoom_light_bars.erase(std::remove_if(zoom_light_bars.begin(), zoom_light_bars.end(), [&](LightBar REF_IN l) {
+    return !inner.contains(l.top) || !inner.contains(l.bottom);
+  }), zoom_light_bars.end());
+  light_bars.erase(std::remove_if(light_bars.begin(), light_bars.end(), [&](LightBar REF_IN l) {
+    return std::any_of(zoom_light_bars.begin(), zoom_light_bars.end(), [&](LightBar REF_IN z) {
+      return cv::norm(l.center - z.center) < 0.5f * std::max(l.length, z.length);
+    });
+  }), light_bars.end());
+  light_bars.insert(light_bars.end(), zoom_light_bars.begin(), zoom_light_bars.end());
+}
+
+bool detector::armor::ArmorDetector::FitLightBar(std::vector<cv::Point> REF_IN contour,
+                                                 int scale,
+                                                 cv::Point REF_IN offset,
+                                                 LightBar REF_OUT light_bar) const {
+  // 掩码像素 (x, y) 对应原图 [scale * x, scale * x + scale) 范围，其中心为 scale * x + (scale - 1) / 2
+  auto origin = cv::Point2f(offset) + cv::Point2f(0.5f * static_cast<float>(scale - 1),
+                                                  0.5f * static_cast<float>(scale - 1));
+  auto rect = cv::minAreaRect(contour);
+  // 轮廓点为像素中心，外扩半个像素得到像素边界
+  rect.size.width += 1;
+  rect.size.height += 1;
+  cv::Point2f corners[4];
+  rect.points(corners);
+  for (auto &&p : corners) p = p * static_cast<float>(scale) + origin;
+  std::sort(corners, corners + 4, [](cv::Point2f REF_IN a, cv::Point2f REF_IN b) { return a.y < b.y; });
+  light_bar.top = (corners[0] + corners[1]) / 2;
+  light_bar.bottom = (corners[2] + corners[3]) / 2;
+  light_bar.center = (light_bar.top + light_bar.bottom) / 2;
+  light_bar.length = static_cast<float>(cv::norm(light_bar.bottom - light_bar.top));
+  light_bar.width = static_cast<float>(cv::norm(corners[1] - corners[0]));
+  light_bar.angle = static_cast<float>(std::atan2(light_bar.top.x - light_bar.bottom.x,
+                                                  light_bar.bottom.y - light_bar.top.y) * 180 / CV_PI);
+  if (light_bar.length * light_bar.width < min_light_area_) return false;
+  auto ratio = light_bar.length / light_bar.width;
+  if (ratio < min_light_ratio_ || ratio > max_light_ratio_) return false;
+  return std::abs(light_bar.angle) <= max_light_tilt_;
+}
+
+void detector::armor::ArmorDetector::MatchLightBars(Frame REF_IN frame,
+                                                    std::vector<LightBar> REF_IN light_bars,
+                                                    coordinate::CoordSolver REF_IN coord_solver,
+                                                    coordinate::EAngle REF_IN euler_angle,
+                                                    std::vector<Armor> REF_OUT armors) {
+  struct Candidate {
+    size_t left, right;
+    Armor::ArmorSize size;
+    double score;
+    int id;
+  };
+  std::vector<Candidate> candidates;
+  for (size_t i = 0; i < light_bars.size(); ++i)
+    for (size_t j = i + 1; j < light_bars.size(); ++j) {
+      auto left = i, right = j;
+      if (light_bars[left].center.x > light_bars[right].center.x) std::swap(left, right);
+      auto &&l = light_bars[left], &&r = light_bars[right];
+      double length_ratio = std::min(l.length, r.length) / std::max(l.length, r.length);
+      if (length_ratio < min_length_ratio_) continue;
+      double angle_diff = std::abs(l.angle - r.angle);
+      if (angle_diff > max_angle_diff_) continue;
+      double average_length = 0.5 * (l.length + r.length);
+      double y_offset = std::abs(l.center.y - r.center.y) / average_length;
+      if (y_offset > max_y_offset_) continue;
+      double distance = cv::norm(r.center - l.center) / average_length;
+      Armor::ArmorSize size;
+      if (distance >= min_small_distance_ && distance <= max_small_distance_)
+        size = Armor::ArmorSize::SMALL;
+      else if (distance >= min_big_distance_ && distance <= max_big_distance_)
+        size = Armor::ArmorSize::BIG;
+      else continue;
+      // 两灯条之间夹有其他灯条时多为相邻装甲板的误匹配
+      auto top = std::min(l.top.y, r.top.y), bottom = std::max(l.bottom.y, r.bottom.y);
+      auto in_between = [&](LightBar REF_IN m) {
+        return m.center.x > l.center.x && m.center.x < r.center.x && m.center.y > top && m.center.y < bottom;
+      };
+      if (std::any_of(light_bars.begin(), light_bars.end(), in_between)) continue;
+      candidates.push_back({left, right, size, angle_diff / max_angle_diff_ + y_offset / max_y_offset_
+          + 1 - length_ratio, 0});
+    }
+  // 在贪心选取前整批分类并剔除负样本，避免误匹配占用真实装甲板的灯条
+  if (classifier_ && !candidates.empty()) {
+    patches_.clear();
+    cv::Rect region;
+    for (auto &&candidate : candidates) {
+      auto &&l = light_bars[candidate.left], &&r = light_bars[candidate.right];
+      patches_.push_back({{l.bottom, l.top, r.top, r.bottom}, candidate.size, 0, 0});
+      // 分类器的取样范围在灯条上下各延伸不到一个灯条长度
+      auto bounds = cv::boundingRect(std::vector<cv::Point2f>{l.bottom, l.top, r.top, r.bottom});
+      auto margin = cvCeil(std::max(l.length, r.length));
+      region |= cv::Rect(bounds.x - margin, bounds.y - margin, bounds.width + 2 * margin, bounds.height + 2 * margin);
+    }
+    // 分类器须与几何阶段看到同样解马赛克后的彩色图像，Bayer 帧只将候选所在的区域解马赛克
+    cv::Mat source = frame.image;
+    if (source.empty()) {
+      // 按 2 像素对齐，使 Bayer 子图与原图的阵列排列一致
+      cv::Point top_left(region.x & ~1, region.y & ~1), bottom_right(region.br().x + 1, region.br().y + 1);
+      region = cv::Rect(top_left, bottom_right) & cv::Rect({0, 0}, frame.Size());
+      region.width &= ~1;
+      region.height &= ~1;
+      source = frame.Crop(region, patch_crop_);
+      for (auto &&patch : patches_)
+        for (auto &&vertex : patch.vertexes) vertex -= cv::Point2f(region.tl());
+    }
+    if (!source.empty()) classifier_->Classify(source, patches_);
+    for (size_t k = 0; k < candidates.size(); ++k)
+      if (patches_[k].confidence >= min_confidence_) candidates[k].id = patches_[k].id;
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [](Candidate REF_IN candidate) { return !candidate.id; }),
+                     candidates.end());
+  }
+  std::sort(candidates.begin(), candidates.end(), [](Candidate REF_IN a, Candidate REF_IN b) {
+    return a.score < b.score || (a.score == b.score && std::tie(a.left, a.right) < std::tie(b.left, b.right));
+  });
+  // 按匹配评分贪心选取，每个灯条至多属于一块装甲板
+  std::vector<bool> used(light_bars.size(), false);
+  for (auto &&candidate : candidates) {
+    if (used[candidate.left] || used[candidate.right]) continue;
+    used[candidate.left] = used[candidate.right] = true;
+    auto &&l = light_bars[candidate.left], &&r = light_bars[candidate.right];
+    armors.emplace_back(std::array<cv::Point2f, 4>{l.bottom, l.top, r.top, r.bottom},
+                        coord_solver, euler_angle, candidate.size, candidate.id);
+  }
+}
+
+cv::Rect detector::armor::ArmorDetector::TrackingROI(cv::Size REF_IN image_size, int level) const {
+  auto width = target_size_.width * roi_scale_.width, height = target_size_.height * roi_scale_.height;
+  cv::Rect roi(cvFloor(target_center_.x - 0.5f * width), cvFloor(target_center_.y - 0.5f * height),
+               cvCeil(width), cvCeil(height));
+  roi &= cv::Rect({0, 0}, image_size);
+  // 按 2 像素对齐，使 Bayer 子图与原图的阵列排列一致；使用金字塔图层时按该层的像素尺寸对齐
+  int alignment = ~((1 << std::max(level, 1)) - 1);
+  roi.x &= alignment;
+  roi.y &= alignment;
+  roi.width &= alignment;
+  roi.height &= alignment;
+  return roi;
+}
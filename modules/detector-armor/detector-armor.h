@@ -0,0 +1,180 @@
+#ifndef SRM_IC_2023_MODULES_DETECTOR_ARMOR_DETECTOR_ARMOR_H_
+#define SRM_IC_2023_MODULES_DETECTOR_ARMOR_DETECTOR_ARMOR_H_
+
+#include "thread-pool/thread-pool.h"
+#include "classifier/classifier.h"
+#include "detector-base/detector-base.h"
+
+namespace detector::armor {
+/// 灯条数据结构体
+struct LightBar {
+  cv::Point2f top;     ///< 上端点
+  cv::Point2f bottom;  ///< 下端点
+  cv::Point2f center;  ///< 中心点
+  float length;        ///< 长度
+  float width;         ///< 宽度
+  float angle;         ///< 相对竖直方向的倾角，单位：度，顺时针为正
+};
+
+/**
+ * @brief 基于灯条匹配的装甲板识别器
+ * @details 对敌方颜色的色差掩码提取轮廓并筛选灯条，两两配对生成装甲板；
+ *   锁定目标后只处理预测位置附近的 ROI，每隔若干帧或目标丢失时回到全图搜索；
+ *   全图搜索在降采样的金字塔图层上寻找近处目标，并在图像中央的放大区域内以全分辨率寻找远处目标，
+ *   锁定的远处小目标同样在全分辨率下跟踪；
+ *   全图搜索将图像划分为相互重叠一行的水平条带，在线程池中并行分割并提取轮廓，跨接缝的轮廓在合并后再拟合灯条；
+ *   配置了分类器时，通过几何筛选的灯条对整批分类，剔除负样本并记录装甲板编号
+ * @warning 禁止直接构造此类，请使用 @code detector::CreateDetector("armor") @endcode 获取该类的公共接口指针
+ */
+class ArmorDetector final : public Detector {
+ public:
+  ArmorDetector() = default;
+  ~ArmorDetector() final = default;
+
+  bool Initialize(std::string REF_IN config_file) final;
+  bool Detect(Frame REF_IN frame,
+              simd::LightColor color,
+              coordinate::CoordSolver REF_IN coord_solver,
+              coordinate::EAngle REF_IN euler_angle,
+              std::vector<Armor> REF_OUT armors) final;
+  void Predict(cv::Point2f REF_IN center) final;
+  void SetThreads(size_t threads) final;
+
+ private:
+  /// 全图分块搜索中单个水平条带的数据
+  struct Tile {
+    cv::Mat mask;                                  ///< 条带色差掩码
+    cv::Mat channels[3];                           ///< 彩色帧通道分离缓存
+    cv::Mat crop;                                  ///< Bayer 帧全分辨率解马赛克缓存
+    std::vector<std::vector<cv::Point>> contours;  ///< 条带内的轮廓，坐标为整幅掩码坐标
+    std::vector<size_t> pieces;                    ///< 与接缝行相交、需跨条带合并的轮廓下标
+    std::vector<LightBar> light_bars;              ///< 完全位于条带内部的灯条
+  };
+
+  /**
+   * @brief 在图像的指定区域内识别装甲板
+   * @param [in] frame 帧数据
+   * @param color 敌方灯条颜色
+   * @param [in] roi 搜索区域
+   * @param level 分割所用的金字塔层级，0 为全分辨率
+   * @param [in] coord_solver 坐标求解器
+   * @param [in] euler_angle 当前云台姿态欧拉角
+   * @param [out] armors 识别到的装甲板
+   */
+  void DetectInROI(Frame REF_IN frame,
+                   simd::LightColor color,
+                   cv::Rect REF_IN roi,
+                   int level,
+                   coordinate::CoordSolver REF_IN coord_solver,
+                   coordinate::EAngle REF_IN euler_angle,
+                   std::vector<Armor> REF_OUT armors);
+
+  /**
+   * @brief 生成指定区域的色差掩码
+   * @param [in] frame 帧数据
+   * @param color 敌方灯条颜色
+   * @param [in] roi 搜索区域，须按 2 像素及该层的像素尺寸对齐
+   * @param level 金字塔层级，0 为全分辨率；Bayer 帧的第 1 层直接由原始图像生成半分辨率掩码
+   * @param [out] mask 色差掩码
+   * @param [out] channels 通道分离缓存
+   * @param [out] crop Bayer 帧全分辨率解马赛克缓存
+   * @return 掩码相对原图的缩放倍数，即 2^level，区域过小时为 0
+   */
+  int MakeMask(Frame REF_IN frame, simd::LightColor color, cv::Rect REF_IN roi, int level,
+               cv::Mat REF_OUT mask, cv::Mat channels[3], cv::Mat REF_OUT crop) const;
+
+  /**
+   * @brief 从掩码中筛选灯条
+   * @param scale 掩码相对原图的缩放倍数
+   * @param [in] offset 掩码左上角在原图中的坐标
+   * @param [out] light_bars 灯条列表，坐标为原图坐标
+   */
+  void FindLightBars(int scale, cv::Point REF_IN offset, std::vector<LightBar> REF_OUT light_bars);
+
+  /**
+   * @brief 分块并行地在整幅图像中筛选灯条
+   * @param [in] frame 帧数据
+   * @param color 敌方灯条颜色
+   * @param level 分割所用的金字塔层级
+   * @param [out] light_bars 灯条列表，坐标为原图坐标，顺序与线程数无关
+   */
+  void FindLightBarsTiled(Frame REF_IN frame, simd::LightColor color, int level,
+                          std::vector<LightBar> REF_OUT light_bars);
+
+  /**
+   * @brief 在图像中央的放大区域内以全分辨率筛选灯条，替换粗搜索得到的同一灯条
+   * @param [in] frame 帧数据
+   * @param color 敌方灯条颜色
+   * @param [in,out] light_bars 粗搜索得到的灯条列表，坐标为原图坐标
+   */
+  void FindLightBarsZoomed(Frame REF_IN frame, simd::LightColor color, std::vector<LightBar> REF_OUT light_bars);
+
+  /**
+   * @brief 由轮廓拟合灯条并按形状筛选
+   * @param [in] contour 轮廓，掩码坐标
+   * @param scale 掩码相对原图的缩放倍数
+   * @param [in] offset 掩码左上角在原图中的坐标
+   * @param [out] light_bar 灯条，坐标为原图坐标
+   * @return 是否为合格灯条
+   */
+  bool FitLightBar(std::vector<cv::Point> REF_IN contour, int scale, cv::Point REF_IN offset,
+                   LightBar REF_OUT light_bar) const;
+
+  /**
+   * @brief 灯条两两配对生成装甲板
+   * @param [in] frame 帧数据，用于提取装甲板图案分类
+   * @param [in] light_bars 灯条列表
+   * @param [in] coord_solver 坐标求解器
+   * @param [in] euler_angle 当前云台姿态欧拉角
+   * @param [out] armors 装甲板列表
+   */
+  void MatchLightBars(Frame REF_IN frame,
+                      std::vector<LightBar> REF_IN light_bars,
+                      coordinate::CoordSolver REF_IN coord_solver,
+                      coordinate::EAngle REF_IN euler_angle,
+                      std::vector<Armor> REF_OUT armors);
+
+  /**
+   * @brief 根据锁定目标计算下一帧的搜索区域
+   * @param [in] image_size 图像尺寸
+   * @param level 分割所用的金字塔层级
+   * @return 搜索区域，按 2 像素及该层的像素尺寸对齐
+   */
+  [[nodiscard]] cv::Rect TrackingROI(cv::Size REF_IN image_size, int level) const;
+
+  static Registry<ArmorDetector> registry_;  ///< 识别器注册信息
+
+  uchar color_threshold_{};                               ///< 色差阈值
+  double min_light_area_{};                               ///< 灯条最小面积，单位：像素
+  double min_light_ratio_{};                              ///< 灯条最小长宽比
+  double max_light_ratio_{};                              ///< 灯条最大长宽比
+  double max_light_tilt_{};                               ///< 灯条最大倾角，单位：度
+  double min_length_ratio_{};                             ///< 配对灯条最小长度比
+  double max_angle_diff_{};                               ///< 配对灯条最大倾角差，单位：度
+  double max_y_offset_{};                                 ///< 配对灯条最大纵向偏移，相对灯条长度
+  double min_small_distance_{};                           ///< 小装甲板灯条最小间距，相对灯条长度
+  double max_small_distance_{};                           ///< 小装甲板灯条最大间距，相对灯条长度
+  double min_big_distance_{};                             ///< 大装甲板灯条最小间距，相对灯条长度
+  double max_big_distance_{};                             ///< 大装甲板灯条最大间距，相对灯条长度
+  cv::Size2f roi_scale_;                                  ///< ROI 尺寸相对目标外接矩形的倍数
+  int full_search_interval_{};                            ///< 锁定状态下全图搜索的间隔帧数
+  int frames_since_full_search_{};                        ///< 距上次全图搜索的帧数
+  cv::Point2f target_center_;                             ///< 锁定目标在下一帧图像上的中心位置
+  cv::Size2f target_size_;                                ///< 锁定目标的外接矩形尺寸
+  int tiles_{};                                           ///< 全图搜索划分的水平条带数，为 1 时不分块
+  int pyramid_level_{};                                   ///< 全图搜索与近处目标跟踪所用的金字塔层级
+  cv::Size2f zoom_region_;                                ///< 全图搜索时以全分辨率复查的中央区域，相对图像尺寸
+  float zoom_max_height_{};                               ///< 低于此高度的锁定目标在全分辨率下跟踪，单位：像素
+  cv::Mat mask_;                                          ///< 色差掩码缓存
+  cv::Mat channels_[3];                                   ///< 通道分离缓存
+  cv::Mat crop_;                                          ///< Bayer 帧全分辨率解马赛克缓存
+  cv::Mat patch_crop_;                                    ///< Bayer 帧分类区域解马赛克缓存
+  std::vector<Tile> tile_data_;                           ///< 全图分块搜索的条带数据缓存
+  std::unique_ptr<thread_pool::ThreadPool> thread_pool_;  ///< 全图分块搜索线程池
+  std::unique_ptr<classifier::Classifier> classifier_;    ///< 装甲板编号分类器，未配置时为空
+  std::vector<classifier::Candidate> patches_;            ///< 分类候选缓存
+  double min_confidence_{};                               ///< 分类置信度下限，低于此值视为负样本
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_DETECTOR_ARMOR_DETECTOR_ARMOR_H_
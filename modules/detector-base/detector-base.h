@@ -0,0 +1,67 @@
+#ifndef SRM_IC_2023_MODULES_DETECTOR_BASE_DETECTOR_BASE_H_
+#define SRM_IC_2023_MODULES_DETECTOR_BASE_DETECTOR_BASE_H_
+
+#include <vector>
+#include "common/factory.h"
+#include "common/frame.h"
+#include "common/armor.h"
+
+enable_factory(detector, Detector)
+
+namespace detector {
+/// 装甲板识别器公共接口类
+class Detector {
+ public:
+  Detector() = default;
+  virtual ~Detector() = default;
+
+  /// 是否已锁定目标，锁定时识别器只在目标附近的 ROI 内搜索
+  attr_reader_val(locked_, Locked)
+
+  /// 最近一次识别所处理的图像区域
+  attr_reader_ref(roi_, ROI)
+
+  /**
+   * @brief 初始化识别器
+   * @param [in] config_file 配置文件路径
+   * @return 是否初始化成功
+   */
+  virtual bool Initialize(std::string REF_IN config_file) = 0;
+
+  /**
+   * @brief 识别图像中的装甲板
+   * @param [in] frame 帧数据，Bayer 帧直接使用原始图像，不触发解马赛克
+   * @param color 敌方灯条颜色
+   * @param [in] coord_solver 坐标求解器
+   * @param [in] euler_angle 当前云台姿态欧拉角
+   * @param [out] armors 识别到的装甲板，锁定目标时首个元素为当前目标
+   * @return 是否识别到装甲板
+   */
+  virtual bool Detect(Frame REF_IN frame,
+                      simd::LightColor color,
+                      coordinate::CoordSolver REF_IN coord_solver,
+                      coordinate::EAngle REF_IN euler_angle,
+                      std::vector<Armor> REF_OUT armors) = 0;
+
+  /**
+   * @brief 设置锁定目标在下一帧图像上的预测位置，用于放置 ROI
+   * @param [in] center 预测的目标中心图像坐标
+   */
+  virtual void Predict(cv::Point2f REF_IN center) = 0;
+
+  /**
+   * @brief 设置全图搜索使用的并行线程数，识别结果与线程数无关
+   * @param threads 线程数（含调用线程），0 表示使用硬件并发数
+   */
+  virtual void SetThreads(size_t threads) = 0;
+
+  /// 解除目标锁定，下一次识别进行全图搜索
+  void Unlock() { locked_ = false; }
+
+ protected:
+  bool locked_{};  ///< 是否已锁定目标
+  cv::Rect roi_;   ///< 最近一次识别所处理的图像区域
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_DETECTOR_BASE_DETECTOR_BASE_H_
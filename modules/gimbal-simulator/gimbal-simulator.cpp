@@ -0,0 +1,167 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <glog/logging.h>
+#include <opencv2/core/persistence.hpp>
+#include "common/frame.h"
+#include "serial/protocol.h"
+#include "gimbal-simulator.h"
+
+namespace {
+constexpr double kMaxStepTime = 0.1;  ///< 模拟线程被长时间挂起后单次推进的最长时间，单位：s
+}
+
+bool gimbal_simulator::Param::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage gimbal_config;
+  gimbal_config.open(config_file, cv::FileStorage::READ);
+  if (!gimbal_config.isOpened()) {
+    LOG(ERROR) << "Failed to open gimbal configuration file " << config_file << ".";
+    return false;
+  }
+  gimbal_config["RATE"] >> rate;
+  gimbal_config["COMMAND_LATENCY"] >> command_latency;
+  gimbal_config["NATURAL_FREQUENCY"] >> natural_frequency;
+  gimbal_config["DAMPING_RATIO"] >> damping_ratio;
+  gimbal_config["MAX_SPEED"] >> max_speed;
+  gimbal_config["MAX_ACCELERATION"] >> max_acceleration;
+  gimbal_config["BULLET_SPEED"] >> bullet_speed;
+  gimbal_config["COLOR"] >> color;
+  gimbal_config["MODE"] >> mode;
+  gimbal_config["ARMOR_KIND"] >> armor_kind;
+  if (rate <= 0 || command_latency < 0 || natural_frequency <= 0 || damping_ratio <= 0 || max_speed <= 0
+      || max_acceleration <= 0 || bullet_speed <= 0) {
+    LOG(ERROR) << "Invalid gimbal configurations. Rate, dynamics and limits must be positive.";
+    return false;
+  }
+  // 显式欧拉积分要求步长远小于系统时间常数
+  if (natural_frequency / rate > 0.2) {
+    LOG(ERROR) << "Simulation rate " << rate << " Hz is too low for natural frequency " << natural_frequency
+               << " rad/s.";
+    return false;
+  }
+  return true;
+}
+
+gimbal_simulator::GimbalSimulator::~GimbalSimulator() {
+  Stop();
+}
+
+bool gimbal_simulator::GimbalSimulator::Initialize(std::string REF_IN config_file) {
+  if (!param_.Initialize(config_file)) {
+    LOG(ERROR) << "Failed to read gimbal simulator configurations.";
+    return false;
+  }
+  LOG(INFO) << "Initialized gimbal simulator at " << param_.rate << " Hz.";
+  return true;
+}
+
+bool gimbal_simulator::GimbalSimulator::Start() {
+  if (master_fd_ != -1) return false;
+  master_fd_ = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (master_fd_ == -1 || grantpt(master_fd_) == -1 || unlockpt(master_fd_) == -1) {
+    LOG(ERROR) << "Failed to create pseudo terminal pair for gimbal simulator.";
+    if (master_fd_ != -1) close(master_fd_);
+    master_fd_ = -1;
+    return false;
+  }
+  port_ = ptsname(master_fd_);
+  {
+    std::lock_guard<std::mutex> lock(state_lock_);
+    pending_head_ = pending_size_ = 0;
+    angle_ = velocity_ = target_ = {};
+  }
+  commands_ = 0;
+  stop_flag_ = false;
+  thread_ = std::thread(&GimbalSimulator::SimulationThreadFunction, this);
+  LOG(INFO) << "Gimbal simulator is listening on " << port_ << ".";
+  return true;
+}
+
+void gimbal_simulator::GimbalSimulator::Stop() {
+  if (master_fd_ == -1) return;
+  stop_flag_ = true;
+  if (thread_.joinable()) thread_.join();
+  close(master_fd_);
+  master_fd_ = -1;
+  LOG(INFO) << "Gimbal simulator on " << port_ << " stopped after " << commands_ << " commands.";
+  port_ = "";
+}
+
+coordinate::EAngle gimbal_simulator::GimbalSimulator::Attitude() {
+  std::lock_guard<std::mutex> lock(state_lock_);
+  return {0, std::remainder(angle_[0], 2 * M_PI), angle_[1]};
+}
+
+coordinate::EAngle gimbal_simulator::GimbalSimulator::Target() {
+  std::lock_guard<std::mutex> lock(state_lock_);
+  return {0, target_[0], target_[1]};
+}
+
+void gimbal_simulator::GimbalSimulator::Step(double dt) {
+  double omega = param_.natural_frequency, zeta = param_.damping_ratio;
+  for (auto axis = 0; axis < 2; ++axis) {
+    // yaw 沿最短方向转向目标
+    double error = axis ? target_[axis] - angle_[axis] : std::remainder(target_[axis] - angle_[axis], 2 * M_PI);
+    double acceleration = std::clamp(omega * omega * error - 2 * zeta * omega * velocity_[axis],
+                                     -param_.max_acceleration, param_.max_acceleration);
+    velocity_[axis] = std::clamp(velocity_[axis] + acceleration * dt, -param_.max_speed, param_.max_speed);
+    angle_[axis] += velocity_[axis] * dt;
+  }
+}
+
+void gimbal_simulator::GimbalSimulator::SimulationThreadFunction() {
+  const auto period = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / param_.rate));
+  const auto latency = static_cast<uint64_t>(param_.command_latency * 1e9);
+  const double step_time = 1 / param_.rate;
+  serial::FrameParser parser;
+  std::array<uint8_t, serial::kMaxFrameSize> frame{};
+  uint64_t receive_time = 0;
+  auto on_frame = [&](serial::PacketType type, const uint8_t *payload, size_t size) {
+    if (type != serial::PacketType::SEND || size != sizeof(SendPacket)) return;
+    SendPacket command;
+    memcpy(&command, payload, size);
+    ++commands_;
+    // 缓冲区满时丢弃最早的指令，正常运行时不会发生
+    if (pending_size_ == kCommandCapacity) {
+      pending_head_ = (pending_head_ + 1) % kCommandCapacity;
+      --pending_size_;
+    }
+    pending_[(pending_head_ + pending_size_++) % kCommandCapacity] = {receive_time, command.yaw, command.pitch};
+  };
+  auto next_time = std::chrono::steady_clock::now();
+  uint64_t last_time = Frame::HostTime();
+  while (!stop_flag_) {
+    next_time += period;
+    std::this_thread::sleep_until(next_time);
+    auto time = Frame::HostTime();
+    ReceivePacket packet{};
+    {
+      std::lock_guard<std::mutex> lock(state_lock_);
+      receive_time = time;
+      ssize_t read_count;
+      while ((read_count = read(master_fd_, parser.WriteBuffer(), parser.WriteCapacity())) > 0)
+        parser.Commit(read_count, on_frame);
+      while (pending_size_ && pending_[pending_head_].time + latency <= time) {
+        target_ = {pending_[pending_head_].yaw, pending_[pending_head_].pitch};
+        pending_head_ = (pending_head_ + 1) % kCommandCapacity;
+        --pending_size_;
+      }
+      // 线程被挂起时按固定步长补齐，保持积分稳定
+      double elapsed = std::min(static_cast<double>(time - last_time) * 1e-9, kMaxStepTime);
+      for (; elapsed > 0; elapsed -= step_time) Step(std::min(elapsed, step_time));
+      packet.mode = param_.mode;
+      packet.armor_kind = param_.armor_kind;
+      packet.color = param_.color;
+      packet.bullet_speed = param_.bullet_speed;
+      packet.yaw = static_cast<float>(std::remainder(angle_[0], 2 * M_PI));
+      packet.pitch = static_cast<float>(angle_[1]);
+    }
+    last_time = time;
+    // 主机未读取导致缓冲区满时丢弃本包，与真实串口一致
+    auto size = serial::Pack(serial::PacketType::RECEIVE, &packet, sizeof(ReceivePacket), frame.data());
+    if (write(master_fd_, frame.data(), size) < 0 && errno != EAGAIN && errno != EIO)
+      LOG(WARNING) << "Gimbal simulator failed to write to " << port_ << ".";
+  }
+}
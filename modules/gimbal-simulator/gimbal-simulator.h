@@ -0,0 +1,115 @@
+#ifndef SRM_IC_2023_MODULES_GIMBAL_SIMULATOR_GIMBAL_SIMULATOR_H_
+#define SRM_IC_2023_MODULES_GIMBAL_SIMULATOR_GIMBAL_SIMULATOR_H_
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "common/packet.h"
+#include "coordinate/coordinate.h"
+
+namespace gimbal_simulator {
+constexpr int kCommandCapacity = 256;  ///< 等待生效的指令缓冲区容量
+
+/// 云台模拟参数
+struct Param {
+  double rate{};               ///< 下位机发送 ReceivePacket 的频率，也是动力学仿真的步长倒数，单位：Hz
+  double command_latency{};    ///< 收到指令到云台开始执行的延迟，单位：s
+  double natural_frequency{};  ///< 二阶响应的自然频率，单位：rad/s
+  double damping_ratio{};      ///< 二阶响应的阻尼比
+  double max_speed{};          ///< 最大角速度，单位：rad/s
+  double max_acceleration{};   ///< 最大角加速度，单位：rad/s^2
+  float bullet_speed{};        ///< 上报的弹速，单位：m/s
+  int color{};                 ///< 上报的自身颜色，0 为红色
+  int mode{};                  ///< 上报的瞄准模式
+  int armor_kind{};            ///< 上报的前哨站装甲板模式
+
+  /**
+   * @brief 从配置文件读取参数
+   * @param [in] config_file 配置文件路径
+   * @return 是否读取成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+};
+
+/**
+ * @brief 云台下位机模拟器，在伪终端上代替电控板
+ * @details 模拟线程以下位机的真实频率运行：解析收到的 SendPacket，指令经过固定延迟后成为 yaw、pitch 的目标角度；
+ *   每轴为受角速度、角加速度限制的二阶系统，yaw 沿最短方向转动；每步发送一个携带当前姿态与弹速的 ReceivePacket，
+ *   主机未及时读取时丢弃；serial::Serial 打开 Port() 即可与之通信，配合文件或合成视频源在没有机器人时测量闭环瞄准
+ */
+class GimbalSimulator final {
+ public:
+  GimbalSimulator() = default;
+  ~GimbalSimulator();
+
+  /// 伪终端从端路径，供 serial::Serial 打开
+  attr_reader_ref(port_, Port)
+
+  /**
+   * @brief 初始化模拟器
+   * @param [in] config_file 配置文件路径
+   * @return 是否初始化成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+
+  /**
+   * @brief 创建伪终端并启动模拟线程
+   * @return 是否启动成功
+   */
+  bool Start();
+
+  /// 停止模拟线程并关闭伪终端
+  void Stop();
+
+  /**
+   * @brief 获取云台的真实姿态
+   * @return 云台姿态欧拉角，roll 恒为 0，yaw 位于 (-π, π]
+   */
+  [[nodiscard]] coordinate::EAngle Attitude();
+
+  /**
+   * @brief 获取已生效的目标姿态
+   * @return 目标姿态欧拉角，roll 恒为 0
+   */
+  [[nodiscard]] coordinate::EAngle Target();
+
+  /**
+   * @brief 获取已收到的指令数
+   * @return 指令数
+   */
+  [[nodiscard]] uint64_t Commands() const { return commands_; }
+
+ private:
+  /// 等待生效的指令
+  struct Command {
+    uint64_t time;  ///< 收到指令的时间，单位：ns
+    float yaw;      ///< 目标 yaw，单位：rad
+    float pitch;    ///< 目标 pitch，单位：rad
+  };
+
+  /**
+   * @brief 推进一个仿真步长
+   * @param dt 步长，单位：s
+   */
+  void Step(double dt);
+
+  void SimulationThreadFunction();
+
+  Param param_;                                      ///< 模拟参数
+  std::string port_;                                 ///< 伪终端从端路径
+  int master_fd_{-1};                                ///< 伪终端主端文件描述符
+  std::thread thread_;                               ///< 模拟线程
+  std::atomic_bool stop_flag_{};                     ///< 模拟线程停止信号
+  std::atomic_uint64_t commands_{};                  ///< 已收到的指令数
+  std::mutex state_lock_;                            ///< 云台状态锁
+  std::array<Command, kCommandCapacity> pending_{};  ///< 等待生效的指令环形缓冲区
+  int pending_head_{};                               ///< 最早指令的下标
+  int pending_size_{};                               ///< 等待生效的指令数
+  std::array<double, 2> angle_{};                    ///< yaw、pitch 角度，yaw 不限范围，单位：rad
+  std::array<double, 2> velocity_{};                 ///< yaw、pitch 角速度，单位：rad/s
+  std::array<double, 2> target_{};                   ///< 已生效的 yaw、pitch 目标角度，单位：rad
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_GIMBAL_SIMULATOR_GIMBAL_SIMULATOR_H_
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <glog/logging.h>
+#include <opencv2/core/persistence.hpp>
+#include "latency-compensator.h"
+
+bool latency_compensator::Param::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage latency_config;
+  latency_config.open(config_file, cv::FileStorage::READ);
+  if (!latency_config.isOpened()) {
+    LOG(ERROR) << "Failed to open latency configuration file " << config_file << ".";
+    return false;
+  }
+  latency_config["LATENCY_ALPHA"] >> latency_alpha;
+  latency_config["INITIAL_LATENCY"] >> initial_latency;
+  latency_config["MAX_LATENCY"] >> max_latency;
+  latency_config["EXPOSURE_DELAY"] >> exposure_delay;
+  latency_config["TRANSMISSION_DELAY"] >> transmission_delay;
+  latency_config["RATE_ALPHA"] >> rate_alpha;
+  latency_config["MAX_INTERVAL"] >> max_interval;
+  if (latency_alpha <= 0 || latency_alpha > 1 || rate_alpha <= 0 || rate_alpha > 1) {
+    LOG(ERROR) << "Invalid smoothing factors. They must be in (0, 1].";
+    return false;
+  }
+  if (initial_latency < 0 || max_latency <= initial_latency || exposure_delay < 0 || transmission_delay < 0
+      || max_interval <= 0) {
+    LOG(ERROR) << "Invalid latency configurations. Delays must not be negative "
+               << "and max latency must be greater than initial latency.";
+    return false;
+  }
+  return true;
+}
+
+bool latency_compensator::LatencyCompensator::Initialize(std::string REF_IN config_file) {
+  if (!param_.Initialize(config_file)) {
+    LOG(ERROR) << "Failed to read latency compensator configurations.";
+    return false;
+  }
+  latency_ = param_.initial_latency;
+  samples_ = 0;
+  rate_.setZero();
+  attitude_valid_ = false;
+  LOG(INFO) << "Initialized latency compensator with initial command delay " << CommandDelay() * 1e3 << " ms.";
+  return true;
+}
+
+void latency_compensator::LatencyCompensator::RecordLatency(uint64_t receive_time, uint64_t write_time) {
+  double latency = static_cast<double>(static_cast<int64_t>(write_time - receive_time)) * 1e-9;
+  if (latency < 0) return;
+  history_[samples_ % kHistory] = latency;
+  ++samples_;
+  // 偶发卡顿只体现在分位数中，不拉高下一帧的估计
+  if (latency > param_.max_latency) return;
+  latency_ = samples_ == 1 ? latency : latency_ + param_.latency_alpha * (latency - latency_);
+}
+
+double latency_compensator::LatencyCompensator::Percentile(double percent) const {
+  if (!samples_) return param_.initial_latency;
+  auto size = static_cast<size_t>(std::min<uint64_t>(samples_, kHistory));
+  std::array<double, kHistory> sorted;
+  std::copy_n(history_.begin(), size, sorted.begin());
+  auto rank = static_cast<size_t>(std::round(std::clamp(percent, 0., 100.) / 100 * static_cast<double>(size - 1)));
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + size);
+  return sorted[rank];
+}
+
+void latency_compensator::LatencyCompensator::UpdateAttitude(coordinate::EAngle REF_IN attitude,
+                                                             uint64_t time_stamp) {
+  double interval = static_cast<double>(static_cast<int64_t>(time_stamp - attitude_time_stamp_)) * 1e-9;
+  if (attitude_valid_ && interval > 0 && interval <= param_.max_interval) {
+    // 角度差折算到 [-π, π]，避免 yaw 跨越 ±π 时产生虚假的角速度
+    coordinate::EAngle rate;
+    for (auto k = 0; k < 3; ++k) rate[k] = std::remainder(attitude[k] - attitude_[k], 2 * M_PI) / interval;
+    rate_ += param_.rate_alpha * (rate - rate_);
+  } else if (!attitude_valid_ || interval > param_.max_interval)
+    rate_.setZero();
+  else return;
+  attitude_ = attitude;
+  attitude_time_stamp_ = time_stamp;
+  attitude_valid_ = true;
+}
+
+double latency_compensator::LatencyCompensator::CommandDelay() const {
+  return param_.exposure_delay + latency_ + param_.transmission_delay;
+}
+
+coordinate::EAngle latency_compensator::LatencyCompensator::PredictAttitude(coordinate::EAngle REF_IN attitude,
+                                                                            double lead_time) const {
+  return attitude + rate_ * lead_time;
+}
@@ -0,0 +1,107 @@
+#ifndef SRM_IC_2023_MODULES_LATENCY_COMPENSATOR_LATENCY_COMPENSATOR_H_
+#define SRM_IC_2023_MODULES_LATENCY_COMPENSATOR_LATENCY_COMPENSATOR_H_
+
+#include <array>
+#include "coordinate/coordinate.h"
+
+namespace latency_compensator {
+constexpr int kHistory = 256;  ///< 计算延迟分位数所保留的最近样本数
+
+/// 延迟补偿参数
+struct Param {
+  double latency_alpha{};       ///< 处理延迟指数滑动平均的新样本权重，取值 (0, 1]
+  double initial_latency{};     ///< 尚无测量时使用的处理延迟，单位：s
+  double max_latency{};         ///< 超过此值的处理延迟视为偶发卡顿，不计入滑动平均，单位：s
+  double exposure_delay{};      ///< 曝光到主机收到帧的固定延迟，主机无法测量，单位：s
+  double transmission_delay{};  ///< 写入串口到云台开始执行指令的固定延迟，单位：s
+  double rate_alpha{};          ///< 云台角速度指数滑动平均的新样本权重，取值 (0, 1]
+  double max_interval{};        ///< 相邻姿态超过此间隔时重新估计角速度，单位：s
+
+  /**
+   * @brief 从配置文件读取参数
+   * @param [in] config_file 配置文件路径
+   * @return 是否读取成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+};
+
+/**
+ * @brief 瞄准延迟补偿器，在线测量处理延迟并估计云台角速度，将目标与自身姿态外推到指令生效及弹丸命中的时刻
+ * @details 每次写入串口时以主机时钟记录从收到帧到写入的处理延迟，以指数滑动平均作为下一帧的估计，
+ *   并保留最近 kHistory 个样本用于计算分位数；总提前量为曝光延迟、处理延迟、传输延迟与弹丸飞行时间之和；
+ *   云台角速度由相邻帧的串口姿态差分并滑动平均得到；所有操作不分配内存
+ */
+class LatencyCompensator final {
+ public:
+  LatencyCompensator() = default;
+  ~LatencyCompensator() = default;
+
+  /// 处理延迟的指数滑动平均，单位：s
+  attr_reader_val(latency_, Latency)
+  /// 累计记录的处理延迟样本数
+  attr_reader_val(samples_, Samples)
+  /// 云台角速度估计，依次为：roll、yaw、pitch，单位：rad/s
+  attr_reader_ref(rate_, Rate)
+
+  /**
+   * @brief 初始化补偿器
+   * @param [in] config_file 配置文件路径
+   * @return 是否初始化成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+
+  /**
+   * @brief 记录一次处理延迟
+   * @param receive_time 主机收到帧的时间，单位：ns
+   * @param write_time 写入串口的时间，单位：ns，与 receive_time 同为 Frame::HostTime() 时钟
+   */
+  void RecordLatency(uint64_t receive_time, uint64_t write_time);
+
+  /**
+   * @brief 计算最近样本中处理延迟的分位数
+   * @param percent 百分位，取值 [0, 100]
+   * @return 处理延迟，单位：s，尚无样本时为初始值
+   */
+  [[nodiscard]] double Percentile(double percent) const;
+
+  /**
+   * @brief 以一帧的云台姿态更新角速度估计
+   * @param [in] attitude 云台姿态欧拉角
+   * @param time_stamp 帧时间戳，单位：ns
+   */
+  void UpdateAttitude(coordinate::EAngle REF_IN attitude, uint64_t time_stamp);
+
+  /**
+   * @brief 计算从曝光到指令生效的时间
+   * @return 曝光延迟、处理延迟与传输延迟之和，单位：s
+   */
+  [[nodiscard]] double CommandDelay() const;
+
+  /**
+   * @brief 计算目标位置需要外推的时间
+   * @param flight_time 弹丸飞行时间，即 BallisticInfo::t，单位：s
+   * @return 从曝光到弹丸命中的时间，单位：s
+   */
+  [[nodiscard]] double LeadTime(double flight_time) const { return CommandDelay() + flight_time; }
+
+  /**
+   * @brief 按角速度估计外推云台姿态
+   * @param [in] attitude 当前云台姿态欧拉角
+   * @param lead_time 外推时间，单位：s
+   * @return 外推后的云台姿态欧拉角
+   */
+  [[nodiscard]] coordinate::EAngle PredictAttitude(coordinate::EAngle REF_IN attitude, double lead_time) const;
+
+ private:
+  Param param_;                             ///< 补偿参数
+  double latency_{};                        ///< 处理延迟的指数滑动平均，单位：s
+  uint64_t samples_{};                      ///< 累计记录的处理延迟样本数
+  std::array<double, kHistory> history_{};  ///< 最近的处理延迟样本环形缓冲区，单位：s
+  coordinate::EAngle attitude_;             ///< 上一帧的云台姿态
+  uint64_t attitude_time_stamp_{};          ///< 上一帧的时间戳，单位：ns
+  bool attitude_valid_{};                   ///< 是否已记录上一帧的姿态
+  coordinate::EAngle rate_;                 ///< 云台角速度估计，单位：rad/s
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_LATENCY_COMPENSATOR_LATENCY_COMPENSATOR_H_
@@ -0,0 +1,183 @@
+#include <glog/logging.h>
+#include <opencv2/core/persistence.hpp>
+#include "outpost-predictor.h"
+
+namespace {
+/**
+ * @brief 计算两个时间戳之间的间隔
+ * @param from 起始时间戳，单位：ns
+ * @param to 终止时间戳，单位：ns
+ * @return 时间间隔，单位：s，终止时间早于起始时间时为负
+ */
+inline double Interval(uint64_t from, uint64_t to) {
+  return static_cast<double>(static_cast<int64_t>(to - from)) * 1e-9;
+}
+}
+
+bool outpost_predictor::Param::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage outpost_config;
+  outpost_config.open(config_file, cv::FileStorage::READ);
+  if (!outpost_config.isOpened()) {
+    LOG(ERROR) << "Failed to open outpost configuration file " << config_file << ".";
+    return false;
+  }
+  outpost_config["RADIUS"] >> radius;
+  outpost_config["PLATES"] >> plates;
+  outpost_config["WINDOW"] >> window;
+  outpost_config["MAX_GAP"] >> max_gap;
+  outpost_config["MIN_SAMPLES"] >> min_samples;
+  outpost_config["MAX_RESIDUAL"] >> max_residual;
+  outpost_config["MIN_SPEED"] >> min_speed;
+  outpost_config["HIT_ANGLE"] >> hit_angle;
+  if (radius <= 0 || plates <= 0 || window <= 0 || max_gap <= 0 || min_samples < 2 || min_samples > kCapacity
+      || max_residual <= 0 || min_speed < 0) {
+    LOG(ERROR) << "Invalid outpost configurations. At least 2 and at most " << kCapacity
+               << " samples are allowed for fitting.";
+    return false;
+  }
+  if (hit_angle <= 0 || hit_angle >= M_PI / plates) {
+    LOG(ERROR) << "Invalid hit angle " << hit_angle << ". It must be positive and less than half the plate interval.";
+    return false;
+  }
+  return true;
+}
+
+bool outpost_predictor::OutpostPredictor::Initialize(std::string REF_IN config_file) {
+  if (!param_.Initialize(config_file)) {
+    LOG(ERROR) << "Failed to read outpost predictor configurations.";
+    return false;
+  }
+  step_ = 2 * M_PI / param_.plates;
+  Clear();
+  LOG(INFO) << "Initialized outpost predictor with " << param_.plates << " plates.";
+  return true;
+}
+
+void outpost_predictor::OutpostPredictor::Update(Armor REF_IN armor,
+                                                 coordinate::CoordSolver REF_IN coord_solver,
+                                                 coordinate::EAngle REF_IN euler_angle,
+                                                 uint64_t time_stamp) {
+  // 装甲板自身坐标系的 z 轴垂直于板面、指向旋转轴，经相机坐标系转换到世界坐标系
+  auto ctv_normal = coord_solver.CamToWorld(
+      armor.CTVecCam() + coordinate::CoordSolver::EAngleToRMat(armor.EAngleCam()).col(2),
+      coordinate::CoordSolver::EAngleToRMat(euler_angle)) - armor.CTVecWorld();
+  Update(armor.CTVecWorld(), std::atan2(ctv_normal.x(), ctv_normal.z()), time_stamp);
+}
+
+void outpost_predictor::OutpostPredictor::Update(coordinate::CTVec REF_IN ctv_plate,
+                                                 double yaw,
+                                                 uint64_t time_stamp) {
+  if (size_) {
+    if (time_stamp <= origin_time_) return;
+    if (Interval(origin_time_, time_stamp) > param_.max_gap) Clear();
+  }
+  // 旋转中心须由实际的法线朝向推算，在展开朝向之前计算
+  coordinate::CTVec ctv_axis = ctv_plate + param_.radius * coordinate::CTVec(std::sin(yaw), 0, std::cos(yaw));
+  // 各装甲板相隔 step_，以拟合值（观测不足时以上一次观测）为参考展开，使切换装甲板时朝向保持连续
+  if (size_) {
+    double reference = origin_yaw_ + phase_ + speed_ * Interval(origin_time_, time_stamp);
+    yaw += step_ * std::round((reference - yaw) / step_);
+  }
+
+  // 移出超出时间窗口的观测，缓冲区已满时移出最早的观测
+  while (size_ && (size_ == kCapacity || Interval(ring_[head_].time_stamp, time_stamp) > param_.window)) {
+    auto &&sample = ring_[head_];
+    double t = Interval(origin_time_, sample.time_stamp), y = sample.yaw - origin_yaw_;
+    sum_t_ -= t;
+    sum_y_ -= y;
+    sum_tt_ -= t * t;
+    sum_ty_ -= t * y;
+    sum_yy_ -= y * y;
+    sum_axis_ -= sample.ctv_axis;
+    head_ = (head_ + 1) % kCapacity;
+    --size_;
+  }
+
+  // 原点平移到新观测后，新观测对除数量与旋转中心以外的累加和没有贡献
+  if (size_) Rebase(time_stamp, yaw);
+  else {
+    origin_time_ = time_stamp;
+    origin_yaw_ = yaw;
+    sum_t_ = sum_y_ = sum_tt_ = sum_ty_ = sum_yy_ = 0;
+    sum_axis_.setZero();
+  }
+  auto &&sample = ring_[(head_ + size_) % kCapacity];
+  sample.time_stamp = time_stamp;
+  sample.yaw = yaw;
+  sample.ctv_axis = ctv_axis;
+  sum_axis_ += sample.ctv_axis;
+  ++size_;
+  Solve();
+}
+
+void outpost_predictor::OutpostPredictor::Clear() {
+  head_ = size_ = 0;
+  sum_t_ = sum_y_ = sum_tt_ = sum_ty_ = sum_yy_ = 0;
+  sum_axis_.setZero();
+  phase_ = speed_ = residual_ = 0;
+}
+
+bool outpost_predictor::OutpostPredictor::Converged() const {
+  return size_ >= param_.min_samples && residual_ <= param_.max_residual;
+}
+
+double outpost_predictor::OutpostPredictor::Yaw(uint64_t time_stamp) const {
+  return origin_yaw_ + phase_ + speed_ * Interval(origin_time_, time_stamp);
+}
+
+bool outpost_predictor::OutpostPredictor::Predict(uint64_t time_stamp,
+                                                  double flight_time,
+                                                  FireWindow REF_OUT fire_window) const {
+  if (!Converged()) return false;
+  // 正对射手的装甲板法线沿射手到旋转中心的视线方向
+  coordinate::CTVec ctv_axis = sum_axis_ / size_;
+  double line_of_sight = std::atan2(ctv_axis.x(), ctv_axis.z());
+  fire_window.ctv_aim = ctv_axis - param_.radius * coordinate::CTVec(std::sin(line_of_sight), 0,
+                                                                      std::cos(line_of_sight));
+  auto hit_time = time_stamp + static_cast<uint64_t>(flight_time * 1e9);
+  // 命中时最近的装甲板偏离视线的角度，沿旋转方向为正
+  double angle = std::remainder(Yaw(hit_time) - line_of_sight, step_);
+  if (std::abs(speed_) < param_.min_speed) {
+    if (std::abs(angle) > param_.hit_angle) return false;
+    fire_window.begin = time_stamp;
+    fire_window.end = std::numeric_limits<uint64_t>::max();
+    fire_window.facing_time = hit_time;
+    return true;
+  }
+  double speed = std::abs(speed_);
+  if (speed_ < 0) angle = -angle;
+  // 当前装甲板已转过命中范围时等待下一块装甲板
+  if (angle > param_.hit_angle) angle -= step_;
+  auto offset = [&](double target_angle) {
+    return static_cast<int64_t>((target_angle - angle) / speed * 1e9);
+  };
+  fire_window.begin = time_stamp + std::max<int64_t>(offset(-param_.hit_angle), 0);
+  fire_window.end = time_stamp + offset(param_.hit_angle);
+  fire_window.facing_time = hit_time + offset(0);
+  return true;
+}
+
+void outpost_predictor::OutpostPredictor::Rebase(uint64_t time_stamp, double yaw) {
+  double n = size_, dt = Interval(origin_time_, time_stamp), dy = yaw - origin_yaw_;
+  sum_tt_ += n * dt * dt - 2 * dt * sum_t_;
+  sum_ty_ += n * dt * dy - dt * sum_y_ - dy * sum_t_;
+  sum_yy_ += n * dy * dy - 2 * dy * sum_y_;
+  sum_t_ -= n * dt;
+  sum_y_ -= n * dy;
+  origin_time_ = time_stamp;
+  origin_yaw_ = yaw;
+}
+
+void outpost_predictor::OutpostPredictor::Solve() {
+  double n = size_, denominator = n * sum_tt_ - sum_t_ * sum_t_;
+  // 观测不足两个时间点时只能给出朝向，转速视为 0
+  if (size_ < 2 || denominator <= 0) {
+    speed_ = 0;
+    phase_ = sum_y_ / n;
+    residual_ = 0;
+    return;
+  }
+  speed_ = (n * sum_ty_ - sum_t_ * sum_y_) / denominator;
+  phase_ = (sum_y_ - speed_ * sum_t_) / n;
+  residual_ = std::sqrt(std::max(sum_yy_ - phase_ * sum_y_ - speed_ * sum_ty_, 0.) / n);
+}
@@ -0,0 +1,147 @@
+#ifndef SRM_IC_2023_MODULES_OUTPOST_PREDICTOR_OUTPOST_PREDICTOR_H_
+#define SRM_IC_2023_MODULES_OUTPOST_PREDICTOR_OUTPOST_PREDICTOR_H_
+
+#include <array>
+#include "common/armor.h"
+
+namespace outpost_predictor {
+constexpr int kCapacity = 512;  ///< 观测环形缓冲区容量
+
+/// 前哨站预测器参数
+struct Param {
+  double radius{};        ///< 装甲板中心到旋转轴的距离，单位：m
+  int plates{};           ///< 均匀分布的装甲板数量
+  double window{};        ///< 参与拟合的观测时间跨度，单位：s
+  double max_gap{};       ///< 观测中断超过此时间后重新拟合，单位：s
+  int min_samples{};      ///< 输出预测所需的最少观测数
+  double max_residual{};  ///< 输出预测所允许的最大拟合残差均方根，单位：rad
+  double min_speed{};     ///< 低于此转速视为静止，单位：rad/s
+  double hit_angle{};     ///< 命中时装甲板法线偏离视线的最大角度，单位：rad
+
+  /**
+   * @brief 从配置文件读取参数
+   * @param [in] config_file 配置文件路径
+   * @return 是否读取成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+};
+
+/// 开火窗口
+struct FireWindow {
+  uint64_t begin;             ///< 窗口开始的发射时间戳，单位：ns
+  uint64_t end;               ///< 窗口结束的发射时间戳，单位：ns，静止目标为 UINT64_MAX
+  uint64_t facing_time;       ///< 装甲板正对射手的时间戳，单位：ns
+  coordinate::CTVec ctv_aim;  ///< 正对射手的装甲板中心的世界坐标系直角坐标
+};
+
+/**
+ * @brief 旋转前哨站装甲板的相位与转速预测器
+ * @details 以装甲板法线在水平面内的朝向为观测，按装甲板间隔展开为连续的旋转角，
+ *   在定长的环形缓冲区上以滑动窗口最小二乘拟合 θ(t) = θ0 + ωt；
+ *   加入、移出观测时增量更新累加和，并以最新观测为原点平移累加和以保持数值精度，每次更新耗时 O(1)、不分配内存；
+ *   旋转中心由每次观测的装甲板位置沿法线平移旋转半径得到，在同一窗口内取平均
+ */
+class OutpostPredictor final {
+ public:
+  OutpostPredictor() = default;
+  ~OutpostPredictor() = default;
+
+  /// 窗口内的观测数量
+  attr_reader_val(size_, Size)
+  /// 拟合的转速，单位：rad/s，俯视顺时针为正
+  attr_reader_val(speed_, Speed)
+  /// 拟合残差的均方根，单位：rad
+  attr_reader_val(residual_, Residual)
+
+  /**
+   * @brief 初始化预测器
+   * @param [in] config_file 配置文件路径
+   * @return 是否初始化成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+
+  /**
+   * @brief 以一块装甲板的识别结果更新预测器
+   * @param [in] armor 前哨站装甲板
+   * @param [in] coord_solver 坐标求解器
+   * @param [in] euler_angle 当前云台姿态欧拉角
+   * @param time_stamp 帧时间戳，单位：ns
+   */
+  void Update(Armor REF_IN armor,
+              coordinate::CoordSolver REF_IN coord_solver,
+              coordinate::EAngle REF_IN euler_angle,
+              uint64_t time_stamp);
+
+  /**
+   * @brief 以一次观测更新预测器
+   * @param [in] ctv_plate 装甲板中心的世界坐标系直角坐标
+   * @param yaw 装甲板指向旋转轴的法线在世界坐标系水平面内的朝向 atan2(x, z)，单位：rad
+   * @param time_stamp 观测时间戳，单位：ns，早于上一次观测时忽略
+   */
+  void Update(coordinate::CTVec REF_IN ctv_plate, double yaw, uint64_t time_stamp);
+
+  /// 清除全部观测
+  void Clear();
+
+  /**
+   * @brief 拟合结果是否可用于预测
+   * @return 观测数量与残差满足要求时为 true
+   */
+  [[nodiscard]] bool Converged() const;
+
+  /**
+   * @brief 计算任意时间的装甲板朝向，不改变预测器状态
+   * @param time_stamp 目标时间戳，单位：ns
+   * @return 展开后的装甲板法线朝向，单位：rad
+   */
+  [[nodiscard]] double Yaw(uint64_t time_stamp) const;
+
+  /**
+   * @brief 计算从指定时间开始的下一个开火窗口
+   * @details 发射后经过 flight_time 命中，命中时最近的装甲板法线与视线夹角不超过 hit_angle 的发射时间构成开火窗口；
+   *   窗口已经打开时 begin 为 time_stamp
+   * @param time_stamp 当前时间戳，单位：ns
+   * @param flight_time 从发射到命中的时间，包含发射延迟，单位：s
+   * @param [out] fire_window 开火窗口
+   * @return 是否存在开火窗口，未收敛或静止目标未正对射手时为 false
+   */
+  bool Predict(uint64_t time_stamp, double flight_time, FireWindow REF_OUT fire_window) const;
+
+ private:
+  /// 单次观测
+  struct Sample {
+    uint64_t time_stamp;         ///< 观测时间戳，单位：ns
+    double yaw;                  ///< 展开后的装甲板法线朝向，单位：rad
+    coordinate::CTVec ctv_axis;  ///< 由本次观测推算的旋转中心
+  };
+
+  /**
+   * @brief 将累加和的原点平移到指定的时间与角度
+   * @param time_stamp 新的时间原点，单位：ns
+   * @param yaw 新的角度原点，单位：rad
+   */
+  void Rebase(uint64_t time_stamp, double yaw);
+
+  /// 由累加和求解拟合参数与残差
+  void Solve();
+
+  Param param_;                           ///< 预测器参数
+  double step_{};                         ///< 相邻装甲板的角度间隔，单位：rad
+  std::array<Sample, kCapacity> ring_{};  ///< 观测环形缓冲区
+  int head_{};                            ///< 最早观测的下标
+  int size_{};                            ///< 窗口内的观测数量
+  uint64_t origin_time_{};                ///< 累加和的时间原点，即最新观测的时间戳，单位：ns
+  double origin_yaw_{};                   ///< 累加和的角度原点，单位：rad
+  double sum_t_{};                        ///< Σt，t 相对时间原点，单位：s
+  double sum_y_{};                        ///< Σθ，θ 相对角度原点
+  double sum_tt_{};                       ///< Σt^2
+  double sum_ty_{};                       ///< Σtθ
+  double sum_yy_{};                       ///< Σθ^2
+  coordinate::CTVec sum_axis_;            ///< 旋转中心之和
+  double phase_{};                        ///< 拟合的时间原点处朝向，相对角度原点，单位：rad
+  double speed_{};                        ///< 拟合的转速，单位：rad/s
+  double residual_{};                     ///< 拟合残差的均方根，单位：rad
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_OUTPOST_PREDICTOR_OUTPOST_PREDICTOR_H_
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cstring>
+#include "common/syntactic-sugar.h"
+#include "lz4.h"
+
+namespace {
+constexpr int kHashBits = 12;         ///< 匹配哈希表位数
+constexpr size_t kMinMatch = 4;       ///< 最短匹配长度
+constexpr size_t kLastLiterals = 5;   ///< 块末尾必须为字面量的字节数
+constexpr size_t kMatchLimit = 12;    ///< 最后一次匹配须在块末尾此字节数之前开始
+constexpr size_t kMaxOffset = 65535;  ///< 最大匹配距离
+constexpr uint8_t kLengthMask = 15;   ///< 标记字节中长度字段的最大值
+
+uint32_t Read32(const uint8_t *data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint64_t Read64(const uint8_t *data) {
+  uint64_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kHashBits);
+}
+
+/// 写入长度字段超出标记字节部分的扩展字节
+void WriteLength(uint8_t *&output, size_t length) {
+  for (; length >= 255; length -= 255) *output++ = 255;
+  *output++ = static_cast<uint8_t>(length);
+}
+
+/// 读取长度字段的扩展字节，数据不足时返回 false
+bool ReadLength(const uint8_t *&input, const uint8_t *input_end, size_t REF_OUT length) {
+  uint8_t byte;
+  do {
+    if (input == input_end) return false;
+    byte = *input++;
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+/**
+ * @brief 写入一个序列
+ * @param [in, out] output 输出位置，写入后后移
+ * @param output_end 输出缓冲区结尾
+ * @param [in] literals 字面量首地址
+ * @param literal_length 字面量字节数
+ * @param offset 匹配距离
+ * @param match_length 匹配长度，为 0 时为块的最后一个序列，只有字面量
+ * @return 输出缓冲区是否足够
+ */
+bool WriteSequence(uint8_t *&output, const uint8_t *output_end, const uint8_t *literals, size_t literal_length,
+                   size_t offset, size_t match_length) {
+  if (static_cast<size_t>(output_end - output) < literal_length + literal_length / 255 + match_length / 255 + 8)
+    return false;
+  auto token = output++;
+  *token = static_cast<uint8_t>(std::min<size_t>(literal_length, kLengthMask) << 4);
+  if (literal_length >= kLengthMask) WriteLength(output, literal_length - kLengthMask);
+  memcpy(output, literals, literal_length);
+  output += literal_length;
+  if (!match_length) return true;
+  *output++ = static_cast<uint8_t>(offset);
+  *output++ = static_cast<uint8_t>(offset >> 8);
+  match_length -= kMinMatch;
+  *token |= static_cast<uint8_t>(std::min<size_t>(match_length, kLengthMask));
+  if (match_length >= kLengthMask) WriteLength(output, match_length - kLengthMask);
+  return true;
+}
+}
+
+size_t raw_recording::lz4::Compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity) {
+  auto output = dst, output_end = dst + capacity;
+  size_t anchor = 0;
+  if (size > kMatchLimit) {
+    // 哈希表只保存位置，取到的候选总在当前位置之前，逐字节比较确认匹配
+    uint32_t table[1 << kHashBits]{};
+    const size_t match_limit = size - kMatchLimit, end_limit = size - kLastLiterals;
+    size_t position = 1;
+    while (position < match_limit) {
+      auto sequence = Read32(src + position);
+      auto &&slot = table[Hash(sequence)];
+      size_t candidate = slot;
+      slot = static_cast<uint32_t>(position);
+      if (position - candidate > kMaxOffset || Read32(src + candidate) != sequence) {
+        // 越久没有匹配步长越大
+        position += 1 + ((position - anchor) >> 6);
+        continue;
+      }
+      while (position > anchor && candidate && src[position - 1] == src[candidate - 1]) --position, --candidate;
+      size_t length = kMinMatch;
+      while (position + length + sizeof(uint64_t) <= end_limit) {
+        auto diff = Read64(src + position + length) ^ Read64(src + candidate + length);
+        if (diff) {
+          length += __builtin_ctzll(diff) >> 3;
+          break;
+        }
+        length += sizeof(uint64_t);
+      }
+      if (position + length + sizeof(uint64_t) > end_limit)
+        while (position + length < end_limit && src[position + length] == src[candidate + length]) ++length;
+      if (!WriteSequence(output, output_end, src + anchor, position - anchor, position - candidate, length)) return 0;
+      position += length;
+      anchor = position;
+    }
+  }
+  if (!WriteSequence(output, output_end, src + anchor, size - anchor, 0, 0)) return 0;
+  return output - dst;
+}
+
+bool raw_recording::lz4::Decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t raw_size) {
+  auto input = src, input_end = src + size;
+  auto output = dst, output_end = dst + raw_size;
+  while (input < input_end) {
+    auto token = *input++;
+    size_t literal_length = token >> 4;
+    if (literal_length == kLengthMask && !ReadLength(input, input_end, literal_length)) return false;
+    if (literal_length > static_cast<size_t>(input_end - input)
+        || literal_length > static_cast<size_t>(output_end - output))
+      return false;
+    // 短字面量固定复制 16 字节，省去变长复制的分支
+    if (literal_length <= 16 && input_end - input >= 16 && output_end - output >= 16) memcpy(output, input, 16);
+    else memcpy(output, input, literal_length);
+    input += literal_length;
+    output += literal_length;
+    // 最后一个序列只有字面量
+    if (input == input_end) return output == output_end;
+    if (input_end - input < 2) return false;
+    size_t offset = input[0] | input[1] << 8;
+    input += 2;
+    size_t match_length = token & kLengthMask;
+    if (match_length == kLengthMask && !ReadLength(input, input_end, match_length)) return false;
+    match_length += kMinMatch;
+    if (!offset || offset > static_cast<size_t>(output - dst)
+        || match_length > static_cast<size_t>(output_end - output))
+      return false;
+    auto match = output - offset;
+    if (offset >= sizeof(uint64_t) && static_cast<size_t>(output_end - output) >= match_length + sizeof(uint64_t)) {
+      // 距离不小于 8 字节时按 8 字节复制，允许越过匹配结尾写入，之后的数据会覆盖多写的部分
+      for (size_t copied = 0; copied < match_length; copied += sizeof(uint64_t))
+        memcpy(output + copied, match + copied, sizeof(uint64_t));
+    } else {
+      // 距离小于长度时匹配与输出重叠，以已复制部分为周期成倍扩展，每次复制的源与目标互不重叠
+      for (size_t copied = 0, count; copied < match_length; copied += count) {
+        count = std::min(match_length - copied, copied + offset);
+        memcpy(output + copied, match, count);
+      }
+    }
+    output += match_length;
+  }
+  return output == output_end;
+}
@@ -0,0 +1,38 @@
+#ifndef SRM_IC_2023_MODULES_RAW_RECORDING_LZ4_H_
+#define SRM_IC_2023_MODULES_RAW_RECORDING_LZ4_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace raw_recording::lz4 {
+/**
+ * @brief 计算压缩结果的最大字节数
+ * @param size 原始数据字节数
+ * @return 最坏情况下的压缩结果字节数
+ */
+constexpr size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+/**
+ * @brief 以 LZ4 块格式压缩数据
+ * @details 单遍贪心匹配，输出与标准 LZ4 块格式兼容，可由 lz4 工具链解压；
+ *   连续无法匹配时逐渐增大步长，不可压缩的数据很快退化为字面量拷贝
+ * @param [in] src 原始数据首地址
+ * @param size 原始数据字节数
+ * @param [out] dst 压缩结果缓冲区
+ * @param capacity 压缩结果缓冲区字节数
+ * @return 压缩结果字节数，缓冲区不足时为 0
+ */
+size_t Compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity);
+
+/**
+ * @brief 解压 LZ4 块格式数据
+ * @param [in] src 压缩数据首地址
+ * @param size 压缩数据字节数
+ * @param [out] dst 解压缓冲区
+ * @param raw_size 原始数据字节数
+ * @return 是否解压成功，数据损坏或长度不符时为 false，不会越界读写
+ */
+bool Decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t raw_size);
+}
+
+#endif  // SRM_IC_2023_MODULES_RAW_RECORDING_LZ4_H_
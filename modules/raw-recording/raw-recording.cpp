@@ -0,0 +1,213 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <glog/logging.h>
+#include "lz4.h"
+#include "raw-recording.h"
+
+namespace {
+static_assert(std::is_trivially_copyable_v<raw_recording::ChunkHeader>, "Chunk headers are written as raw bytes.");
+
+/**
+ * @brief 阻塞写入全部字节
+ * @param fd 文件描述符
+ * @param [in] data 数据首地址
+ * @param size 数据字节数
+ * @return 是否写入成功
+ */
+bool WriteAll(int fd, const void *data, size_t size) {
+  auto bytes = static_cast<const uint8_t *>(data);
+  while (size) {
+    ssize_t write_count = write(fd, bytes, size);
+    if (write_count < 0 && errno == EINTR) continue;
+    if (write_count <= 0) return false;
+    bytes += write_count;
+    size -= write_count;
+  }
+  return true;
+}
+
+/**
+ * @brief 校验帧块头
+ * @param [in] data 文件内容首地址
+ * @param size 文件字节数
+ * @param offset 帧块的文件偏移
+ * @return 帧块是否完整且元数据自洽
+ */
+bool CheckChunk(const uint8_t *data, size_t size, uint64_t offset) {
+  using namespace raw_recording;
+  if (offset % kAlignment || offset < kFileHeaderSize || offset > size || size - offset < kChunkHeaderSize)
+    return false;
+  auto header = reinterpret_cast<const ChunkHeader *>(data + offset);
+  if (header->magic != kChunkMagic || header->rows <= 0 || header->cols <= 0 || header->bayer_pattern < -1
+      || header->bayer_pattern > static_cast<int32_t>(simd::BayerPattern::BG))
+    return false;
+  if (header->raw_size != static_cast<uint64_t>(header->rows) * header->cols * CV_ELEM_SIZE(header->type))
+    return false;
+  if (header->data_size > size - offset - kChunkHeaderSize) return false;
+  return header->codec == Codec::LZ4 || (header->codec == Codec::NONE && header->data_size == header->raw_size);
+}
+}
+
+bool raw_recording::ReadIndex(const uint8_t *data, size_t size, std::vector<IndexEntry> REF_OUT index) {
+  index.clear();
+  if (size < kFileHeaderSize) {
+    LOG(ERROR) << "Recording is too small to contain a file header.";
+    return false;
+  }
+  auto header = reinterpret_cast<const FileHeader *>(data);
+  if (header->magic != kMagic || header->chunk_header != sizeof(ChunkHeader)) {
+    LOG(ERROR) << "Recording has an unknown format or chunk header size " << header->chunk_header << ".";
+    return false;
+  }
+  if (header->index_offset && header->index_offset <= size
+      && (size - header->index_offset) / sizeof(IndexEntry) >= header->frames) {
+    auto entries = reinterpret_cast<const IndexEntry *>(data + header->index_offset);
+    index.assign(entries, entries + header->frames);
+  } else {
+    // 录制中断，没有索引，顺序扫描帧块
+    LOG(WARNING) << "Recording was not closed properly. Rebuilding index from frame chunks.";
+    for (uint64_t offset = kFileHeaderSize; CheckChunk(data, size, offset);) {
+      auto chunk = reinterpret_cast<const ChunkHeader *>(data + offset);
+      index.push_back({offset, chunk->time_stamp});
+      offset += kChunkHeaderSize + AlignUp(chunk->data_size);
+    }
+  }
+  for (auto &&entry : index)
+    if (!CheckChunk(data, size, entry.offset)) {
+      LOG(ERROR) << "Corrupted frame chunk at offset " << entry.offset << ".";
+      index.clear();
+      return false;
+    }
+  return true;
+}
+
+raw_recording::RawWriter::~RawWriter() {
+  Close();
+}
+
+bool raw_recording::RawWriter::Open(std::string REF_IN file, bool compress) {
+  if (recording_) return false;
+  fd_ = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ == -1) {
+    LOG(ERROR) << "Failed to create raw recording file " << file << ".";
+    return false;
+  }
+  // 文件头在关闭时补写帧数与索引位置
+  uint8_t header[kFileHeaderSize]{};
+  FileHeader file_header{kMagic, sizeof(ChunkHeader), 0, 0, 0};
+  memcpy(header, &file_header, sizeof(FileHeader));
+  if (!WriteAll(fd_, header, kFileHeaderSize)) {
+    LOG(ERROR) << "Failed to write raw recording file header to " << file << ".";
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  file_ = file;
+  compress_ = compress;
+  offset_ = kFileHeaderSize;
+  index_.clear();
+  dropped_ = 0;
+  stop_flag_ = false;
+  thread_ = std::thread(&RawWriter::WritingThreadFunction, this);
+  recording_ = true;
+  LOG(INFO) << "Recording raw frames to " << file << (compress ? " with LZ4 compression." : ".");
+  return true;
+}
+
+void raw_recording::RawWriter::Write(Frame REF_IN frame) {
+  if (!recording_) return;
+  Entry entry;
+  if (!frame.bayer.empty()) {
+    entry.image = frame.bayer;
+    entry.bayer_pattern = static_cast<int32_t>(frame.bayer_pattern);
+  } else {
+    entry.image = frame.image.clone();
+    entry.bayer_pattern = -1;
+  }
+  entry.time_stamp = frame.time_stamp;
+  entry.receive_time = frame.receive_time;
+  entry.receive_packet = frame.receive_packet;
+  {
+    std::lock_guard<std::mutex> lock(queue_lock_);
+    if (stop_flag_ || queue_.size() >= kQueueCapacity) {
+      ++dropped_;
+      return;
+    }
+    queue_.push_back(std::move(entry));
+  }
+  queue_cv_.notify_one();
+}
+
+void raw_recording::RawWriter::Close() {
+  if (!recording_.exchange(false)) return;
+  // 已通过检查的 Write() 在队列锁内入队或丢弃，写入线程退出前写完队列中的帧
+  {
+    std::lock_guard<std::mutex> lock(queue_lock_);
+    stop_flag_ = true;
+  }
+  queue_cv_.notify_one();
+  if (thread_.joinable()) thread_.join();
+  FileHeader file_header{kMagic, sizeof(ChunkHeader), 0, index_.size(), offset_};
+  if (!WriteAll(fd_, index_.data(), index_.size() * sizeof(IndexEntry))
+      || pwrite(fd_, &file_header, sizeof(FileHeader), 0) != sizeof(FileHeader))
+    LOG(ERROR) << "Failed to write index of raw recording " << file_ << ".";
+  close(fd_);
+  fd_ = -1;
+  LOG(INFO) << "Closed raw recording " << file_ << " with " << index_.size() << " frames and " << dropped_
+            << " dropped frames.";
+}
+
+bool raw_recording::RawWriter::WriteChunk(Entry REF_IN entry) {
+  auto image = entry.image.isContinuous() ? entry.image : entry.image.clone();
+  ChunkHeader header{kChunkMagic, Codec::NONE, image.rows, image.cols, image.type(), entry.bayer_pattern,
+                     entry.time_stamp, entry.receive_time, 0, image.total() * image.elemSize(),
+                     entry.receive_packet};
+  const uint8_t *data = image.data;
+  header.data_size = header.raw_size;
+  if (compress_) {
+    compress_buffer_.resize(lz4::CompressBound(header.raw_size));
+    // 输出上限为原图大小，不可压缩的帧尽早放弃
+    auto size = lz4::Compress(image.data, header.raw_size, compress_buffer_.data(), header.raw_size);
+    if (size) {
+      header.codec = Codec::LZ4;
+      header.data_size = size;
+      data = compress_buffer_.data();
+    }
+  }
+  uint8_t chunk_header[kChunkHeaderSize]{}, padding[kAlignment]{};
+  memcpy(chunk_header, &header, sizeof(ChunkHeader));
+  auto padding_size = AlignUp(header.data_size) - header.data_size;
+  if (!WriteAll(fd_, chunk_header, kChunkHeaderSize) || !WriteAll(fd_, data, header.data_size)
+      || !WriteAll(fd_, padding, padding_size))
+    return false;
+  index_.push_back({offset_, entry.time_stamp});
+  offset_ += kChunkHeaderSize + header.data_size + padding_size;
+  return true;
+}
+
+void raw_recording::RawWriter::WritingThreadFunction() {
+  Entry entry;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(queue_lock_);
+      queue_cv_.wait(lock, [this] { return stop_flag_ || !queue_.empty(); });
+      // 停止时先写完队列中剩余的帧
+      if (queue_.empty()) return;
+      entry = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    if (!WriteChunk(entry)) {
+      LOG(ERROR) << "Failed to write frame to raw recording " << file_ << ". Recording stopped.";
+      // 丢弃写了一半的帧块，索引接在最后一个完整的帧块之后
+      if (lseek(fd_, static_cast<off_t>(offset_), SEEK_SET) == -1
+          || ftruncate(fd_, static_cast<off_t>(offset_)) == -1)
+        LOG(WARNING) << "Failed to discard incomplete frame chunk in " << file_ << ".";
+      std::lock_guard<std::mutex> lock(queue_lock_);
+      dropped_ += queue_.size() + 1;
+      queue_.clear();
+      stop_flag_ = true;
+      return;
+    }
+  }
+}
@@ -0,0 +1,149 @@
+#ifndef SRM_IC_2023_MODULES_RAW_RECORDING_RAW_RECORDING_H_
+#define SRM_IC_2023_MODULES_RAW_RECORDING_RAW_RECORDING_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/frame.h"
+
+namespace raw_recording {
+/**
+ * @brief 原始录像文件格式
+ * @details | 文件头 | 帧块 0 | 帧块 1 | ... | 索引 |，每个帧块为 | 帧块头 | 图像数据 |，
+ *   帧块与图像数据均按 kAlignment 字节对齐，未压缩的图像可直接在映射的文件上构造 cv::Mat；
+ *   索引与文件头中的帧数、索引位置在正常关闭时写入，录制中断的文件由回放端顺序扫描帧块重建索引
+ */
+constexpr uint64_t kMagic = 0x315741524D5253;  ///< 文件头魔数，小端序为 "SRMRAW1"
+constexpr uint32_t kChunkMagic = 0x4B4E4843;   ///< 帧块头魔数，小端序为 "CHNK"
+constexpr size_t kAlignment = 64;              ///< 帧块与图像数据的对齐字节数
+constexpr size_t kQueueCapacity = 64;          ///< 写入队列容量，写入线程落后超过此帧数时丢弃新帧
+
+/// 图像数据编码
+enum class Codec : uint32_t {
+  NONE = 0,  ///< 未压缩
+  LZ4 = 1,   ///< LZ4 块格式
+};
+
+/// 文件头
+struct FileHeader {
+  uint64_t magic;         ///< 魔数 kMagic
+  uint32_t chunk_header;  ///< sizeof(ChunkHeader)，用于检查版本
+  uint32_t reserved;      ///< 保留
+  uint64_t frames;        ///< 帧数，录制中断时为 0
+  uint64_t index_offset;  ///< 索引的文件偏移，录制中断时为 0
+};
+
+/// 帧块头，记录恢复 Frame 所需的全部元数据
+struct ChunkHeader {
+  uint32_t magic;                ///< 魔数 kChunkMagic
+  Codec codec;                   ///< 图像数据编码
+  int32_t rows;                  ///< 图像行数
+  int32_t cols;                  ///< 图像列数
+  int32_t type;                  ///< 图像的 OpenCV 类型
+  int32_t bayer_pattern;         ///< Bayer 阵列排列，彩色图像为 -1
+  uint64_t time_stamp;           ///< 帧时间戳，单位 ns
+  uint64_t receive_time;         ///< 录制时主机收到帧的时间，单位 ns
+  uint64_t data_size;            ///< 图像数据字节数
+  uint64_t raw_size;             ///< 解码后的图像字节数
+  ReceivePacket receive_packet;  ///< 串口接收的信息
+};
+
+/// 索引项
+struct IndexEntry {
+  uint64_t offset;      ///< 帧块的文件偏移
+  uint64_t time_stamp;  ///< 帧时间戳，单位 ns
+};
+
+/**
+ * @brief 向上对齐到 kAlignment 字节
+ * @param size 字节数
+ * @return 对齐后的字节数
+ */
+constexpr size_t AlignUp(size_t size) { return (size + kAlignment - 1) / kAlignment * kAlignment; }
+
+constexpr size_t kFileHeaderSize = AlignUp(sizeof(FileHeader));    ///< 文件头占用的字节数
+constexpr size_t kChunkHeaderSize = AlignUp(sizeof(ChunkHeader));  ///< 帧块头占用的字节数
+
+/**
+ * @brief 读取并校验录像文件的索引
+ * @details 文件未正常关闭时顺序扫描帧块重建索引，末尾不完整的帧块被忽略；所有帧块头均被校验，回放时无需再检查
+ * @param [in] data 文件内容首地址
+ * @param size 文件字节数
+ * @param [out] index 索引
+ * @return 是否读取成功
+ */
+bool ReadIndex(const uint8_t *data, size_t size, std::vector<IndexEntry> REF_OUT index);
+
+/**
+ * @brief 原始录像写入接口
+ * @details 录制相机输出的原始图像（Bayer 或 BGR）与时间戳、串口信息，不含界面绘制，可在回放时逐位复现整个处理流程；
+ *   Write() 只把帧放入队列，压缩与写入在后台线程完成
+ */
+class RawWriter final {
+ public:
+  RawWriter() = default;
+  ~RawWriter();
+
+  /**
+   * @brief 获取因写入线程落后而丢弃的帧数
+   * @return 帧数
+   */
+  [[nodiscard]] uint64_t Dropped() const { return dropped_; }
+
+  /**
+   * @brief 创建录像文件
+   * @param [in] file 文件名
+   * @param compress 是否以 LZ4 压缩图像，压缩后不小于原图的帧仍按原样保存
+   * @return 是否创建成功
+   */
+  bool Open(std::string REF_IN file, bool compress);
+
+  /**
+   * @brief 录制一帧，未打开时忽略
+   * @details Bayer 帧与相机共享原始图像数据，不复制；彩色帧会被界面绘制修改，复制后再放入队列
+   * @param [in] frame 帧数据
+   */
+  void Write(Frame REF_IN frame);
+
+  /// 写完队列中的帧与索引后关闭文件
+  void Close();
+
+ private:
+  /// 等待写入的帧
+  struct Entry {
+    cv::Mat image;                 ///< 原始图像
+    int32_t bayer_pattern;         ///< Bayer 阵列排列，彩色图像为 -1
+    uint64_t time_stamp;           ///< 帧时间戳，单位 ns
+    uint64_t receive_time;         ///< 主机收到帧的时间，单位 ns
+    ReceivePacket receive_packet;  ///< 串口接收的信息
+  };
+
+  /**
+   * @brief 压缩并写入一个帧块
+   * @param [in] entry 待写入的帧
+   * @return 是否写入成功
+   */
+  bool WriteChunk(Entry REF_IN entry);
+
+  void WritingThreadFunction();
+
+  std::string file_;                      ///< 文件名
+  int fd_{-1};                            ///< 文件描述符
+  bool compress_{};                       ///< 是否压缩
+  uint64_t offset_{};                     ///< 下一个帧块的文件偏移
+  std::vector<IndexEntry> index_;         ///< 已写入帧块的索引
+  std::vector<uint8_t> compress_buffer_;  ///< 压缩缓冲区，尺寸不变时重复使用
+  std::deque<Entry> queue_;               ///< 写入队列
+  std::mutex queue_lock_;                 ///< 写入队列锁
+  std::condition_variable queue_cv_;      ///< 写入队列非空或停止的通知
+  bool stop_flag_{};                      ///< 写入线程停止信号，受 queue_lock_ 保护
+  std::thread thread_;                    ///< 写入线程
+  std::atomic<uint64_t> dropped_{};       ///< 丢弃的帧数
+  std::atomic_bool recording_{};          ///< 是否正在录制，Write() 在相机回调线程中只检查此标志，不访问 fd_
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_RAW_RECORDING_RAW_RECORDING_H_
@@ -0,0 +1,98 @@
+#include <dirent.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <tuple>
+#include <vector>
+#include <glog/logging.h>
+#include <opencv2/core/persistence.hpp>
+#include "device.h"
+
+namespace {
+constexpr int kMaxParentLevels = 4;  ///< 从 tty 设备向上查找 USB 设备的最大层数
+
+/**
+ * @brief 读取 sysfs 属性文件的第一个词
+ * @param [in] path 属性文件路径
+ * @return 属性值，文件不存在时为空
+ */
+std::string ReadAttribute(std::string REF_IN path) {
+  std::ifstream file(path);
+  std::string value;
+  file >> value;
+  return value;
+}
+
+/**
+ * @brief 忽略大小写比较十六进制 ID
+ * @param [in] expected 匹配条件，为空时匹配任意值
+ * @param [in] actual 设备的实际值
+ * @return 是否匹配
+ */
+bool MatchField(std::string REF_IN expected, std::string REF_IN actual) {
+  return expected.empty() || std::equal(expected.begin(), expected.end(), actual.begin(), actual.end(),
+                                        [](char a, char b) { return std::tolower(a) == std::tolower(b); });
+}
+}
+
+bool serial::DeviceFilter::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage serial_config;
+  serial_config.open(config_file, cv::FileStorage::READ);
+  if (!serial_config.isOpened()) {
+    LOG(ERROR) << "Failed to open serial configuration file " << config_file << ".";
+    return false;
+  }
+  serial_config["VENDOR_ID"] >> vendor_id;
+  serial_config["PRODUCT_ID"] >> product_id;
+  serial_config["SERIAL_NUMBER"] >> serial_number;
+  return true;
+}
+
+bool serial::IsSerialDeviceName(std::string REF_IN name) {
+  return name.rfind("ttyACM", 0) == 0 || name.rfind("ttyUSB", 0) == 0;
+}
+
+bool serial::ReadDeviceInfo(std::string REF_IN name, DeviceInfo REF_OUT info) {
+  // /sys/class/tty/<name>/device 指向 USB 接口，厂商与产品 ID 位于其上层的 USB 设备目录
+  char resolved[PATH_MAX];
+  if (!realpath(("/sys/class/tty/" + name + "/device").c_str(), resolved)) return false;
+  std::string path = resolved;
+  for (auto level = 0; level < kMaxParentLevels && path.size() > 1; ++level) {
+    info.vendor_id = ReadAttribute(path + "/idVendor");
+    if (!info.vendor_id.empty()) {
+      info.product_id = ReadAttribute(path + "/idProduct");
+      info.serial_number = ReadAttribute(path + "/serial");
+      return true;
+    }
+    path.erase(path.rfind('/'));
+  }
+  return false;
+}
+
+std::string serial::FindDevice(DeviceFilter REF_IN filter) {
+  DIR *dev = opendir("/dev");
+  if (!dev) {
+    LOG(ERROR) << "Failed to open /dev.";
+    return "";
+  }
+  std::vector<std::string> names;
+  while (auto entry = readdir(dev))
+    if (IsSerialDeviceName(entry->d_name)) names.emplace_back(entry->d_name);
+  closedir(dev);
+  // "ttyACM" 的字典序小于 "ttyUSB"，同类设备按编号长度再按编号排序
+  std::sort(names.begin(), names.end(), [](std::string REF_IN a, std::string REF_IN b) {
+    return std::make_tuple(a.substr(0, 6), a.size(), a) < std::make_tuple(b.substr(0, 6), b.size(), b);
+  });
+  for (auto &&name : names) {
+    DeviceInfo info;
+    if (!ReadDeviceInfo(name, info)) {
+      if (filter.Empty()) return "/dev/" + name;
+      continue;
+    }
+    if (MatchField(filter.vendor_id, info.vendor_id) && MatchField(filter.product_id, info.product_id)
+        && (filter.serial_number.empty() || filter.serial_number == info.serial_number))
+      return "/dev/" + name;
+  }
+  return "";
+}
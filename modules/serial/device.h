@@ -0,0 +1,59 @@
+#ifndef SRM_IC_2023_MODULES_SERIAL_DEVICE_H_
+#define SRM_IC_2023_MODULES_SERIAL_DEVICE_H_
+
+#include <string>
+#include "common/syntactic-sugar.h"
+
+namespace serial {
+/// 串口设备匹配条件，为空的字段匹配任意设备
+struct DeviceFilter {
+  std::string vendor_id;      ///< USB 厂商 ID，4 位十六进制，如 "0483"
+  std::string product_id;     ///< USB 产品 ID，4 位十六进制
+  std::string serial_number;  ///< USB 序列号，同时连接多块下位机时用于区分
+
+  /**
+   * @brief 从配置文件读取匹配条件
+   * @param [in] config_file 配置文件路径
+   * @return 是否读取成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+
+  /**
+   * @brief 是否未设置任何条件
+   * @return 所有字段均为空时为 true
+   */
+  [[nodiscard]] bool Empty() const { return vendor_id.empty() && product_id.empty() && serial_number.empty(); }
+};
+
+/// USB 串口设备信息
+struct DeviceInfo {
+  std::string vendor_id;      ///< USB 厂商 ID
+  std::string product_id;     ///< USB 产品 ID
+  std::string serial_number;  ///< USB 序列号，设备未提供时为空
+};
+
+/**
+ * @brief 判断 /dev 下的文件名是否为 USB 串口设备
+ * @param [in] name 文件名，如 "ttyACM0"
+ * @return 是否为 ttyACM* 或 ttyUSB*
+ */
+bool IsSerialDeviceName(std::string REF_IN name);
+
+/**
+ * @brief 从 sysfs 读取 tty 设备所属 USB 设备的信息
+ * @param [in] name 设备名，如 "ttyACM0"
+ * @param [out] info 设备信息
+ * @return 是否找到所属的 USB 设备
+ */
+bool ReadDeviceInfo(std::string REF_IN name, DeviceInfo REF_OUT info);
+
+/**
+ * @brief 直接遍历 /dev 与 sysfs 查找满足条件的串口设备，不启动子进程
+ * @details ttyACM* 优先于 ttyUSB*，同类按设备名排序；无法读取 USB 信息的设备仅在未设置匹配条件时被选中
+ * @param [in] filter 匹配条件
+ * @return 设备路径，未找到时为空
+ */
+std::string FindDevice(DeviceFilter REF_IN filter);
+}
+
+#endif  // SRM_IC_2023_MODULES_SERIAL_DEVICE_H_
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstring>
+#include "protocol.h"
+
+namespace {
+/// CRC8 查找表
+constexpr auto kCRC8Table = []() {
+  std::array<uint8_t, 256> table{};
+  for (auto i = 0; i < 256; ++i) {
+    auto crc = static_cast<uint8_t>(i);
+    for (auto k = 0; k < 8; ++k) crc = static_cast<uint8_t>(crc & 0x80 ? crc << 1 ^ 0x31 : crc << 1);
+    table[i] = crc;
+  }
+  return table;
+}();
+
+/// CRC16 查找表
+constexpr auto kCRC16Table = []() {
+  std::array<uint16_t, 256> table{};
+  for (auto i = 0; i < 256; ++i) {
+    auto crc = static_cast<uint16_t>(i << 8);
+    for (auto k = 0; k < 8; ++k) crc = static_cast<uint16_t>(crc & 0x8000 ? crc << 1 ^ 0x1021 : crc << 1);
+    table[i] = crc;
+  }
+  return table;
+}();
+}
+
+uint8_t serial::CRC8(const uint8_t *data, size_t size) {
+  uint8_t crc = 0xFF;
+  for (size_t i = 0; i < size; ++i) crc = kCRC8Table[crc ^ data[i]];
+  return crc;
+}
+
+uint16_t serial::CRC16(const uint8_t *data, size_t size) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < size; ++i) crc = static_cast<uint16_t>(crc << 8 ^ kCRC16Table[(crc >> 8 ^ data[i]) & 0xFF]);
+  return crc;
+}
+
+size_t serial::Pack(PacketType type, const void *payload, size_t size, uint8_t *frame) {
+  if (size > kMaxPayloadSize) return 0;
+  frame[0] = kSyncByte;
+  frame[1] = static_cast<uint8_t>(size);
+  frame[2] = static_cast<uint8_t>(type);
+  frame[3] = CRC8(frame, 3);
+  memcpy(frame + kHeaderSize, payload, size);
+  auto crc = CRC16(frame, kHeaderSize + size);
+  frame[kHeaderSize + size] = static_cast<uint8_t>(crc);
+  frame[kHeaderSize + size + 1] = static_cast<uint8_t>(crc >> 8);
+  return kHeaderSize + size + kTailSize;
+}
+
+void serial::FrameParser::Commit(size_t size, Callback REF_IN callback) {
+  end_ += std::min(size, WriteCapacity());
+  size_t begin = 0;
+  while (begin < end_) {
+    auto sync = std::find(buffer_.begin() + begin, buffer_.begin() + end_, kSyncByte) - buffer_.begin();
+    skipped_bytes_ += sync - begin;
+    begin = sync;
+    if (end_ - begin < kHeaderSize) break;
+    auto frame = buffer_.data() + begin;
+    // 帧头或整帧校验失败时，跳过本同步字节，从下一个字节重新同步
+    if (CRC8(frame, 3) != frame[3]) {
+      ++bad_frames_;
+      ++begin;
+      continue;
+    }
+    size_t payload_size = frame[1], frame_size = kHeaderSize + payload_size + kTailSize;
+    if (end_ - begin < frame_size) break;
+    auto crc = static_cast<uint16_t>(frame[kHeaderSize + payload_size] | frame[kHeaderSize + payload_size + 1] << 8);
+    if (CRC16(frame, kHeaderSize + payload_size) != crc) {
+      ++bad_frames_;
+      ++begin;
+      continue;
+    }
+    ++frames_;
+    callback(static_cast<PacketType>(frame[2]), frame + kHeaderSize, payload_size);
+    begin += frame_size;
+  }
+  // 未收齐的帧移到缓冲区头部，长度不超过一帧
+  if (begin) {
+    memmove(buffer_.data(), buffer_.data() + begin, end_ - begin);
+    end_ -= begin;
+  }
+}
+
+void serial::FrameParser::Reset() {
+  end_ = 0;
+  frames_ = bad_frames_ = skipped_bytes_ = 0;
+}
@@ -0,0 +1,110 @@
+#ifndef SRM_IC_2023_MODULES_SERIAL_PROTOCOL_H_
+#define SRM_IC_2023_MODULES_SERIAL_PROTOCOL_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include "common/syntactic-sugar.h"
+
+namespace serial {
+/**
+ * @brief 串口帧格式
+ * @details | 同步字节 0xA5 | 负载长度 | 负载类型 | 帧头 CRC8 | 负载 | CRC16（小端） |，
+ *   CRC8 校验前 3 字节，使损坏的长度字段在收齐整帧之前即被发现；CRC16 校验帧头与负载
+ */
+constexpr uint8_t kSyncByte = 0xA5;                                          ///< 帧起始同步字节
+constexpr size_t kHeaderSize = 4;                                            ///< 帧头字节数
+constexpr size_t kTailSize = 2;                                              ///< 帧尾 CRC16 字节数
+constexpr size_t kMaxPayloadSize = 255;                                      ///< 负载最大字节数
+constexpr size_t kMaxFrameSize = kHeaderSize + kMaxPayloadSize + kTailSize;  ///< 帧最大字节数
+
+/// 负载类型
+enum class PacketType : uint8_t {
+  RECEIVE = 0x01,  ///< 下位机发送的 ReceivePacket
+  SEND = 0x02,     ///< 上位机发送的 SendPacket
+};
+
+/**
+ * @brief 计算 CRC8（多项式 0x31，初值 0xFF）
+ * @param [in] data 数据首地址
+ * @param size 数据字节数
+ * @return 校验值
+ */
+uint8_t CRC8(const uint8_t *data, size_t size);
+
+/**
+ * @brief 计算 CRC16-CCITT（多项式 0x1021，初值 0xFFFF）
+ * @param [in] data 数据首地址
+ * @param size 数据字节数
+ * @return 校验值
+ */
+uint16_t CRC16(const uint8_t *data, size_t size);
+
+/**
+ * @brief 将负载打包为一帧
+ * @param type 负载类型
+ * @param [in] payload 负载首地址
+ * @param size 负载字节数，不超过 kMaxPayloadSize
+ * @param [out] frame 帧缓冲区，至少 kHeaderSize + size + kTailSize 字节
+ * @return 帧字节数，负载过长时为 0
+ */
+size_t Pack(PacketType type, const void *payload, size_t size, uint8_t *frame);
+
+/**
+ * @brief 串口帧流式解析器
+ * @details 调用者将 read() 的结果直接写入解析器的缓冲区，Commit() 时就地解析，完整帧的负载以指向缓冲区的指针交给回调，
+ *   不复制数据；同步字节之外的字节被跳过，CRC 校验失败时从下一个字节重新寻找同步字节；
+ *   未收齐的帧保留在缓冲区头部等待后续数据，解析过程不分配内存
+ */
+class FrameParser final {
+ public:
+  /**
+   * @brief 帧回调函数
+   * @param type 负载类型
+   * @param payload 负载首地址，仅在回调期间有效
+   * @param size 负载字节数
+   */
+  using Callback = std::function<void(PacketType type, const uint8_t *payload, size_t size)>;
+
+  FrameParser() = default;
+  ~FrameParser() = default;
+
+  /// 解析成功的帧数
+  attr_reader_val(frames_, Frames)
+  /// 校验失败的帧数
+  attr_reader_val(bad_frames_, BadFrames)
+  /// 寻找同步字节时跳过的字节数
+  attr_reader_val(skipped_bytes_, SkippedBytes)
+
+  /**
+   * @brief 获取可写入新数据的缓冲区
+   * @return 缓冲区首地址，可写入 WriteCapacity() 字节
+   */
+  uint8_t *WriteBuffer() { return buffer_.data() + end_; }
+
+  /**
+   * @brief 获取可写入新数据的字节数
+   * @return 字节数，不小于一帧的最大长度
+   */
+  [[nodiscard]] size_t WriteCapacity() const { return buffer_.size() - end_; }
+
+  /**
+   * @brief 提交写入缓冲区的数据并解析其中的完整帧
+   * @param size 写入 WriteBuffer() 的字节数
+   * @param [in] callback 每解析出一帧调用一次
+   */
+  void Commit(size_t size, Callback REF_IN callback);
+
+  /// 丢弃缓冲区中的数据并清零统计
+  void Reset();
+
+ private:
+  std::array<uint8_t, 4 * kMaxFrameSize> buffer_{};  ///< 接收缓冲区，[0, end_) 为未解析的数据
+  size_t end_{};                                     ///< 未解析数据的结尾
+  uint64_t frames_{};                                ///< 解析成功的帧数
+  uint64_t bad_frames_{};                            ///< 校验失败的帧数
+  uint64_t skipped_bytes_{};                         ///< 寻找同步字节时跳过的字节数
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_SERIAL_PROTOCOL_H_
@@ -1,55 +1,82 @@
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <glog/logging.h>
+#include "common/frame.h"
 #include "serial.h"
 
 #define LOCK_TIMEOUT 8
 #define IO_TIMEOUT 4
 #define BAUD_RATE B4000000
-
-std::string GetUartDeviceName() {
-  FILE *ls = popen("ls /dev/ttyACM* --color=never", "r");
-  char name[127];
-  auto ret = fscanf(ls, "%s", name);
-  pclose(ls);
-  if (ret == -1) {
-    LOG(ERROR) << "No UART device found. Please check the device connection.";
-    return "";
-  } else
-    return name;
-}
+#define DELAY_ALPHA 0.05
+#define RETRY_INTERVAL 100
 
 serial::Serial::~Serial() {
   Close();
 }
 
-bool serial::Serial::Open() {
+bool serial::Serial::Open(std::string REF_IN device, DeviceFilter REF_IN filter) {
   if (com_flag_) return false;
-  serial_port_ = GetUartDeviceName();
-  if (serial_port_.empty()) return false;
+  device_ = device;
+  filter_ = filter;
+  serial_port_ = device.empty() ? FindDevice(filter) : device;
+  if (serial_port_.empty()) {
+    LOG(ERROR) << "No UART device found. Please check the device connection.";
+    return false;
+  }
   if (!OpenPort()) {
     serial_port_ = "";
     return false;
   }
+  {
+    std::lock_guard<std::mutex> lock(transmit_lock_);
+    transmit_stop_ = latest_pending_ = false;
+    message_count_ = 0;
+    stats_ = {};
+  }
+  connected_ = true;
+  monitor_stop_ = false;
+  reconnects_ = 0;
+  transmit_thread_ = std::thread(&Serial::TransmitThreadFunction, this);
+  monitor_thread_ = std::thread(&Serial::MonitorThreadFunction, this);
   com_flag_ = true;
   return true;
 }
 
 void serial::Serial::Close() {
   if (!com_flag_) return;
-  ClosePort();
+  monitor_stop_ = true;
+  if (monitor_thread_.joinable()) monitor_thread_.join();
+  {
+    std::lock_guard<std::mutex> lock(transmit_lock_);
+    transmit_stop_ = true;
+  }
+  transmit_cv_.notify_one();
+  if (transmit_thread_.joinable()) transmit_thread_.join();
+  LOG(INFO) << "Sent " << stats_.sent << " frames to serial port " << serial_port_ << ", " << stats_.coalesced
+            << " coalesced, " << stats_.rejected << " rejected, " << stats_.failed << " failed, queueing delay "
+            << stats_.mean_delay * 1e3 << " ms on average and " << stats_.max_delay * 1e3 << " ms at most.";
+  LOG(INFO) << "Received " << parser_.Frames() << " frames from serial port " << serial_port_ << ", "
+            << parser_.BadFrames() << " corrupted, " << parser_.SkippedBytes() << " bytes skipped, "
+            << reconnects_ << " reconnects.";
+  if (serial_fd_) ClosePort();
   serial_port_ = "";
+  connected_ = false;
   com_flag_ = false;
 }
 
 bool serial::Serial::ReadData(ReceivePacket REF_OUT data) {
-  if (!com_flag_) return false;
+  if (!com_flag_ || !connected_) return false;
   std::unique_lock<std::timed_mutex> lock(receive_data_lock_, std::chrono::milliseconds(LOCK_TIMEOUT));
   if (lock.owns_lock()) {
-    bool ret = SerialReceive();
+    std::shared_lock<std::shared_mutex> port_lock(port_lock_);
+    bool ret = connected_ && SerialReceive();
     data = receive_data_;
     return ret;
   } else {
@@ -60,14 +87,148 @@ bool serial::Serial::ReadData(ReceivePacket REF_OUT data) {
 
 bool serial::Serial::WriteData(SendPacket REF_IN data) {
   if (!com_flag_) return false;
-  std::unique_lock<std::timed_mutex> lock(send_data_lock_, std::chrono::milliseconds(LOCK_TIMEOUT));
-  if (lock.owns_lock()) {
-    send_data_ = data;
-    return SerialSend();
-  } else {
-    LOG(WARNING) << "Writing data to serial port " << serial_port_ << " timed out due to failure to acquire lock.";
-    return false;
+  {
+    std::lock_guard<std::mutex> lock(transmit_lock_);
+    if (latest_pending_) ++stats_.coalesced;
+    latest_data_ = data;
+    latest_pending_ = true;
+    latest_time_ = Frame::HostTime();
+  }
+  transmit_cv_.notify_one();
+  return true;
+}
+
+bool serial::Serial::WriteMessage(SendPacket REF_IN data, int priority) {
+  if (!com_flag_) return false;
+  {
+    std::lock_guard<std::mutex> lock(transmit_lock_);
+    if (message_count_ == kMessageCapacity) {
+      ++stats_.rejected;
+      LOG(WARNING) << "Message queue of serial port " << serial_port_ << " is full.";
+      return false;
+    }
+    messages_[message_count_++] = {data, priority, message_sequence_++, Frame::HostTime()};
+    // 消息携带更新的完整指令，尚未发出的旧指令不再发送
+    if (latest_pending_) {
+      ++stats_.coalesced;
+      latest_pending_ = false;
+    }
   }
+  transmit_cv_.notify_one();
+  return true;
+}
+
+serial::TransmitStats serial::Serial::Stats() {
+  std::lock_guard<std::mutex> lock(transmit_lock_);
+  return stats_;
+}
+
+void serial::Serial::TransmitThreadFunction() {
+  std::unique_lock<std::mutex> lock(transmit_lock_);
+  while (true) {
+    // 断开期间指令留在信箱与队列中，重连后发送
+    transmit_cv_.wait(lock, [this] { return transmit_stop_ || (connected_ && (latest_pending_ || message_count_)); });
+    if (transmit_stop_) break;
+    // 一次性消息优先于控制指令，队列很短，线性查找优先级最高、入队最早的消息
+    Message message{};
+    bool is_message = message_count_;
+    if (is_message) {
+      size_t index = 0;
+      for (size_t i = 1; i < message_count_; ++i)
+        if (messages_[i].priority > messages_[index].priority
+            || (messages_[i].priority == messages_[index].priority
+                && messages_[i].sequence < messages_[index].sequence))
+          index = i;
+      message = messages_[index];
+      messages_[index] = messages_[--message_count_];
+    } else {
+      message.data = latest_data_;
+      message.enqueue_time = latest_time_;
+      latest_pending_ = false;
+    }
+    auto delay = static_cast<double>(Frame::HostTime() - message.enqueue_time) * 1e-9;
+    if (stats_.sent + stats_.failed) stats_.mean_delay += DELAY_ALPHA * (delay - stats_.mean_delay);
+    else stats_.mean_delay = delay;
+    stats_.max_delay = std::max(stats_.max_delay, delay);
+    // 写入期间释放锁，调用者可以继续更新指令
+    lock.unlock();
+    bool ret;
+    {
+      std::shared_lock<std::shared_mutex> port_lock(port_lock_);
+      ret = connected_ && SerialSend(message.data);
+    }
+    lock.lock();
+    ++(ret ? stats_.sent : stats_.failed);
+    // 因断开而未发出的指令放回原处，除非已有更新的指令
+    if (!ret && !connected_) {
+      if (is_message && message_count_ < kMessageCapacity) messages_[message_count_++] = message;
+      else if (!is_message && !latest_pending_) {
+        latest_data_ = message.data;
+        latest_time_ = message.enqueue_time;
+        latest_pending_ = true;
+      }
+    }
+  }
+}
+
+void serial::Serial::MonitorThreadFunction() {
+  // 指定设备路径时监听其所在目录，如 /dev/serial/by-id，否则监听 /dev
+  auto separator = device_.rfind('/');
+  std::string watch_dir = "/dev";
+  if (!device_.empty()) watch_dir = separator == std::string::npos ? "." : device_.substr(0, separator);
+  int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd != -1
+      && inotify_add_watch(inotify_fd, watch_dir.c_str(), IN_CREATE | IN_DELETE | IN_ATTRIB) == -1) {
+    close(inotify_fd);
+    inotify_fd = -1;
+  }
+  if (inotify_fd == -1)
+    LOG(WARNING) << "Failed to watch " << watch_dir << ". Serial reconnection falls back to polling every "
+                 << RETRY_INTERVAL << " ms.";
+  alignas(inotify_event) char buffer[4096];
+  while (!monitor_stop_) {
+    // 设备节点出现、权限变化时立即重试，否则每隔 RETRY_INTERVAL 重试一次并检查停止信号
+    pollfd poll_fd{inotify_fd, POLLIN, 0};
+    if (poll(&poll_fd, inotify_fd == -1 ? 0 : 1, RETRY_INTERVAL) > 0) {
+      ssize_t read_count;
+      while ((read_count = read(inotify_fd, buffer, sizeof(buffer))) > 0)
+        for (auto offset = 0; offset < read_count;) {
+          auto event = reinterpret_cast<const inotify_event *>(buffer + offset);
+          offset += static_cast<int>(sizeof(inotify_event) + event->len);
+          if (connected_ && event->mask & IN_DELETE && event->len) {
+            std::shared_lock<std::shared_mutex> port_lock(port_lock_);
+            if (serial_port_ == watch_dir + "/" + event->name) Disconnect("device node removed");
+          }
+        }
+    }
+    if (!connected_) Reconnect();
+  }
+  if (inotify_fd != -1) close(inotify_fd);
+}
+
+void serial::Serial::Disconnect(std::string REF_IN reason) {
+  if (!connected_.exchange(false)) return;
+  disconnect_time_ = Frame::HostTime();
+  LOG(WARNING) << "Serial port " << serial_port_ << " disconnected: " << reason << ". Waiting for reconnection.";
+}
+
+bool serial::Serial::Reconnect() {
+  {
+    std::unique_lock<std::shared_mutex> port_lock(port_lock_);
+    if (serial_fd_) ClosePort();
+    auto serial_port = device_.empty() ? FindDevice(filter_) : device_;
+    if (serial_port.empty() || access(serial_port.c_str(), R_OK | W_OK) == -1) return false;
+    serial_port_ = serial_port;
+    if (!OpenPort()) return false;
+    ++reconnects_;
+    connected_ = true;
+  }
+  LOG(INFO) << "Reconnected to serial port " << serial_port_ << " after "
+            << static_cast<double>(Frame::HostTime() - disconnect_time_) * 1e-6 << " ms.";
+  // 唤醒发送线程发出断开期间保留的指令
+  { std::lock_guard<std::mutex> lock(transmit_lock_); }
+  transmit_cv_.notify_one();
+  return true;
 }
 
 bool serial::Serial::OpenPort() {
@@ -105,6 +266,7 @@ bool serial::Serial::OpenPort() {
   termios_option.c_cc[VTIME] = 1;
   termios_option.c_cc[VMIN] = 1;
   tcflush(serial_fd_, TCIOFLUSH);
+  parser_.Reset();
   LOG(INFO) << "Serial port " << serial_port_ << " is open.";
   return true;
 }
@@ -118,49 +280,71 @@ void serial::Serial::ClosePort() {
   serial_fd_ = 0;
 }
 
-bool serial::Serial::SerialSend() {
-  constexpr auto size = sizeof(SendPacket);
-  tcflush(serial_fd_, TCOFLUSH);
-  ssize_t send_count = write(serial_fd_, &send_data_, size);
-  if (send_count < size) {
-    LOG(ERROR) << "Failed to send " << size - send_count << " / " << size
-               << " bytes of data to serial port " << serial_port_ << ".";
-    return false;
+bool serial::Serial::SerialSend(SendPacket REF_IN data) {
+  std::array<uint8_t, kHeaderSize + sizeof(SendPacket) + kTailSize> frame;
+  auto size = Pack(PacketType::SEND, &data, sizeof(SendPacket), frame.data());
+  // 内核发送缓冲区已满时等待可写，直到超时；不清空缓冲区，已排队的指令不会被丢弃
+  const auto start_time = std::chrono::steady_clock::now();
+  size_t send_count = 0;
+  while (send_count < size) {
+    ssize_t write_count = write(serial_fd_, frame.data() + send_count, size - send_count);
+    if (write_count > 0) {
+      send_count += write_count;
+      continue;
+    }
+    if (write_count == -1 && errno != EAGAIN && errno != EINTR) {
+      LOG(ERROR) << "Failed to send " << size - send_count << " / " << size
+                 << " bytes of data to serial port " << serial_port_ << ".";
+      Disconnect(strerror(errno));
+      return false;
+    }
+    auto remaining_time = IO_TIMEOUT - std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    pollfd poll_fd{serial_fd_, POLLOUT, 0};
+    if (remaining_time <= 0 || poll(&poll_fd, 1, static_cast<int>(remaining_time)) <= 0) {
+      LOG(ERROR) << "Sending " << size - send_count << " / " << size
+                 << " bytes of data to serial port " << serial_port_ << " timed out.";
+      return false;
+    }
   }
   DLOG(INFO) << "Sent " << size << " bytes of data to serial port " << serial_port_ << ".";
-  DLOG(INFO) << send_data_;
+  if (telemetry_) telemetry_->Log(data);
   return true;
 }
 
 bool serial::Serial::SerialReceive() {
-  constexpr auto size = sizeof(SendPacket);
-  memset(&receive_data_, 0, size);
-  ssize_t read_count = 0;
-  const auto start_time = std::chrono::high_resolution_clock::now();
-  while (read_count < size) {
-    auto current_time = std::chrono::high_resolution_clock::now();
-    if (std::chrono::duration_cast<std::chrono::milliseconds>(current_time - start_time).count() > IO_TIMEOUT) {
-      LOG(ERROR) << "Receiving " << size - read_count << " / " << size
-                 << " bytes of data from serial port " << serial_port_ << " timed out.";
+  bool received = false;
+  auto on_frame = [&](PacketType type, const uint8_t *payload, size_t size) {
+    if (type != PacketType::RECEIVE || size != sizeof(ReceivePacket)) {
+      DLOG(WARNING) << "Ignored packet of type " << static_cast<int>(type) << " and " << size << " bytes.";
+      return;
+    }
+    memcpy(&receive_data_, payload, size);
+    if (telemetry_) telemetry_->Log(receive_data_);
+    received = true;
+  };
+  // 读出已到达的全部字节，只保留最新的数据包；尚无新数据包时等待，直到超时
+  const auto start_time = std::chrono::steady_clock::now();
+  while (true) {
+    ssize_t read_count = read(serial_fd_, parser_.WriteBuffer(), parser_.WriteCapacity());
+    if (read_count > 0) {
+      parser_.Commit(read_count, on_frame);
+      continue;
+    }
+    // tty 挂断后 read() 返回 0 或 EIO，交给监视线程重连
+    if (read_count == 0 || (read_count == -1 && errno != EAGAIN && errno != EINTR)) {
+      Disconnect(read_count ? strerror(errno) : "hung up");
       return false;
     }
-    ssize_t once_read_count;
-    once_read_count = read(serial_fd_, ((unsigned char *) (&receive_data_)) + read_count, size - read_count);
-    if (once_read_count == -1) {
-      if (errno == EAGAIN) {
-        DLOG(WARNING) << "Receiving " << size - read_count << " / " << size
-                      << " bytes of data from serial port " << serial_port_ << " delayed.";
-        continue;
-      } else {
-        LOG(ERROR) << "Failed to receive " << size - read_count << " / " << size
-                   << " bytes of data from serial port " << serial_port_ << ".";
-        return false;
-      }
+    if (received) break;
+    auto remaining_time = IO_TIMEOUT - std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    pollfd poll_fd{serial_fd_, POLLIN, 0};
+    if (remaining_time <= 0 || poll(&poll_fd, 1, static_cast<int>(remaining_time)) <= 0) {
+      LOG(ERROR) << "Receiving data from serial port " << serial_port_ << " timed out.";
+      return false;
     }
-    read_count += once_read_count;
   }
-  tcflush(serial_fd_, TCIFLUSH);
-  DLOG(INFO) << "Received " << size << " bytes of data from serial port " << serial_port_ << ".";
-  DLOG(INFO) << receive_data_;
+  DLOG(INFO) << "Received data from serial port " << serial_port_ << ".";
   return true;
 }
@@ -1,21 +1,65 @@
 #ifndef SRM_IC_2023_MODULES_SERIAL_SERIAL_H_
 #define SRM_IC_2023_MODULES_SERIAL_SERIAL_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include "common/packet.h"
+#include "device.h"
+#include "protocol.h"
+#include "telemetry/telemetry.h"
 
 namespace serial {
-/// 串口通信接口
+constexpr size_t kMessageCapacity = 8;  ///< 一次性消息队列容量
+
+/// 发送统计
+struct TransmitStats {
+  uint64_t sent;       ///< 已写入串口的数据包数
+  uint64_t coalesced;  ///< 发送前被更新的指令覆盖的指令数
+  uint64_t rejected;   ///< 队列已满而被拒绝的一次性消息数
+  uint64_t failed;     ///< 写入失败或超时的数据包数
+  double mean_delay;   ///< 从入队到开始写入的排队延迟的指数滑动平均，单位：s
+  double max_delay;    ///< 最大排队延迟，单位：s
+};
+
+/**
+ * @brief 串口通信接口
+ * @details 收发数据均按 protocol.h 中的帧格式封装；接收时读出串口中已有的全部字节交给流式解析器，
+ *   保留最新的一个完整数据包，字节丢失或损坏时自动重新同步，不再依赖清空输入缓冲区恢复；
+ *   发送由独立线程完成：控制指令写入单槽信箱，尚未发出的旧指令被新指令覆盖，一次性消息按优先级排队且不会被覆盖，
+ *   发送线程以非阻塞写入与 poll() 写出整帧，调用者从不等待串口；
+ *   监视线程以 inotify 监听 /dev，设备断开后在设备节点重新出现时立即重连，断开期间的最新指令与消息队列保留到重连后发送；
+ *   收到的每个数据包与写出的每个数据包均可记录到遥测日志
+ */
 class Serial final {
  public:
   Serial() = default;
   ~Serial();
 
+  /// 接收帧解析器，记录收到、损坏的帧数
+  attr_reader_ref(parser_, Parser)
+
+  /**
+   * @brief 设备当前是否已连接
+   * @return 已打开且未断开时为 true，断开后等待重连期间为 false
+   */
+  [[nodiscard]] bool Connected() const { return connected_; }
+
+  /**
+   * @brief 设置记录收发数据包的遥测日志，须在 Open() 之前调用
+   * @param [in] telemetry 遥测日志，生命周期须长于串口通信，为 nullptr 时不记录
+   */
+  void SetTelemetry(telemetry::TelemetryLog *telemetry) { telemetry_ = telemetry; }
+
   /**
    * @brief 打开串口通信
+   * @param [in] device 串口设备路径，为空时按 filter 查找 USB 串口设备
+   * @param [in] filter 自动查找设备时的匹配条件
    * @return 是否打开成功
    */
-  bool Open();
+  bool Open(std::string REF_IN device = "", DeviceFilter REF_IN filter = {});
 
   /// 关闭串口通信
   void Close();
@@ -28,25 +72,82 @@ class Serial final {
   bool ReadData(ReceivePacket REF_OUT data);
 
   /**
-   * @brief 发送数据
+   * @brief 更新最新的控制指令，由发送线程异步发送
+   * @details 发送线程尚未发出的上一条指令被覆盖，不会阻塞
    * @param [in] data 发送数据包
-   * @return 是否发送成功
+   * @return 是否写入信箱，串口未打开时为 false
    */
   bool WriteData(SendPacket REF_IN data);
 
+  /**
+   * @brief 发送一次性消息，如开火指令，先于控制指令发送且不会被覆盖
+   * @details 消息同样是完整的控制指令，入队时信箱中尚未发出的旧指令被丢弃
+   * @param [in] data 发送数据包
+   * @param priority 优先级，数值大者先发送，同优先级按入队顺序发送
+   * @return 是否入队，串口未打开或队列已满时为 false
+   */
+  bool WriteMessage(SendPacket REF_IN data, int priority = 0);
+
+  /**
+   * @brief 获取发送统计
+   * @return 发送统计的副本
+   */
+  [[nodiscard]] TransmitStats Stats();
+
  private:
+  /// 待发送的一次性消息
+  struct Message {
+    SendPacket data;        ///< 发送数据包
+    int priority;           ///< 优先级
+    uint64_t sequence;      ///< 入队序号
+    uint64_t enqueue_time;  ///< 入队时间，单位：ns
+  };
+
   bool OpenPort();
   void ClosePort();
-  bool SerialSend();
+  bool SerialSend(SendPacket REF_IN data);
   bool SerialReceive();
+  void TransmitThreadFunction();
+  void MonitorThreadFunction();
+
+  /**
+   * @brief 标记设备已断开，由监视线程关闭端口并重连
+   * @param [in] reason 断开原因，仅在首次标记时记录日志
+   */
+  void Disconnect(std::string REF_IN reason);
+
+  /**
+   * @brief 关闭失效的端口并重新查找、打开设备
+   * @return 是否重连成功
+   */
+  bool Reconnect();
 
-  std::string serial_port_;             ///< 串口端口号
-  int serial_fd_{};                     ///< 文件描述符
-  bool com_flag_{};                     ///< 通信标志
-  std::timed_mutex send_data_lock_;     ///< 发送锁
-  std::timed_mutex receive_data_lock_;  ///< 接收锁
-  SendPacket send_data_{};              ///< 发送数据暂存
-  ReceivePacket receive_data_{};        ///< 接收数据暂存
+  std::string serial_port_;                           ///< 串口端口号
+  std::string device_;                                ///< 指定的设备路径，为空时按匹配条件查找
+  DeviceFilter filter_;                               ///< 设备匹配条件
+  int serial_fd_{};                                   ///< 文件描述符
+  bool com_flag_{};                                   ///< 通信标志
+  std::atomic_bool connected_{};                      ///< 设备是否已连接
+  std::shared_mutex port_lock_;                       ///< 端口锁，收发时共享持有，重连时独占持有
+  std::thread monitor_thread_;                        ///< 设备监视线程
+  std::atomic_bool monitor_stop_{};                   ///< 监视线程停止信号
+  std::atomic_uint64_t disconnect_time_{};            ///< 最近一次断开的时间，单位：ns
+  uint64_t reconnects_{};                             ///< 重连次数
+  std::timed_mutex receive_data_lock_;                ///< 接收锁
+  ReceivePacket receive_data_{};                      ///< 接收数据暂存
+  FrameParser parser_;                                ///< 接收帧解析器
+  std::thread transmit_thread_;                       ///< 发送线程
+  std::mutex transmit_lock_;                          ///< 发送信箱、队列与统计的锁
+  std::condition_variable transmit_cv_;               ///< 新数据信号
+  bool transmit_stop_{};                              ///< 发送线程停止信号
+  SendPacket latest_data_{};                          ///< 最新的控制指令
+  bool latest_pending_{};                             ///< 最新的控制指令是否尚未发出
+  uint64_t latest_time_{};                            ///< 最新的控制指令的写入时间，单位：ns
+  std::array<Message, kMessageCapacity> messages_{};  ///< 一次性消息队列，[0, message_count_) 有效
+  size_t message_count_{};                            ///< 队列中的消息数
+  uint64_t message_sequence_{};                       ///< 下一条消息的入队序号
+  TransmitStats stats_{};                             ///< 发送统计
+  telemetry::TelemetryLog *telemetry_{};              ///< 遥测日志
 };
 }
 
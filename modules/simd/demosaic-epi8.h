@@ -0,0 +1,320 @@
+#ifndef SRM_IC_2023_MODULES_SIMD_DEMOSAIC_EPI8_H_
+#define SRM_IC_2023_MODULES_SIMD_DEMOSAIC_EPI8_H_
+
+/**
+ * @file demosaic-epi8.h
+ * @brief 8 位 Bayer 图像解马赛克及色差掩码向量内核，Ops16 基于 SSSE3（aarch64 下经 sse2neon 映射到 NEON），Ops32 基于 AVX2
+ * @details 全分辨率输出采用双线性插值，与 OpenCV cv::cvtColor 的 COLOR_Bayer**2BGR 逐像素一致：
+ * @code
+ *   同色两邻点均值    (a + b + 1) >> 1
+ *   同色四邻点均值    (a + b + c + d + 2) >> 2
+ *   图像边缘          复制相邻的内部像素
+ * @endcode
+ *   半分辨率输出将每个 2x2 单元合并为一个像素，G 取两个绿色像素的均值；
+ *   色差掩码同样以 2x2 单元为一个像素，只读取其中的红、蓝像素，不经过解马赛克
+ * @note 内核以行为单位处理，行内按 Bayer 排列分为“本色”（该行的红或蓝）、绿色和“异色”三个通道，
+ *   由调用者根据行的颜色和输出格式决定通道写入顺序
+ */
+
+#include <cstddef>
+#include <cstdint>
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#endif
+#if defined(__aarch64__)
+#include "sse2neon/sse2neon.h"
+#endif
+
+namespace simd::epi8 {
+/**
+ * @brief 计算一个内部像素的三个通道
+ * @param [in] u 上一行
+ * @param [in] c 当前行
+ * @param [in] d 下一行
+ * @param x 列坐标，要求 1 <= x <= 宽度 - 2
+ * @param color 该像素是否为本色（非绿色）像素
+ * @param [out] dst 输出像素首地址
+ * @param own 本色通道在输出像素中的下标，异色通道下标为 2 - own
+ */
+inline void DemosaicPixel(const uint8_t *u, const uint8_t *c, const uint8_t *d, int x,
+                          bool color, uint8_t *dst, int own) {
+  if (color) {
+    dst[own] = c[x];
+    dst[1] = (uint8_t) ((u[x] + d[x] + c[x - 1] + c[x + 1] + 2) >> 2);
+    dst[2 - own] = (uint8_t) ((u[x - 1] + u[x + 1] + d[x - 1] + d[x + 1] + 2) >> 2);
+  } else {
+    dst[own] = (uint8_t) ((c[x - 1] + c[x + 1] + 1) >> 1);
+    dst[1] = c[x];
+    dst[2 - own] = (uint8_t) ((u[x] + d[x] + 1) >> 1);
+  }
+}
+
+/**
+ * @brief 计算半分辨率输出的一个像素
+ * @param [in] r0 2x2 单元的上一行
+ * @param [in] r1 2x2 单元的下一行
+ * @param i 单元列坐标
+ * @param color_first 单元左上角是否为本色（非绿色）像素
+ * @param [out] dst 输出像素首地址
+ * @param own 上一行本色通道在输出像素中的下标
+ */
+inline void DemosaicHalfPixel(const uint8_t *r0, const uint8_t *r1, int i,
+                              bool color_first, uint8_t *dst, int own) {
+  const uint8_t *p0 = r0 + 2 * i, *p1 = r1 + 2 * i;
+  if (color_first) {
+    dst[own] = p0[0];
+    dst[1] = (uint8_t) ((p0[1] + p1[0] + 1) >> 1);
+    dst[2 - own] = p1[1];
+  } else {
+    dst[own] = p0[1];
+    dst[1] = (uint8_t) ((p0[0] + p1[1] + 1) >> 1);
+    dst[2 - own] = p1[0];
+  }
+}
+
+/**
+ * @brief 计算色差掩码的一个像素
+ * @param [in] r0 2x2 单元的上一行
+ * @param [in] r1 2x2 单元的下一行
+ * @param i 单元列坐标
+ * @param color_first 单元左上角是否为本色（非绿色）像素
+ * @param own_minus_other 色差是否为上一行本色减去下一行异色，否则相反
+ * @param threshold 色差阈值
+ * @param binary 是否输出二值掩码，否则输出超过阈值的色差
+ * @return 掩码值
+ */
+inline uint8_t ColorMaskPixel(const uint8_t *r0, const uint8_t *r1, int i, bool color_first,
+                              bool own_minus_other, uint8_t threshold, bool binary) {
+  int own = color_first ? r0[2 * i] : r0[2 * i + 1], other = color_first ? r1[2 * i + 1] : r1[2 * i];
+  int diff = own_minus_other ? own - other : other - own;
+  if (diff <= threshold) return 0;
+  return binary ? 255 : (uint8_t) diff;
+}
+
+#if (defined(__x86_64__) && defined(__SSSE3__)) || defined(__aarch64__)
+/// 一次处理 16 个像素的 128 位整数向量操作
+struct Ops16 {
+  typedef __m128i V;
+  static constexpr int kStep = 16;  ///< 每次迭代处理的像素数
+
+  static inline V Load(const uint8_t *p) { return _mm_loadu_si128((const __m128i *) p); }
+  static inline void Store(uint8_t *p, V a) { _mm_storeu_si128((__m128i *) p, a); }
+  static inline V Set1(uint8_t v) { return _mm_set1_epi8((char) v); }
+  static inline V EvenMask() { return _mm_set1_epi16(0x00ff); }
+  static inline V One() { return _mm_set1_epi8(1); }
+  static inline V Avg(V a, V b) { return _mm_avg_epu8(a, b); }
+  static inline V And(V a, V b) { return _mm_and_si128(a, b); }
+  static inline V Or(V a, V b) { return _mm_or_si128(a, b); }
+  static inline V Xor(V a, V b) { return _mm_xor_si128(a, b); }
+  static inline V Sub(V a, V b) { return _mm_sub_epi8(a, b); }
+  static inline V SubSat(V a, V b) { return _mm_subs_epu8(a, b); }
+  /// 无符号比较 a > b
+  static inline V Gt(V a, V b) {
+    return _mm_xor_si128(_mm_cmpeq_epi8(_mm_subs_epu8(a, b), _mm_setzero_si128()), _mm_set1_epi8(-1));
+  }
+  static inline V Odd16(V a) { return _mm_srli_epi16(a, 8); }
+  static inline V Even16(V a) { return _mm_and_si128(a, EvenMask()); }
+  /// 将两个向量的 16 位元素依次压缩为 8 位
+  static inline V Pack(V a, V b) { return _mm_packus_epi16(a, b); }
+  static inline V Select(V mask, V a, V b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+
+  /// 交错存储三个通道，共 48 字节
+  static inline void Store3(uint8_t *p, V a, V b, V c) {
+#if defined(__aarch64__)
+    uint8x16x3_t abc = {vreinterpretq_u8_m128i(a), vreinterpretq_u8_m128i(b), vreinterpretq_u8_m128i(c)};
+    vst3q_u8(p, abc);
+#else
+    const V m0a = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5),
+        m0b = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1),
+        m0c = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1),
+        m1a = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1),
+        m1b = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10),
+        m1c = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1),
+        m2a = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1),
+        m2b = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1),
+        m2c = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+    auto shuffle = [](V a, V ma, V b, V mb, V c, V mc) {
+      return _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, ma), _mm_shuffle_epi8(b, mb)), _mm_shuffle_epi8(c, mc));
+    };
+    _mm_storeu_si128((__m128i *) p, shuffle(a, m0a, b, m0b, c, m0c));
+    _mm_storeu_si128((__m128i *) (p + 16), shuffle(a, m1a, b, m1b, c, m1c));
+    _mm_storeu_si128((__m128i *) (p + 32), shuffle(a, m2a, b, m2b, c, m2c));
+#endif
+  }
+};
+#endif
+
+#if defined(__AVX2__)
+/// 一次处理 32 个像素的 256 位整数向量操作
+struct Ops32 {
+  typedef __m256i V;
+  static constexpr int kStep = 32;  ///< 每次迭代处理的像素数
+
+  static inline V Load(const uint8_t *p) { return _mm256_loadu_si256((const __m256i *) p); }
+  static inline void Store(uint8_t *p, V a) { _mm256_storeu_si256((__m256i *) p, a); }
+  static inline V Set1(uint8_t v) { return _mm256_set1_epi8((char) v); }
+  static inline V EvenMask() { return _mm256_set1_epi16(0x00ff); }
+  static inline V One() { return _mm256_set1_epi8(1); }
+  static inline V Avg(V a, V b) { return _mm256_avg_epu8(a, b); }
+  static inline V And(V a, V b) { return _mm256_and_si256(a, b); }
+  static inline V Or(V a, V b) { return _mm256_or_si256(a, b); }
+  static inline V Xor(V a, V b) { return _mm256_xor_si256(a, b); }
+  static inline V Sub(V a, V b) { return _mm256_sub_epi8(a, b); }
+  static inline V SubSat(V a, V b) { return _mm256_subs_epu8(a, b); }
+  static inline V Gt(V a, V b) {
+    return _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_subs_epu8(a, b), _mm256_setzero_si256()), _mm256_set1_epi8(-1));
+  }
+  static inline V Odd16(V a) { return _mm256_srli_epi16(a, 8); }
+  static inline V Even16(V a) { return _mm256_and_si256(a, EvenMask()); }
+  /// 通道内压缩后需重排 64 位块以恢复元素顺序
+  static inline V Pack(V a, V b) { return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8); }
+  static inline V Select(V mask, V a, V b) { return _mm256_blendv_epi8(b, a, mask); }
+
+  static inline void Store3(uint8_t *p, V a, V b, V c) {
+    Ops16::Store3(p, _mm256_castsi256_si128(a), _mm256_castsi256_si128(b), _mm256_castsi256_si128(c));
+    Ops16::Store3(p + 48, _mm256_extracti128_si256(a, 1), _mm256_extracti128_si256(b, 1),
+                  _mm256_extracti128_si256(c, 1));
+  }
+};
+#endif
+
+/**
+ * @brief 四个 8 位无符号数的舍入均值 (a + b + c + d + 2) >> 2，无需扩展到 16 位
+ * @details 设 p = avg(a, b)，q = avg(c, d)，avg(p, q) 仅在 p + q 为奇数且 a + b、c + d 中至少一个为奇数时比精确值大 1
+ * @tparam O 向量操作类型
+ * @param ab avg(a, b)
+ * @param cd avg(c, d)
+ * @param ab_odd a ^ b
+ * @param cd_odd c ^ d
+ * @return 逐字节的舍入均值
+ */
+template<class O, class V = typename O::V>
+inline V Avg4(V ab, V cd, V ab_odd, V cd_odd) {
+  return O::Sub(O::Avg(ab, cd), O::And(O::And(O::Xor(ab, cd), O::Or(ab_odd, cd_odd)), O::One()));
+}
+
+/**
+ * @brief 全分辨率双线性解马赛克一行的内部像素
+ * @tparam O 向量操作类型
+ * @param [in] u 上一行
+ * @param [in] c 当前行
+ * @param [in] d 下一行
+ * @param x 起始列坐标，要求为偶数且 >= 2
+ * @param x_end 结束列坐标（不含），不超过宽度 - 1
+ * @param color_first 偶数列是否为本色像素
+ * @param [out] dst 输出行首地址
+ * @param own 本色通道在输出像素中的下标，0 或 2
+ * @return 向量部分处理结束的列坐标，剩余像素由调用者逐个处理
+ */
+template<class O, class V = typename O::V>
+inline int DemosaicRow(const uint8_t *u, const uint8_t *c, const uint8_t *d, int x, int x_end,
+                       bool color_first, uint8_t *dst, int own) {
+  const V even = O::EvenMask();
+  for (; x + O::kStep <= x_end; x += O::kStep) {
+    V ul = O::Load(u + x - 1), uc = O::Load(u + x), ur = O::Load(u + x + 1),
+        cl = O::Load(c + x - 1), cc = O::Load(c + x), cr = O::Load(c + x + 1),
+        dl = O::Load(d + x - 1), dc = O::Load(d + x), dr = O::Load(d + x + 1);
+    V half_h = O::Avg(cl, cr), half_v = O::Avg(uc, dc);
+    V cross = Avg4<O>(half_v, half_h, O::Xor(uc, dc), O::Xor(cl, cr));
+    V diag = Avg4<O>(O::Avg(ul, ur), O::Avg(dl, dr), O::Xor(ul, ur), O::Xor(dl, dr));
+    // 偶数列与奇数列交替为本色和绿色像素
+    V v_own, v_green, v_other;
+    if (color_first) {
+      v_own = O::Select(even, cc, half_h);
+      v_green = O::Select(even, cross, cc);
+      v_other = O::Select(even, diag, half_v);
+    } else {
+      v_own = O::Select(even, half_h, cc);
+      v_green = O::Select(even, cc, cross);
+      v_other = O::Select(even, half_v, diag);
+    }
+    if (own == 0)
+      O::Store3(dst + 3 * x, v_own, v_green, v_other);
+    else
+      O::Store3(dst + 3 * x, v_other, v_green, v_own);
+  }
+  return x;
+}
+
+/**
+ * @brief 半分辨率解马赛克一行 2x2 单元
+ * @tparam O 向量操作类型
+ * @param [in] r0 2x2 单元的上一行
+ * @param [in] r1 2x2 单元的下一行
+ * @param i 起始单元列坐标
+ * @param i_end 结束单元列坐标（不含），不超过宽度 / 2
+ * @param color_first 单元左上角是否为本色像素
+ * @param [out] dst 输出行首地址
+ * @param own 上一行本色通道在输出像素中的下标，0 或 2
+ * @return 向量部分处理结束的单元列坐标，剩余单元由调用者逐个处理
+ */
+template<class O, class V = typename O::V>
+inline int DemosaicHalfRow(const uint8_t *r0, const uint8_t *r1, int i, int i_end,
+                           bool color_first, uint8_t *dst, int own) {
+  for (; i + O::kStep <= i_end; i += O::kStep) {
+    V a0 = O::Load(r0 + 2 * i), b0 = O::Load(r0 + 2 * i + O::kStep),
+        a1 = O::Load(r1 + 2 * i), b1 = O::Load(r1 + 2 * i + O::kStep);
+    V e0 = O::Pack(O::Even16(a0), O::Even16(b0)), o0 = O::Pack(O::Odd16(a0), O::Odd16(b0)),
+        e1 = O::Pack(O::Even16(a1), O::Even16(b1)), o1 = O::Pack(O::Odd16(a1), O::Odd16(b1));
+    V v_own, v_green, v_other;
+    if (color_first) {
+      v_own = e0;
+      v_green = O::Avg(o0, e1);
+      v_other = o1;
+    } else {
+      v_own = o0;
+      v_green = O::Avg(e0, o1);
+      v_other = e1;
+    }
+    if (own == 0)
+      O::Store3(dst + 3 * i, v_own, v_green, v_other);
+    else
+      O::Store3(dst + 3 * i, v_other, v_green, v_own);
+  }
+  return i;
+}
+
+/**
+ * @brief 由一行 2x2 单元计算半分辨率色差掩码
+ * @tparam O 向量操作类型
+ * @param [in] r0 2x2 单元的上一行
+ * @param [in] r1 2x2 单元的下一行
+ * @param i 起始单元列坐标
+ * @param i_end 结束单元列坐标（不含），不超过宽度 / 2
+ * @param color_first 单元左上角是否为本色像素
+ * @param own_minus_other 色差是否为上一行本色减去下一行异色，否则相反
+ * @param threshold 色差阈值
+ * @param binary 是否输出二值掩码，否则输出超过阈值的色差
+ * @param [out] dst 输出行首地址
+ * @return 向量部分处理结束的单元列坐标，剩余单元由调用者逐个处理
+ */
+template<class O, class V = typename O::V>
+inline int ColorMaskRow(const uint8_t *r0, const uint8_t *r1, int i, int i_end, bool color_first,
+                        bool own_minus_other, uint8_t threshold, bool binary, uint8_t *dst) {
+  const V v_threshold = O::Set1(threshold);
+  for (; i + O::kStep <= i_end; i += O::kStep) {
+    V a0 = O::Load(r0 + 2 * i), b0 = O::Load(r0 + 2 * i + O::kStep),
+        a1 = O::Load(r1 + 2 * i), b1 = O::Load(r1 + 2 * i + O::kStep);
+    V v_own, v_other;
+    if (color_first) {
+      v_own = O::Pack(O::Even16(a0), O::Even16(b0));
+      v_other = O::Pack(O::Odd16(a1), O::Odd16(b1));
+    } else {
+      v_own = O::Pack(O::Odd16(a0), O::Odd16(b0));
+      v_other = O::Pack(O::Even16(a1), O::Even16(b1));
+    }
+    V diff = own_minus_other ? O::SubSat(v_own, v_other) : O::SubSat(v_other, v_own);
+    V mask = O::Gt(diff, v_threshold);
+    O::Store(dst + i, binary ? mask : O::And(mask, diff));
+  }
+  return i;
+}
+}
+
+#endif  // SRM_IC_2023_MODULES_SIMD_DEMOSAIC_EPI8_H_
@@ -7,9 +7,12 @@
 #if defined(__x86_64__) | defined(__aarch64__)
 #define USE_SSE2
 #include "sse-math/sse-math.h"
+#include "math-pd.h"
 #else
 #include <cmath>
 #endif
+#include <cstring>
+#include "demosaic-epi8.h"
 #include "simd.h"
 
 void simd::sin_cos_4f(const float x[4], float s[4], float c[4]) {
@@ -154,8 +157,186 @@ float simd::sqrt_f(float x) {
 
 float simd::rsqrt_f(float x) {
 #if defined(__x86_64__) | defined(__aarch64__)
-  return rsqrt_ps(x);
+  // 近似倒数平方根只有 12 位精度，以修正量的形式做一次牛顿迭代，误差降至 3 ULP 左右；输入须为正的有限值
+  float y = rsqrt_ps(x);
+  return y + y * (0.5f - 0.5f * x * y * y);
 #else
   return 1.f / sqrtf(x);
 #endif
 }
+
+void simd::sin_cos_2d(const double x[2], double s[2], double c[2]) {
+#if defined(__x86_64__) | defined(__aarch64__)
+  pd::v2df s_v2df, c_v2df;
+  pd::sincos_pd(_mm_loadu_pd(x), &s_v2df, &c_v2df);
+  _mm_storeu_pd(s, s_v2df);
+  _mm_storeu_pd(c, c_v2df);
+#else
+  for (auto i = 0; i < 2; i++) {
+    s[i] = sin(x[i]);
+    c[i] = cos(x[i]);
+  }
+#endif
+}
+
+void simd::sin_cos_4d(const double x[4], double s[4], double c[4]) {
+#if defined(__AVX2__)
+  pd::v4df s_v4df, c_v4df;
+  pd::sincos_pd(_mm256_loadu_pd(x), &s_v4df, &c_v4df);
+  _mm256_storeu_pd(s, s_v4df);
+  _mm256_storeu_pd(c, c_v4df);
+#else
+  sin_cos_2d(x, s, c);
+  sin_cos_2d(x + 2, s + 2, c + 2);
+#endif
+}
+
+void simd::sin_4d(double x[4]) {
+  double c[4];
+  sin_cos_4d(x, x, c);
+}
+
+double simd::sin_d(double x) {
+#if defined(__x86_64__) | defined(__aarch64__)
+  pd::v2df s_v2df, c_v2df;
+  pd::sincos_pd(_mm_set1_pd(x), &s_v2df, &c_v2df);
+  return _mm_cvtsd_f64(s_v2df);
+#else
+  return sin(x);
+#endif
+}
+
+void simd::cos_4d(double x[4]) {
+  double s[4];
+  sin_cos_4d(x, s, x);
+}
+
+double simd::cos_d(double x) {
+#if defined(__x86_64__) | defined(__aarch64__)
+  pd::v2df s_v2df, c_v2df;
+  pd::sincos_pd(_mm_set1_pd(x), &s_v2df, &c_v2df);
+  return _mm_cvtsd_f64(c_v2df);
+#else
+  return cos(x);
+#endif
+}
+
+void simd::atan2_2d(const double y[2], const double x[2], double res[2]) {
+#if defined(__x86_64__) | defined(__aarch64__)
+  _mm_storeu_pd(res, pd::atan2_pd(_mm_loadu_pd(y), _mm_loadu_pd(x)));
+#else
+  for (auto i = 0; i < 2; i++)
+    res[i] = atan2(y[i], x[i]);
+#endif
+}
+
+void simd::atan2_4d(const double y[4], const double x[4], double res[4]) {
+#if defined(__AVX2__)
+  _mm256_storeu_pd(res, pd::atan2_pd(_mm256_loadu_pd(y), _mm256_loadu_pd(x)));
+#else
+  atan2_2d(y, x, res);
+  atan2_2d(y + 2, x + 2, res + 2);
+#endif
+}
+
+double simd::atan2_d(double y, double x) {
+#if defined(__x86_64__) | defined(__aarch64__)
+  return _mm_cvtsd_f64(pd::atan2_pd(_mm_set1_pd(y), _mm_set1_pd(x)));
+#else
+  return atan2(y, x);
+#endif
+}
+
+void simd::sqrt_4d(double x[4]) {
+#if defined(__AVX2__)
+  _mm256_storeu_pd(x, pd::sqrt_pd(_mm256_loadu_pd(x)));
+#elif defined(__x86_64__) | defined(__aarch64__)
+  _mm_storeu_pd(x, pd::sqrt_pd(_mm_loadu_pd(x)));
+  _mm_storeu_pd(x + 2, pd::sqrt_pd(_mm_loadu_pd(x + 2)));
+#else
+  for (auto i = 0; i < 4; i++)
+    x[i] = sqrt(x[i]);
+#endif
+}
+
+double simd::sqrt_d(double x) {
+#if defined(__x86_64__) | defined(__aarch64__)
+  return _mm_cvtsd_f64(pd::sqrt_pd(_mm_set_sd(x)));
+#else
+  return sqrt(x);
+#endif
+}
+
+bool simd::demosaic_8u(const unsigned char *src, int width, int height, size_t src_step,
+                       unsigned char *dst, size_t dst_step, BayerPattern pattern, DemosaicFormat format) {
+  if (width < 4 || height < 4 || width % 2 || height % 2) return false;
+  // 第 0 行的颜色及其偶数列是否为本色像素，奇数行二者均取反
+  const bool red_first = pattern == BayerPattern::RG || pattern == BayerPattern::GR,
+      color_first = pattern == BayerPattern::RG || pattern == BayerPattern::BG,
+      rgb = format == DemosaicFormat::RGB || format == DemosaicFormat::HALF_RGB;
+  // 红色通道在 BGR 中下标为 2，在 RGB 中下标为 0
+  const int own_even = red_first != rgb ? 2 : 0, own_odd = 2 - own_even;
+  if (format == DemosaicFormat::HALF_BGR || format == DemosaicFormat::HALF_RGB) {
+    const int half_width = width / 2;
+    for (auto j = 0; j < height / 2; ++j) {
+      const uint8_t *r0 = src + 2 * j * src_step, *r1 = r0 + src_step;
+      uint8_t *out = dst + j * dst_step;
+      auto i = 0;
+#if defined(__AVX2__)
+      i = epi8::DemosaicHalfRow<epi8::Ops32>(r0, r1, i, half_width, color_first, out, own_even);
+#endif
+#if (defined(__x86_64__) && defined(__SSSE3__)) || defined(__aarch64__)
+      i = epi8::DemosaicHalfRow<epi8::Ops16>(r0, r1, i, half_width, color_first, out, own_even);
+#endif
+      for (; i < half_width; ++i)
+        epi8::DemosaicHalfPixel(r0, r1, i, color_first, out + 3 * i, own_even);
+    }
+    return true;
+  }
+  const size_t row_bytes = 3 * width;
+  for (auto y = 1; y < height - 1; ++y) {
+    const uint8_t *u = src + (y - 1) * src_step, *c = u + src_step, *d = c + src_step;
+    uint8_t *out = dst + y * dst_step;
+    const bool row_color_first = color_first != (y % 2 == 1);
+    const int own = y % 2 ? own_odd : own_even;
+    epi8::DemosaicPixel(u, c, d, 1, !row_color_first, out + 3, own);
+    auto x = 2;
+#if defined(__AVX2__)
+    x = epi8::DemosaicRow<epi8::Ops32>(u, c, d, x, width - 1, row_color_first, out, own);
+#endif
+#if (defined(__x86_64__) && defined(__SSSE3__)) || defined(__aarch64__)
+    x = epi8::DemosaicRow<epi8::Ops16>(u, c, d, x, width - 1, row_color_first, out, own);
+#endif
+    for (; x < width - 1; ++x)
+      epi8::DemosaicPixel(u, c, d, x, row_color_first != (x % 2 == 1), out + 3 * x, own);
+    std::memcpy(out, out + 3, 3);
+    std::memcpy(out + row_bytes - 3, out + row_bytes - 6, 3);
+  }
+  std::memcpy(dst, dst + dst_step, row_bytes);
+  std::memcpy(dst + (height - 1) * dst_step, dst + (height - 2) * dst_step, row_bytes);
+  return true;
+}
+
+bool simd::color_mask_8u(const unsigned char *src, int width, int height, size_t src_step,
+                         unsigned char *dst, size_t dst_step, BayerPattern pattern,
+                         LightColor color, unsigned char threshold, bool binary) {
+  if (width < 4 || height < 4 || width % 2 || height % 2) return false;
+  const bool red_first = pattern == BayerPattern::RG || pattern == BayerPattern::GR,
+      color_first = pattern == BayerPattern::RG || pattern == BayerPattern::BG,
+      own_minus_other = red_first == (color == LightColor::RED);
+  const int half_width = width / 2;
+  for (auto j = 0; j < height / 2; ++j) {
+    const uint8_t *r0 = src + 2 * j * src_step, *r1 = r0 + src_step;
+    uint8_t *out = dst + j * dst_step;
+    auto i = 0;
+#if defined(__AVX2__)
+    i = epi8::ColorMaskRow<epi8::Ops32>(r0, r1, i, half_width, color_first, own_minus_other, threshold, binary, out);
+#endif
+#if (defined(__x86_64__) && defined(__SSSE3__)) || defined(__aarch64__)
+    i = epi8::ColorMaskRow<epi8::Ops16>(r0, r1, i, half_width, color_first, own_minus_other, threshold, binary, out);
+#endif
+    for (; i < half_width; ++i)
+      out[i] = epi8::ColorMaskPixel(r0, r1, i, color_first, own_minus_other, threshold, binary);
+  }
+  return true;
+}
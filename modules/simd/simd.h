@@ -1,6 +1,8 @@
 #ifndef SRM_IC_2023_MODULES_SIMD_SIMD_H_
 #define SRM_IC_2023_MODULES_SIMD_SIMD_H_
 
+#include <cstddef>
+
 namespace simd {
 void sin_cos_4f(const float x[4], float s[4], float c[4]);
 void sin_4f(float x[4]);
@@ -14,6 +16,60 @@ void atan2_4f(const float y[4], const float x[4], float res[4]);
 float atan2_f(float y, float x);
 float sqrt_f(float x);
 float rsqrt_f(float x);
+
+/// 双精度版本，误差上界见 math-pd.h
+void sin_cos_2d(const double x[2], double s[2], double c[2]);
+void sin_cos_4d(const double x[4], double s[4], double c[4]);
+void sin_4d(double x[4]);
+double sin_d(double x);
+void cos_4d(double x[4]);
+double cos_d(double x);
+void atan2_2d(const double y[2], const double x[2], double res[2]);
+void atan2_4d(const double y[4], const double x[4], double res[4]);
+double atan2_d(double y, double x);
+void sqrt_4d(double x[4]);
+double sqrt_d(double x);
+
+enum class BayerPattern { RG, GR, GB, BG };  ///< Bayer 阵列排列，以图像左上角 2x2 单元的第一行命名
+enum class DemosaicFormat { BGR, RGB, HALF_BGR, HALF_RGB };  ///< 解马赛克输出格式，HALF 为长宽减半
+
+/**
+ * @brief 8 位 Bayer 图像解马赛克，一次遍历直接写入目标缓冲区
+ * @details 全分辨率输出与 OpenCV 双线性插值逐像素一致，半分辨率输出将每个 2x2 单元合并为一个像素，误差定义见 demosaic-epi8.h
+ * @param [in] src 源图像首地址，可直接使用相机 SDK 缓冲区
+ * @param width 源图像宽度
+ * @param height 源图像高度
+ * @param src_step 源图像行字节数
+ * @param [out] dst 目标图像首地址，3 通道，尺寸由输出格式决定
+ * @param dst_step 目标图像行字节数
+ * @param pattern 源图像 Bayer 阵列排列
+ * @param format 输出格式
+ * @return 图像尺寸是否合法，宽和高须为不小于 4 的偶数
+ */
+bool demosaic_8u(const unsigned char *src, int width, int height, size_t src_step,
+                 unsigned char *dst, size_t dst_step, BayerPattern pattern, DemosaicFormat format);
+
+enum class LightColor { RED, BLUE };  ///< 灯条颜色
+
+/**
+ * @brief 由 8 位 Bayer 图像直接生成半分辨率色差掩码，用于灯条分割
+ * @details 每个 2x2 单元输出一个像素，色差为目标颜色减去另一颜色（R - B 或 B - R，负值记为 0），
+ *   色差大于阈值时输出 255（二值）或色差本身（8 位），否则输出 0；与先解马赛克再求色差相比，只读取一次源图像且输出仅为其四分之一
+ * @param [in] src 源图像首地址，可直接使用相机 SDK 缓冲区
+ * @param width 源图像宽度
+ * @param height 源图像高度
+ * @param src_step 源图像行字节数
+ * @param [out] dst 目标图像首地址，单通道，尺寸为源图像的一半
+ * @param dst_step 目标图像行字节数
+ * @param pattern 源图像 Bayer 阵列排列
+ * @param color 目标灯条颜色
+ * @param threshold 色差阈值
+ * @param binary 是否输出二值掩码
+ * @return 图像尺寸是否合法，宽和高须为不小于 4 的偶数
+ */
+bool color_mask_8u(const unsigned char *src, int width, int height, size_t src_step,
+                   unsigned char *dst, size_t dst_step, BayerPattern pattern,
+                   LightColor color, unsigned char threshold, bool binary);
 }
 
 #endif  // SRM_IC_2023_MODULES_SIMD_SIMD_H_
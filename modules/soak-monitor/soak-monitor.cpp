@@ -0,0 +1,155 @@
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <glog/logging.h>
+#include <opencv2/core/persistence.hpp>
+#include "common/frame.h"
+#include "soak-monitor.h"
+
+namespace {
+/// 各指标的名称与增长率单位，与 Sample::values 的顺序一致
+constexpr std::array<const char *, soak_monitor::kMetrics> kMetricNames = {
+    "RSS", "open files", "threads", "frame", "detect", "associate", "aim", "total"};
+constexpr std::array<const char *, soak_monitor::kMetrics> kMetricUnits = {
+    "MB/h", "per hour", "per hour", "ms/h", "ms/h", "ms/h", "ms/h", "ms/h"};
+}
+
+bool soak_monitor::Param::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage soak_config;
+  soak_config.open(config_file, cv::FileStorage::READ);
+  if (!soak_config.isOpened()) {
+    LOG(ERROR) << "Failed to open soak monitor configuration file " << config_file << ".";
+    return false;
+  }
+  soak_config["SAMPLE_INTERVAL"] >> sample_interval;
+  soak_config["WARMUP"] >> warmup;
+  soak_config["WINDOW"] >> window;
+  soak_config["RSS_DRIFT"] >> rss_drift;
+  soak_config["FD_DRIFT"] >> fd_drift;
+  soak_config["THREAD_DRIFT"] >> thread_drift;
+  soak_config["LATENCY_DRIFT"] >> latency_drift;
+  if (sample_interval <= 0 || warmup < 0 || window < 3) {
+    LOG(ERROR) << "Invalid sampling configurations. Sample interval must be positive and window at least 3.";
+    return false;
+  }
+  if (rss_drift <= 0 || fd_drift <= 0 || thread_drift <= 0 || latency_drift <= 0) {
+    LOG(ERROR) << "Invalid drift thresholds. They must be positive.";
+    return false;
+  }
+  return true;
+}
+
+soak_monitor::SoakMonitor::~SoakMonitor() {
+  if (!enabled_ || !has_first_sample_ || samples_.empty()) return;
+  auto &&last_sample = samples_.back();
+  LOG(INFO) << std::fixed << std::setprecision(2) << "Soak run of " << last_sample.uptime << " h: RSS "
+            << first_sample_.values[0] << " -> " << last_sample.values[0] << " MB, open files "
+            << static_cast<int>(first_sample_.values[1]) << " -> " << static_cast<int>(last_sample.values[1])
+            << ", threads " << static_cast<int>(first_sample_.values[2]) << " -> "
+            << static_cast<int>(last_sample.values[2]) << " since warmup.";
+}
+
+bool soak_monitor::SoakMonitor::Initialize(std::string REF_IN config_file) {
+  if (!param_.Initialize(config_file)) {
+    LOG(ERROR) << "Failed to read soak monitor configurations.";
+    return false;
+  }
+  start_time_ = last_sample_time_ = Frame::HostTime();
+  stage_sum_.fill(0);
+  stage_count_.fill(0);
+  samples_.clear();
+  has_first_sample_ = false;
+  drifting_.fill(false);
+  enabled_ = true;
+  LOG(INFO) << "Soak monitor samples every " << param_.sample_interval << " s after " << param_.warmup
+            << " s of warmup.";
+  return true;
+}
+
+void soak_monitor::SoakMonitor::Update() {
+  if (!enabled_) return;
+  auto host_time = Frame::HostTime();
+  if (static_cast<double>(host_time - last_sample_time_) * 1e-9 < param_.sample_interval) return;
+  last_sample_time_ = host_time;
+  Sample sample{static_cast<double>(host_time - start_time_) * 1e-9 / 3600, {}};
+  if (!ReadProcess(sample)) {
+    LOG(WARNING) << "Failed to read process resource usage.";
+    return;
+  }
+  for (size_t i = 0; i < kStages; ++i) {
+    sample.values[3 + i] = stage_count_[i] ? static_cast<double>(stage_sum_[i]) * 1e-6 / stage_count_[i] : NAN;
+    stage_sum_[i] = stage_count_[i] = 0;
+  }
+  std::ostringstream stage_latency;
+  stage_latency << std::fixed << std::setprecision(2);
+  for (size_t i = 3; i < kMetrics; ++i)
+    if (!std::isnan(sample.values[i])) stage_latency << " " << kMetricNames[i] << " " << sample.values[i];
+  LOG(INFO) << std::fixed << std::setprecision(2) << "Soak sample at " << sample.uptime << " h: RSS "
+            << sample.values[0] << " MB, " << static_cast<int>(sample.values[1]) << " open files, "
+            << static_cast<int>(sample.values[2]) << " threads, mean stage latency (ms)" << stage_latency.str() << ".";
+  // 预热期内缓存、内存池与连接逐渐建立，资源增长属于正常现象
+  if (sample.uptime * 3600 < param_.warmup) return;
+  if (!has_first_sample_) {
+    first_sample_ = sample;
+    has_first_sample_ = true;
+  }
+  samples_.push_back(sample);
+  if (samples_.size() > static_cast<size_t>(param_.window)) samples_.pop_front();
+  if (samples_.size() < static_cast<size_t>(param_.window)) return;
+  for (size_t i = 0; i < kMetrics; ++i) {
+    double slope;
+    if (!FitSlope(i, slope)) continue;
+    auto threshold = i < 3 ? std::array{param_.rss_drift, param_.fd_drift, param_.thread_drift}[i]
+                           : param_.latency_drift;
+    if (slope > threshold && !drifting_[i])
+      LOG(WARNING) << std::fixed << std::setprecision(2) << "Upward drift of " << kMetricNames[i] << ": " << slope
+                   << " " << kMetricUnits[i] << " over the last " << samples_.back().uptime - samples_.front().uptime
+                   << " h, threshold " << threshold << ".";
+    else if (slope <= threshold && drifting_[i])
+      LOG(INFO) << "Drift of " << kMetricNames[i] << " has stopped.";
+    drifting_[i] = slope > threshold;
+  }
+}
+
+bool soak_monitor::SoakMonitor::ReadProcess(Sample REF_OUT sample) {
+  std::ifstream status("/proc/self/status");
+  bool rss_found = false, threads_found = false;
+  for (std::string line; std::getline(status, line);) {
+    if (line.rfind("VmRSS:", 0) == 0) {
+      sample.values[0] = std::strtod(line.c_str() + 6, nullptr) / 1024;
+      rss_found = true;
+    } else if (line.rfind("Threads:", 0) == 0) {
+      sample.values[2] = std::strtod(line.c_str() + 8, nullptr);
+      threads_found = true;
+    }
+  }
+  // 遍历目录本身打开的描述符也会列出，不计入
+  std::error_code error;
+  size_t fds = 0;
+  for (std::filesystem::directory_iterator fd("/proc/self/fd", error), end; !error && fd != end; fd.increment(error))
+    ++fds;
+  if (error || !fds) return false;
+  sample.values[1] = static_cast<double>(fds - 1);
+  return rss_found && threads_found;
+}
+
+bool soak_monitor::SoakMonitor::FitSlope(size_t metric, double REF_OUT slope) const {
+  // 最小二乘直线拟合，跳过没有数据的样本
+  double n = 0, sum_t = 0, sum_v = 0, sum_tt = 0, sum_tv = 0;
+  for (auto &&sample : samples_) {
+    auto value = sample.values[metric];
+    if (std::isnan(value)) continue;
+    ++n;
+    sum_t += sample.uptime;
+    sum_v += value;
+    sum_tt += sample.uptime * sample.uptime;
+    sum_tv += sample.uptime * value;
+  }
+  auto denominator = n * sum_tt - sum_t * sum_t;
+  if (n < 3 || denominator <= 0) return false;
+  slope = (n * sum_tv - sum_t * sum_v) / denominator;
+  return true;
+}
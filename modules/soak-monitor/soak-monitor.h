@@ -0,0 +1,110 @@
+#ifndef SRM_IC_2023_MODULES_SOAK_MONITOR_SOAK_MONITOR_H_
+#define SRM_IC_2023_MODULES_SOAK_MONITOR_SOAK_MONITOR_H_
+
+#include <array>
+#include <deque>
+#include <string>
+#include "common/syntactic-sugar.h"
+
+namespace soak_monitor {
+/// 主循环中计时的处理阶段
+enum class Stage {
+  FRAME,      ///< 取帧，含实时节奏下的等待
+  DETECT,     ///< 装甲板识别
+  ASSOCIATE,  ///< 多目标数据关联
+  AIM,        ///< 目标预测、弹道解算与串口写入
+  TOTAL,      ///< 主机收到帧到本帧处理完成
+};
+
+constexpr size_t kStages = 5;             ///< 处理阶段数
+constexpr size_t kMetrics = 3 + kStages;  ///< 监视的指标数：常驻内存、文件描述符数、线程数与各阶段耗时
+
+/// 长时间运行监视参数
+struct Param {
+  double sample_interval{};  ///< 采样间隔，单位：s
+  double warmup{};           ///< 启动后不参与趋势拟合的时间，单位：s
+  int window{};              ///< 趋势拟合使用的最近样本数
+  double rss_drift{};        ///< 常驻内存增长率阈值，单位：MB/h
+  double fd_drift{};         ///< 打开的文件描述符增长率阈值，单位：个/h
+  double thread_drift{};     ///< 线程数增长率阈值，单位：个/h
+  double latency_drift{};    ///< 各阶段平均耗时增长率阈值，单位：ms/h
+
+  /**
+   * @brief 从配置文件读取参数
+   * @param [in] config_file 配置文件路径
+   * @return 是否读取成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+};
+
+/**
+ * @brief 长时间运行监视器，定期采样进程资源占用与各处理阶段耗时，发现持续上升的趋势时报警
+ * @details 每个采样间隔读取 /proc/self 下的常驻内存、打开的文件描述符数与线程数，并计算间隔内各阶段的平均耗时；
+ *   预热期之后以最近 window 个样本做最小二乘直线拟合，斜率超过阈值时报警，回落后提示恢复；
+ *   析构时输出预热期结束以来各资源的总变化；全部操作在主循环线程中进行，不创建线程
+ */
+class SoakMonitor final {
+ public:
+  SoakMonitor() = default;
+  ~SoakMonitor();
+
+  /// 是否已开启监视
+  attr_reader_val(enabled_, Enabled)
+
+  /**
+   * @brief 初始化并开启监视
+   * @param [in] config_file 配置文件路径
+   * @return 是否初始化成功
+   */
+  bool Initialize(std::string REF_IN config_file);
+
+  /**
+   * @brief 记录一次处理阶段的耗时，未开启监视时直接返回
+   * @param stage 处理阶段
+   * @param duration 耗时，单位：ns
+   */
+  void Record(Stage stage, uint64_t duration) {
+    if (!enabled_) return;
+    stage_sum_[static_cast<size_t>(stage)] += duration;
+    ++stage_count_[static_cast<size_t>(stage)];
+  }
+
+  /// 主循环每次迭代调用，到达采样间隔时采样并检查趋势
+  void Update();
+
+ private:
+  /// 一次采样
+  struct Sample {
+    double uptime;                        ///< 启动后的时间，单位：h
+    std::array<double, kMetrics> values;  ///< 各指标的值，没有数据的阶段耗时为 NaN
+  };
+
+  /**
+   * @brief 读取进程资源占用
+   * @param [out] sample 写入常驻内存、文件描述符数与线程数
+   * @return 是否读取成功
+   */
+  static bool ReadProcess(Sample REF_OUT sample);
+
+  /**
+   * @brief 以最近的样本拟合指标的增长率
+   * @param metric 指标序号
+   * @param [out] slope 增长率，单位：指标单位/h
+   * @return 有效样本是否足够拟合
+   */
+  bool FitSlope(size_t metric, double REF_OUT slope) const;
+
+  Param param_;                                  ///< 监视参数
+  bool enabled_{};                               ///< 是否已开启监视
+  uint64_t start_time_{};                        ///< 开启监视的主机时间，单位：ns
+  uint64_t last_sample_time_{};                  ///< 上次采样的主机时间，单位：ns
+  std::array<uint64_t, kStages> stage_sum_{};    ///< 本采样间隔内各阶段的总耗时，单位：ns
+  std::array<uint64_t, kStages> stage_count_{};  ///< 本采样间隔内各阶段的计时次数
+  std::deque<Sample> samples_;                   ///< 预热期之后最近的样本
+  bool has_first_sample_{};                      ///< 是否已记录预热期结束后的第一个样本
+  Sample first_sample_{};                        ///< 预热期结束后的第一个样本
+  std::array<bool, kMetrics> drifting_{};        ///< 各指标是否处于报警状态
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_SOAK_MONITOR_SOAK_MONITOR_H_
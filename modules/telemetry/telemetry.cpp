@@ -0,0 +1,175 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <glog/logging.h>
+#include "common/frame.h"
+#include "telemetry.h"
+
+#define MAINTENANCE_INTERVAL 10
+
+namespace {
+constexpr size_t kSegmentSize = sizeof(telemetry::Header) + telemetry::kSegmentRecords * sizeof(telemetry::Record);
+
+static_assert(std::is_trivially_copyable_v<telemetry::Record>, "Records are written to files as raw bytes.");
+static_assert(sizeof(telemetry::Header) % alignof(telemetry::Record) == 0, "Records must stay aligned in files.");
+}
+
+telemetry::TelemetryLog::~TelemetryLog() {
+  Close();
+}
+
+bool telemetry::TelemetryLog::Open(std::string REF_IN prefix) {
+  if (current_) return false;
+  prefix_ = prefix;
+  segments_ = 0;
+  dropped_ = 0;
+  auto segment = CreateSegment(segments_++);
+  if (!segment) return false;
+  current_ = segment;
+  stop_flag_ = false;
+  maintenance_thread_ = std::thread(&TelemetryLog::MaintenanceThreadFunction, this);
+  LOG(INFO) << "Telemetry is logged to " << segment->path << ".";
+  return true;
+}
+
+void telemetry::TelemetryLog::Close() {
+  if (!current_) return;
+  stop_flag_ = true;
+  if (maintenance_thread_.joinable()) maintenance_thread_.join();
+  if (retired_) CloseSegment(retired_);
+  CloseSegment(current_.exchange(nullptr));
+  if (spare_) {
+    // 未使用的预分配分段直接删除
+    unlink(spare_->path.c_str());
+    CloseSegment(spare_);
+    --segments_;
+  }
+  retired_ = spare_ = nullptr;
+  LOG(INFO) << "Telemetry closed with " << segments_ << " segments and " << dropped_ << " dropped records.";
+}
+
+void telemetry::TelemetryLog::Append(RecordType type, const void *payload, size_t size) {
+  auto segment = current_.load(std::memory_order_acquire);
+  if (!segment) return;
+  auto index = segment->next.fetch_add(1, std::memory_order_relaxed);
+  if (index >= kSegmentRecords) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto &&record = segment->records[index];
+  record.time_stamp = Frame::HostTime();
+  memcpy(&record.payload, payload, size);
+  std::atomic_ref<RecordType>(record.type).store(type, std::memory_order_release);
+}
+
+telemetry::TelemetryLog::Segment *telemetry::TelemetryLog::CreateSegment(uint32_t index) {
+  std::ostringstream path;
+  path << prefix_ << "-" << std::setw(3) << std::setfill('0') << index << ".tlm";
+  int fd = open(path.str().c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd == -1) {
+    LOG(ERROR) << "Failed to create telemetry segment " << path.str() << ".";
+    return nullptr;
+  }
+  // 预分配磁盘空间并预读全部页面，写入时不再发生缺页与块分配
+  if (posix_fallocate(fd, 0, kSegmentSize)) {
+    LOG(ERROR) << "Failed to allocate " << kSegmentSize << " bytes for telemetry segment " << path.str() << ".";
+    close(fd);
+    unlink(path.str().c_str());
+    return nullptr;
+  }
+  auto address = mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+  if (address == MAP_FAILED) {
+    LOG(ERROR) << "Failed to map telemetry segment " << path.str() << ".";
+    close(fd);
+    unlink(path.str().c_str());
+    return nullptr;
+  }
+  auto header = static_cast<Header *>(address);
+  *header = {kMagic, sizeof(Record), index, 0, 0};
+  return new Segment{path.str(), fd, header, reinterpret_cast<Record *>(header + 1), {0}};
+}
+
+void telemetry::TelemetryLog::CloseSegment(Segment *segment) {
+  auto records = std::min<uint64_t>(segment->next, kSegmentRecords);
+  segment->header->records = records;
+  munmap(segment->header, kSegmentSize);
+  if (ftruncate(segment->fd, static_cast<off_t>(sizeof(Header) + records * sizeof(Record))) == -1)
+    LOG(WARNING) << "Failed to truncate telemetry segment " << segment->path << ".";
+  close(segment->fd);
+  delete segment;
+}
+
+void telemetry::TelemetryLog::MaintenanceThreadFunction() {
+  while (!stop_flag_) {
+    if (!spare_) spare_ = CreateSegment(segments_++);
+    if (!spare_) --segments_;
+    auto segment = current_.load(std::memory_order_relaxed);
+    if (spare_ && segment->next.load(std::memory_order_relaxed) >= kRotateRecords) {
+      current_.store(spare_, std::memory_order_release);
+      spare_ = nullptr;
+      // 上一个分段在一整个分段的写入时间之前被替换，其写入方早已完成
+      if (retired_) CloseSegment(retired_);
+      retired_ = segment;
+      LOG(INFO) << "Telemetry rotated to " << current_.load()->path << ".";
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(MAINTENANCE_INTERVAL));
+  }
+}
+
+bool telemetry::Decode(std::string REF_IN log_file, std::string REF_IN csv_file) {
+  std::ifstream input(log_file, std::ios::binary);
+  Header header{};
+  if (!input.read(reinterpret_cast<char *>(&header), sizeof(Header))) {
+    LOG(ERROR) << "Failed to read telemetry file " << log_file << ".";
+    return false;
+  }
+  if (header.magic != kMagic || header.record_size != sizeof(Record)) {
+    LOG(ERROR) << "Telemetry file " << log_file << " has an unknown format or record size " << header.record_size
+               << ".";
+    return false;
+  }
+  std::ofstream output(csv_file);
+  if (!output) {
+    LOG(ERROR) << "Failed to create CSV file " << csv_file << ".";
+    return false;
+  }
+  output << "time_stamp,type,mode,armor_kind,color,bullet_speed,yaw,pitch,roll,"
+         << "command_yaw,command_pitch,distance_mode,fire,"
+         << "frame_time_stamp,target_x,target_y,target_z,aim_yaw,aim_pitch,flight_time,command_delay,"
+         << "track_id,aim_fire\n";
+  output << std::setprecision(9);
+  Record record{};
+  uint64_t records = 0, skipped = 0;
+  while (input.read(reinterpret_cast<char *>(&record), sizeof(Record))) {
+    auto &&payload = record.payload;
+    switch (record.type) {
+      case RecordType::RECEIVE:
+        output << record.time_stamp << ",RECEIVE," << payload.receive.mode << "," << payload.receive.armor_kind << ","
+               << payload.receive.color << "," << payload.receive.bullet_speed << "," << payload.receive.yaw << ","
+               << payload.receive.pitch << "," << payload.receive.roll << ",,,,,,,,,,,,,,\n";
+        break;
+      case RecordType::SEND:
+        output << record.time_stamp << ",SEND,,,,,,,," << payload.send.yaw << "," << payload.send.pitch << ","
+               << payload.send.distance_mode << "," << payload.send.fire << ",,,,,,,,,,\n";
+        break;
+      case RecordType::SOLVER:
+        output << record.time_stamp << ",SOLVER,,,,,,,,,,,," << payload.solver.frame_time_stamp << ","
+               << payload.solver.target[0] << "," << payload.solver.target[1] << "," << payload.solver.target[2] << ","
+               << payload.solver.yaw << "," << payload.solver.pitch << "," << payload.solver.flight_time << ","
+               << payload.solver.command_delay << "," << payload.solver.track_id << "," << payload.solver.fire << "\n";
+        break;
+      default:
+        ++skipped;
+        continue;
+    }
+    ++records;
+  }
+  LOG(INFO) << "Decoded " << records << " records from " << log_file << " to " << csv_file << ", skipped "
+            << skipped << " incomplete records.";
+  return true;
+}
@@ -0,0 +1,144 @@
+#ifndef SRM_IC_2023_MODULES_TELEMETRY_TELEMETRY_H_
+#define SRM_IC_2023_MODULES_TELEMETRY_TELEMETRY_H_
+
+#include <atomic>
+#include <thread>
+#include "common/packet.h"
+
+namespace telemetry {
+constexpr uint64_t kMagic = 0x314D4C544D5253;               ///< 文件头魔数，小端序为 "SRMTLM1"
+constexpr size_t kSegmentRecords = 1 << 20;                 ///< 每个分段的记录数
+constexpr size_t kRotateRecords = kSegmentRecords * 3 / 4;  ///< 当前分段写入超过此数量后切换到预分配的分段
+
+/// 记录类型
+enum class RecordType : uint32_t {
+  NONE = 0,     ///< 未写完的记录
+  RECEIVE = 1,  ///< 串口收到的 ReceivePacket
+  SEND = 2,     ///< 串口发出的 SendPacket
+  SOLVER = 3,   ///< 每帧的解算结果
+};
+
+/// 每帧的解算结果
+struct SolverRecord {
+  uint64_t frame_time_stamp;  ///< 帧时间戳，单位：ns
+  float target[3];            ///< 瞄准点的世界坐标系直角坐标，单位：m
+  float yaw;                  ///< 弹道解算的 yaw，单位：rad
+  float pitch;                ///< 弹道解算的 pitch，单位：rad
+  float flight_time;          ///< 弹丸飞行时间，单位：s，无解时为 0
+  float command_delay;        ///< 从曝光到指令生效的估计时间，单位：s
+  int32_t track_id;           ///< 目标轨迹编号
+  int32_t fire;               ///< 是否开火
+};
+
+/// 定长记录
+struct Record {
+  RecordType type;      ///< 记录类型，写完负载后最后写入
+  uint32_t reserved;    ///< 保留
+  uint64_t time_stamp;  ///< 主机时间，与 Frame::HostTime() 同一时钟，单位：ns
+  union {
+    ReceivePacket receive;
+    SendPacket send;
+    SolverRecord solver;
+  } payload;  ///< 负载，按 type 解释
+};
+
+/// 分段文件头
+struct Header {
+  uint64_t magic;        ///< 魔数 kMagic
+  uint32_t record_size;  ///< sizeof(Record)，用于检查版本
+  uint32_t segment;      ///< 分段序号
+  uint64_t records;      ///< 正常关闭时写入的记录数，异常退出时为 0，解码时以 type 判断有效记录
+  uint64_t reserved;     ///< 保留
+};
+
+/**
+ * @brief 内存映射的二进制遥测日志
+ * @details 记录写入预分配、以 MAP_SHARED 映射的分段文件，写入方以原子加法占用槽位，先写负载后以 release 写入类型，
+ *   不加锁、不进入内核，可在串口收发线程与主循环中同时调用；后台线程提前创建并预读下一个分段，
+ *   当前分段写入超过 kRotateRecords 后切换，被替换的分段在下一次切换时截断到实际长度并关闭，
+ *   切换前已占用旧分段槽位的写入方有整个分段的时间完成写入；分段写满而尚未切换时丢弃记录并计数
+ */
+class TelemetryLog final {
+ public:
+  TelemetryLog() = default;
+  ~TelemetryLog();
+
+  /**
+   * @brief 获取丢弃的记录数
+   * @return 记录数
+   */
+  [[nodiscard]] uint64_t Dropped() const { return dropped_; }
+
+  /**
+   * @brief 打开日志
+   * @param [in] prefix 分段文件路径前缀，分段文件名为 <prefix>-<序号>.tlm
+   * @return 是否打开成功
+   */
+  bool Open(std::string REF_IN prefix);
+
+  /// 关闭日志，调用前须确保没有其他线程正在写入
+  void Close();
+
+  /// 记录串口收到的数据包，未打开时忽略
+  void Log(ReceivePacket REF_IN packet) { Append(RecordType::RECEIVE, &packet, sizeof(packet)); }
+
+  /// 记录串口发出的数据包，未打开时忽略
+  void Log(SendPacket REF_IN packet) { Append(RecordType::SEND, &packet, sizeof(packet)); }
+
+  /// 记录一帧的解算结果，未打开时忽略
+  void Log(SolverRecord REF_IN record) { Append(RecordType::SOLVER, &record, sizeof(record)); }
+
+ private:
+  /// 映射的分段文件
+  struct Segment {
+    std::string path;           ///< 文件路径
+    int fd;                     ///< 文件描述符
+    Header *header;             ///< 映射的文件头
+    Record *records;            ///< 映射的记录数组
+    std::atomic_uint64_t next;  ///< 下一个空闲槽位
+  };
+
+  /**
+   * @brief 写入一条记录
+   * @param type 记录类型
+   * @param [in] payload 负载首地址
+   * @param size 负载字节数
+   */
+  void Append(RecordType type, const void *payload, size_t size);
+
+  /**
+   * @brief 创建、预分配并映射一个分段
+   * @param index 分段序号
+   * @return 分段，失败时为 nullptr
+   */
+  Segment *CreateSegment(uint32_t index);
+
+  /**
+   * @brief 截断分段到实际长度并关闭
+   * @param [in] segment 分段
+   */
+  static void CloseSegment(Segment *segment);
+
+  void MaintenanceThreadFunction();
+
+  std::string prefix_;                ///< 分段文件路径前缀
+  std::atomic<Segment *> current_{};  ///< 当前写入的分段
+  Segment *spare_{};                  ///< 预分配的下一个分段，仅由后台线程访问
+  Segment *retired_{};                ///< 上一个分段，下一次切换时关闭
+  uint32_t segments_{};               ///< 已创建的分段数
+  std::atomic_uint64_t dropped_{};    ///< 丢弃的记录数
+  std::thread maintenance_thread_;    ///< 后台线程
+  std::atomic_bool stop_flag_{};      ///< 后台线程停止信号
+};
+
+/**
+ * @brief 将一个分段文件解码为 CSV
+ * @details 每条记录一行，按类型填写对应的列，其余列留空；未写完的记录被跳过
+ * @param [in] log_file 分段文件路径
+ * @param [in] csv_file 输出的 CSV 文件路径
+ * @return 是否解码成功
+ */
+bool Decode(std::string REF_IN log_file, std::string REF_IN csv_file);
+}
+
+#endif  // SRM_IC_2023_MODULES_TELEMETRY_TELEMETRY_H_
@@ -0,0 +1,55 @@
+#include "thread-pool.h"
+
+thread_pool::ThreadPool::ThreadPool(size_t threads) {
+  if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t i = 1; i < threads; ++i)
+    workers_.emplace_back([this]() {
+      size_t generation = 0;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock{lock_};
+          start_cv_.wait(lock, [&]() { return stop_ || generation_ != generation; });
+          if (stop_) return;
+          generation = generation_;
+        }
+        Work();
+        std::lock_guard<std::mutex> lock{lock_};
+        if (!--busy_workers_) finish_cv_.notify_one();
+      }
+    });
+}
+
+thread_pool::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{lock_};
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto &&worker : workers_)
+    if (worker.joinable()) worker.join();
+}
+
+void thread_pool::ThreadPool::ParallelFor(size_t n, std::function<void(size_t)> REF_IN func) {
+  if (workers_.empty() || n <= 1) {
+    for (size_t i = 0; i < n; ++i) func(i);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock{lock_};
+    func_ = &func;
+    task_count_ = n;
+    next_task_ = 0;
+    busy_workers_ = workers_.size();
+    ++generation_;
+  }
+  start_cv_.notify_all();
+  Work();
+  std::unique_lock<std::mutex> lock{lock_};
+  finish_cv_.wait(lock, [this]() { return !busy_workers_; });
+  func_ = nullptr;
+}
+
+void thread_pool::ThreadPool::Work() {
+  for (auto i = next_task_++; i < task_count_; i = next_task_++)
+    (*func_)(i);
+}
@@ -0,0 +1,58 @@
+#ifndef SRM_IC_2023_MODULES_THREAD_POOL_THREAD_POOL_H_
+#define SRM_IC_2023_MODULES_THREAD_POOL_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/syntactic-sugar.h"
+
+namespace thread_pool {
+/**
+ * @brief 固定大小的线程池，用于帧内数据并行
+ * @details ParallelFor 将 [0, n) 的下标逐个分发给工作线程和调用线程，全部完成后返回；
+ *   任务的执行顺序不确定，结果须按下标写入各自的输出位置，由调用者按下标顺序合并
+ */
+class ThreadPool final {
+ public:
+  /**
+   * @brief 创建线程池
+   * @param threads 并行线程数（含调用线程），0 表示使用硬件并发数
+   */
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool REF_IN) = delete;
+  ThreadPool &operator=(ThreadPool REF_IN) = delete;
+
+  /// 并行线程数（含调用线程）
+  attr_reader_val(workers_.size() + 1, Threads)
+
+  /**
+   * @brief 并行执行任务，阻塞直至全部完成
+   * @param n 任务数
+   * @param [in] func 任务函数，参数为任务下标
+   * @warning 不可重入，不可在任务函数中再次调用
+   */
+  void ParallelFor(size_t n, std::function<void(size_t)> REF_IN func);
+
+ private:
+  /// 领取并执行任务直至全部分发完毕
+  void Work();
+
+  std::vector<std::thread> workers_;           ///< 工作线程
+  std::mutex lock_;                            ///< 任务状态锁
+  std::condition_variable start_cv_;           ///< 新任务信号
+  std::condition_variable finish_cv_;          ///< 任务完成信号
+  const std::function<void(size_t)> *func_{};  ///< 当前任务函数
+  size_t task_count_{};                        ///< 当前任务数
+  std::atomic<size_t> next_task_{};            ///< 下一个待领取的任务下标
+  size_t generation_{};                        ///< 任务批次编号，用于唤醒工作线程
+  size_t busy_workers_{};                      ///< 仍在执行当前批次的工作线程数
+  bool stop_{};                                ///< 线程池停止信号
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_THREAD_POOL_THREAD_POOL_H_
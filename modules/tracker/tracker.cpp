@@ -0,0 +1,141 @@
+#include <glog/logging.h>
+#include <Eigen/Dense>
+#include <opencv2/core/persistence.hpp>
+#include "tracker.h"
+
+namespace {
+/**
+ * @brief 计算两个时间戳之间的间隔
+ * @param from 起始时间戳，单位：ns
+ * @param to 终止时间戳，单位：ns
+ * @return 时间间隔，单位：s，终止时间早于起始时间时为负
+ */
+inline double Interval(uint64_t from, uint64_t to) {
+  return static_cast<double>(static_cast<int64_t>(to - from)) * 1e-9;
+}
+
+/**
+ * @brief 计算 n 的阶乘
+ * @param n 非负整数
+ * @return n!
+ */
+constexpr double Factorial(int n) { return n <= 1 ? 1 : n * Factorial(n - 1); }
+}
+
+bool tracker::Param::Initialize(std::string REF_IN config_file, std::string REF_IN model) {
+  cv::FileStorage tracker_config;
+  tracker_config.open(config_file, cv::FileStorage::READ);
+  if (!tracker_config.isOpened()) {
+    LOG(ERROR) << "Failed to open tracker configuration file " << config_file << ".";
+    return false;
+  }
+  auto node = tracker_config[model];
+  if (node.empty()) {
+    LOG(ERROR) << "Motion model " << model << " not found in tracker configuration file " << config_file << ".";
+    return false;
+  }
+  std::vector<double> measurement_noise_std;
+  node["PROCESS_NOISE"] >> process_noise;
+  node["MEASUREMENT_NOISE"] >> measurement_noise_std;
+  node["VELOCITY_NOISE"] >> velocity_noise;
+  node["ACCELERATION_NOISE"] >> acceleration_noise;
+  if (measurement_noise_std.size() != 3 || process_noise <= 0 || velocity_noise <= 0 || acceleration_noise < 0
+      || measurement_noise_std[0] <= 0 || measurement_noise_std[1] <= 0 || measurement_noise_std[2] <= 0) {
+    LOG(ERROR) << "Invalid " << model << " tracker configurations. All noises must be positive.";
+    return false;
+  }
+  measurement_noise << measurement_noise_std[0], measurement_noise_std[1], measurement_noise_std[2];
+  return true;
+}
+
+template<int Order>
+void tracker::Tracker<Order>::Reset(coordinate::STVec REF_IN stv_world, uint64_t time_stamp) {
+  double phi_sin = std::sin(stv_world.x()), phi_cos = std::cos(stv_world.x()),
+      theta_sin = std::sin(stv_world.y()), theta_cos = std::cos(stv_world.y()), r = stv_world.z();
+  // 球坐标测量噪声经 STVecToCTVec 的雅可比矩阵传播到直角坐标
+  Eigen::Matrix3d jacobian;
+  jacobian << r * theta_cos * phi_cos, -r * theta_sin * phi_sin, theta_cos * phi_sin,
+      0, -r * theta_cos, -theta_sin,
+      -r * theta_cos * phi_sin, -r * theta_sin * phi_cos, theta_cos * phi_cos;
+  Eigen::Vector3d r_diagonal(param_.measurement_noise.x(), param_.measurement_noise.y(),
+                             param_.measurement_noise.z() * r);
+  x_.setZero();
+  x_.template head<3>() = coordinate::CoordSolver::STVecToCTVec(stv_world);
+  p_.setZero();
+  p_.template topLeftCorner<3, 3>() = jacobian * r_diagonal.cwiseAbs2().asDiagonal() * jacobian.transpose();
+  p_.template block<3, 3>(3, 3) = Eigen::Matrix3d::Identity() * (param_.velocity_noise * param_.velocity_noise);
+  if constexpr (Order == 3)
+    p_.template block<3, 3>(6, 6) =
+        Eigen::Matrix3d::Identity() * (param_.acceleration_noise * param_.acceleration_noise);
+  time_stamp_ = time_stamp;
+  initialized_ = true;
+}
+
+template<int Order>
+void tracker::Tracker<Order>::Predict(uint64_t time_stamp) {
+  double dt = Interval(time_stamp_, time_stamp);
+  if (!initialized_ || dt <= 0) return;
+  // 状态转移矩阵与过程噪声矩阵都是 Order x Order 标量矩阵与三阶单位阵的克罗内克积，逐块填充
+  double dt_pow[2 * Order];
+  dt_pow[0] = 1;
+  for (auto k = 1; k < 2 * Order; ++k) dt_pow[k] = dt_pow[k - 1] * dt;
+  PMat f = PMat::Identity(), q = PMat::Zero();
+  for (auto i = 0; i < Order; ++i)
+    for (auto j = 0; j < Order; ++j) {
+      if (j > i) f.template block<3, 3>(3 * i, 3 * j).diagonal().setConstant(dt_pow[j - i] / Factorial(j - i));
+      int power = 2 * Order - 1 - i - j;
+      q.template block<3, 3>(3 * i, 3 * j).diagonal().setConstant(
+          param_.process_noise * dt_pow[power]
+              / (Factorial(Order - 1 - i) * Factorial(Order - 1 - j) * power));
+    }
+  x_ = f * x_;
+  p_ = f * p_ * f.transpose() + q;
+  time_stamp_ = time_stamp;
+}
+
+template<int Order>
+void tracker::Tracker<Order>::Update(coordinate::STVec REF_IN stv_world, uint64_t time_stamp) {
+  if (!initialized_) {
+    Reset(stv_world, time_stamp);
+    return;
+  }
+  Predict(time_stamp);
+  auto &&ctv = x_.template head<3>();
+  double rho_2 = ctv.x() * ctv.x() + ctv.z() * ctv.z(), r_2 = rho_2 + ctv.y() * ctv.y();
+  if (rho_2 < 1e-12) return;
+  double rho = std::sqrt(rho_2), r = std::sqrt(r_2);
+  // 测量函数 CTVecToSTVec 在预测位置处的雅可比矩阵，只与位置有关
+  Eigen::Matrix3d h;
+  h << ctv.z() / rho_2, 0, -ctv.x() / rho_2,
+      ctv.x() * ctv.y() / (r_2 * rho), -rho / r_2, ctv.z() * ctv.y() / (r_2 * rho),
+      ctv.x() / r, ctv.y() / r, ctv.z() / r;
+  coordinate::STVec innovation = stv_world - coordinate::CoordSolver::CTVecToSTVec(ctv);
+  innovation.x() = std::remainder(innovation.x(), 2 * M_PI);
+  Eigen::Vector3d r_diagonal(param_.measurement_noise.x(), param_.measurement_noise.y(),
+                             param_.measurement_noise.z() * stv_world.z());
+  Eigen::Matrix<double, kStates, 3> p_ht = p_.template leftCols<3>() * h.transpose();
+  Eigen::Matrix3d s = h * p_ht.template topRows<3>();
+  s.diagonal() += r_diagonal.cwiseAbs2();
+  Eigen::Matrix<double, kStates, 3> k = p_ht * s.inverse();
+  x_ += k * innovation;
+  p_ -= k * p_ht.transpose();
+  p_ = (0.5 * (p_ + p_.transpose())).eval();
+}
+
+template<int Order>
+coordinate::CTVec tracker::Tracker<Order>::Position(uint64_t time_stamp) const {
+  double dt = Interval(time_stamp_, time_stamp);
+  coordinate::CTVec ctv = x_.template segment<3>(0) + dt * x_.template segment<3>(3);
+  if constexpr (Order == 3) ctv += 0.5 * dt * dt * x_.template segment<3>(6);
+  return ctv;
+}
+
+template<int Order>
+coordinate::CTVec tracker::Tracker<Order>::Velocity(uint64_t time_stamp) const {
+  if constexpr (Order == 3)
+    return x_.template segment<3>(3) + Interval(time_stamp_, time_stamp) * x_.template segment<3>(6);
+  else return x_.template segment<3>(3);
+}
+
+template class tracker::Tracker<2>;
+template class tracker::Tracker<3>;
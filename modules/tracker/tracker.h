@@ -0,0 +1,104 @@
+#ifndef SRM_IC_2023_MODULES_TRACKER_TRACKER_H_
+#define SRM_IC_2023_MODULES_TRACKER_TRACKER_H_
+
+#include <Eigen/Core>
+#include "coordinate/coordinate.h"
+
+namespace tracker {
+/// 跟踪滤波器参数
+struct Param {
+  double process_noise{};               ///< 最高阶导数白噪声的功率谱密度，CV 模型单位：m^2/s^3，CA 模型单位：m^2/s^5
+  coordinate::STVec measurement_noise;  ///< 测量标准差，依次为：水平角 rad、俯仰角 rad、距离的相对误差
+  double velocity_noise{};              ///< 初始速度标准差，单位：m/s
+  double acceleration_noise{};          ///< 初始加速度标准差，单位：m/s^2，仅 CA 模型使用
+
+  /**
+   * @brief 从配置文件读取参数
+   * @param [in] config_file 配置文件路径
+   * @param [in] model 运动模型名称，"CV" 或 "CA"，对应配置文件中的节点
+   * @return 是否读取成功
+   */
+  bool Initialize(std::string REF_IN config_file, std::string REF_IN model);
+};
+
+/**
+ * @brief 世界坐标系下的扩展卡尔曼滤波目标跟踪器
+ * @details 状态为目标中心的直角坐标及其前 Order - 1 阶导数，按匀速 (CV) 或匀加速 (CA) 模型外推，
+ *   以最高阶导数的连续白噪声建模过程噪声；测量为 PnP 解算的世界坐标系球坐标，在预测位置处线性化；
+ *   全部矩阵均为固定尺寸，预测与更新不分配内存
+ * @tparam Order 运动模型阶数，2 为匀速模型，3 为匀加速模型
+ */
+template<int Order>
+class Tracker final {
+  static_assert(Order == 2 || Order == 3, "Only constant velocity and constant acceleration models are supported.");
+
+ public:
+  static constexpr int kStates = 3 * Order;              ///< 状态维数
+  using XVec = Eigen::Matrix<double, kStates, 1>;        ///< 状态向量，依次为位置、速度、加速度
+  using PMat = Eigen::Matrix<double, kStates, kStates>;  ///< 状态协方差矩阵
+
+  Tracker() = default;
+  ~Tracker() = default;
+
+  /// 状态向量，单位：m, m/s, m/s^2
+  attr_reader_ref(x_, State)
+  /// 状态协方差矩阵
+  attr_reader_ref(p_, Covariance)
+  /// 当前状态对应的时间戳，单位：ns
+  attr_reader_val(time_stamp_, TimeStamp)
+  /// 是否已由测量初始化
+  attr_reader_val(initialized_, Initialized)
+
+  /**
+   * @brief 设置滤波器参数
+   * @param [in] param 滤波器参数
+   */
+  void SetParam(Param REF_IN param) { param_ = param; }
+
+  /**
+   * @brief 以一次测量重新初始化跟踪器，导数初始化为 0
+   * @param [in] stv_world 目标中心的世界坐标系球坐标
+   * @param time_stamp 测量时间戳，单位：ns
+   */
+  void Reset(coordinate::STVec REF_IN stv_world, uint64_t time_stamp);
+
+  /**
+   * @brief 将状态外推到指定时间
+   * @param time_stamp 目标时间戳，单位：ns，早于当前状态时不做处理
+   */
+  void Predict(uint64_t time_stamp);
+
+  /**
+   * @brief 外推到测量时间并以测量修正状态，未初始化时以该测量初始化
+   * @param [in] stv_world 目标中心的世界坐标系球坐标
+   * @param time_stamp 测量时间戳，单位：ns
+   */
+  void Update(coordinate::STVec REF_IN stv_world, uint64_t time_stamp);
+
+  /**
+   * @brief 计算目标在任意时间的位置，不改变滤波器状态
+   * @param time_stamp 目标时间戳，单位：ns
+   * @return 目标中心的世界坐标系直角坐标
+   */
+  [[nodiscard]] coordinate::CTVec Position(uint64_t time_stamp) const;
+
+  /**
+   * @brief 计算目标在任意时间的速度，不改变滤波器状态
+   * @param time_stamp 目标时间戳，单位：ns
+   * @return 目标在世界坐标系中的速度，单位：m/s
+   */
+  [[nodiscard]] coordinate::CTVec Velocity(uint64_t time_stamp) const;
+
+ private:
+  Param param_;            ///< 滤波器参数
+  XVec x_;                 ///< 状态向量
+  PMat p_;                 ///< 状态协方差矩阵
+  uint64_t time_stamp_{};  ///< 当前状态对应的时间戳，单位：ns
+  bool initialized_{};     ///< 是否已由测量初始化
+};
+
+using CVTracker = Tracker<2>;  ///< 匀速模型跟踪器
+using CATracker = Tracker<3>;  ///< 匀加速模型跟踪器
+}
+
+#endif  // SRM_IC_2023_MODULES_TRACKER_TRACKER_H_
@@ -0,0 +1,41 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "common/frame.h"
+#include "pacing.h"
+
+bool video_source::ParsePacing(std::string REF_IN name, Pacing REF_OUT pacing) {
+  if (name == "realtime") pacing = Pacing::REAL_TIME;
+  else if (name == "max") pacing = Pacing::MAX;
+  else if (name == "step") pacing = Pacing::STEP;
+  else return false;
+  return true;
+}
+
+void video_source::Pacer::Reset(Pacing pacing) {
+  pacing_ = pacing;
+  started_ = false;
+  dropped_ = 0;
+}
+
+bool video_source::Pacer::Late(uint64_t next_time_stamp) {
+  if (pacing_ != Pacing::REAL_TIME || !started_ || ReleaseTime(next_time_stamp) > Frame::HostTime()) return false;
+  ++dropped_;
+  return true;
+}
+
+void video_source::Pacer::Wait(uint64_t time_stamp) {
+  if (pacing_ != Pacing::REAL_TIME) return;
+  if (!started_) {
+    started_ = true;
+    start_host_time_ = Frame::HostTime();
+    start_time_stamp_ = time_stamp;
+    return;
+  }
+  auto release_time = ReleaseTime(time_stamp), host_time = Frame::HostTime();
+  if (release_time > host_time) std::this_thread::sleep_for(std::chrono::nanoseconds(release_time - host_time));
+}
+
+uint64_t video_source::Pacer::ReleaseTime(uint64_t time_stamp) const {
+  return start_host_time_ + (std::max(time_stamp, start_time_stamp_) - start_time_stamp_);
+}
@@ -0,0 +1,72 @@
+#ifndef SRM_IC_2023_MODULES_VIDEO_SOURCE_BASE_PACING_H_
+#define SRM_IC_2023_MODULES_VIDEO_SOURCE_BASE_PACING_H_
+
+#include <cstdint>
+#include <string>
+#include "common/syntactic-sugar.h"
+
+namespace video_source {
+/// 离线视频源的帧释放节奏
+enum class Pacing {
+  REAL_TIME,  ///< 按时间戳间隔释放，下游处理不及时则丢帧，与相机一致
+  MAX,        ///< 不等待、不丢帧，尽快释放，用于基准测试
+  STEP,       ///< 不等待、不丢帧，界面中每次按键释放一帧，用于逐帧调试
+};
+
+/**
+ * @brief 解析帧释放节奏名称
+ * @param [in] name 名称，"realtime"、"max" 或 "step"
+ * @param [out] pacing 帧释放节奏
+ * @return 名称是否合法
+ */
+bool ParsePacing(std::string REF_IN name, Pacing REF_OUT pacing);
+
+/**
+ * @brief 离线视频源的实时节奏控制
+ * @details 第一帧释放时记录主机时间与帧时间戳的对应关系，之后每帧在对应的主机时间释放；
+ *   下一帧的释放时间也已到达时当前帧被丢弃，与相机在下游处理过慢时只保留最新一帧的行为一致；非实时节奏下不等待也不丢帧
+ */
+class Pacer final {
+ public:
+  Pacer() = default;
+  ~Pacer() = default;
+
+  /// 实时节奏下丢弃的帧数
+  attr_reader_val(dropped_, Dropped)
+
+  /**
+   * @brief 设置节奏并重新开始计时
+   * @param pacing 帧释放节奏
+   */
+  void Reset(Pacing pacing);
+
+  /**
+   * @brief 判断当前帧是否应被丢弃，为 true 时计入丢弃帧数
+   * @param next_time_stamp 下一帧的时间戳，单位 ns
+   * @return 实时节奏下下一帧的释放时间已到时为 true
+   */
+  bool Late(uint64_t next_time_stamp);
+
+  /**
+   * @brief 实时节奏下等待到帧的释放时间，第一次调用时开始计时
+   * @param time_stamp 帧时间戳，单位 ns
+   */
+  void Wait(uint64_t time_stamp);
+
+ private:
+  /**
+   * @brief 计算帧的释放时间，时间戳早于第一帧时立即释放
+   * @param time_stamp 帧时间戳，单位 ns
+   * @return 主机时间，单位 ns
+   */
+  [[nodiscard]] uint64_t ReleaseTime(uint64_t time_stamp) const;
+
+  Pacing pacing_{Pacing::REAL_TIME};  ///< 帧释放节奏
+  bool started_{};                    ///< 是否已开始计时
+  uint64_t start_host_time_{};        ///< 第一帧释放时的主机时间，单位 ns
+  uint64_t start_time_stamp_{};       ///< 第一帧的时间戳，单位 ns
+  uint64_t dropped_{};                ///< 丢弃的帧数
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_VIDEO_SOURCE_BASE_PACING_H_
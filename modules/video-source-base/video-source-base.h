@@ -1,8 +1,10 @@
 #ifndef SRM_IC_2023_MODULES_VIDEO_SOURCE_BASE_VIDEO_SOURCE_BASE_H_
 #define SRM_IC_2023_MODULES_VIDEO_SOURCE_BASE_VIDEO_SOURCE_BASE_H_
 
+#include <chrono>
 #include "common/factory.h"
 #include "common/frame.h"
+#include "pacing.h"
 
 enable_factory(video_source, VideoSource)
 
@@ -19,6 +21,9 @@ class VideoSource {
   /// 相机外参矩阵
   attr_reader_ref(distortion_mat_, DistortionMat)
 
+  /// 帧释放节奏
+  attr_reader_val(pacing_, FramePacing)
+
   /**
    * @brief 初始化视频源
    * @param [in] config_file 配置文件路径
@@ -46,9 +51,31 @@ class VideoSource {
    */
   virtual void UnregisterFrameCallback(FrameCallback callback) = 0;
 
+  /**
+   * @brief 设置帧释放节奏，覆盖配置文件中的设置
+   * @param pacing 帧释放节奏
+   * @return 是否支持该节奏，相机只支持实时节奏
+   */
+  virtual bool SetPacing(Pacing pacing) { return pacing == Pacing::REAL_TIME; }
+
+  /**
+   * @brief 跳转到指定帧，下一次 GetFrame() 返回该帧
+   * @param frame_index 帧序号，从 0 开始
+   * @return 是否跳转成功，相机不支持跳转
+   */
+  virtual bool Seek(size_t frame_index) { return false; }
+
+  /**
+   * @brief 跳转到指定时刻，下一次 GetFrame() 返回该时刻显示的帧
+   * @param time 相对第一帧的时间
+   * @return 是否跳转成功，相机不支持跳转
+   */
+  virtual bool Seek(std::chrono::nanoseconds time) { return false; }
+
  protected:
-  cv::Mat intrinsic_mat_;   ///< 相机内参矩阵
-  cv::Mat distortion_mat_;  ///< 相机外参矩阵
+  cv::Mat intrinsic_mat_;             ///< 相机内参矩阵
+  cv::Mat distortion_mat_;            ///< 相机外参矩阵
+  Pacing pacing_{Pacing::REAL_TIME};  ///< 帧释放节奏
 };
 }
 
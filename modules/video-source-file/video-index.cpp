@@ -0,0 +1,110 @@
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <glog/logging.h>
+#include <opencv2/videoio.hpp>
+#include "video-index.h"
+
+namespace {
+constexpr uint64_t kMagic = 0x315844494D5253;  ///< 索引缓存魔数，小端序为 "SRMIDX1"
+
+/// 索引缓存文件头，其后依次为各帧显示时间与关键帧序号
+struct CacheHeader {
+  uint64_t magic;       ///< 魔数 kMagic
+  uint64_t video_size;  ///< 视频文件字节数
+  int64_t video_mtime;  ///< 视频文件修改时间，单位 ns
+  uint64_t frames;      ///< 帧数
+  uint64_t key_frames;  ///< 关键帧数
+};
+}
+
+bool video_source::file::VideoIndex::Load(std::string REF_IN video_file, std::string REF_IN cache_file) {
+  struct stat video_stat{};
+  if (stat(video_file.c_str(), &video_stat) == -1) {
+    LOG(ERROR) << "Failed to stat video file " << video_file << ".";
+    return false;
+  }
+  auto video_mtime = static_cast<int64_t>(video_stat.st_mtim.tv_sec) * 1000000000 + video_stat.st_mtim.tv_nsec;
+  CacheHeader header{};
+  std::ifstream cache(cache_file, std::ios::binary);
+  if (cache.read(reinterpret_cast<char *>(&header), sizeof(header)) && header.magic == kMagic
+      && header.video_size == static_cast<uint64_t>(video_stat.st_size) && header.video_mtime == video_mtime
+      && header.frames && header.key_frames && header.key_frames <= header.frames) {
+    frame_times_.resize(header.frames);
+    key_frames_.resize(header.key_frames);
+    if (cache.read(reinterpret_cast<char *>(frame_times_.data()), std::streamsize(header.frames * sizeof(uint64_t)))
+        && cache.read(reinterpret_cast<char *>(key_frames_.data()),
+                      std::streamsize(header.key_frames * sizeof(uint64_t)))
+        && key_frames_.front() == 0 && std::is_sorted(key_frames_.begin(), key_frames_.end())
+        && key_frames_.back() < header.frames) {
+      LOG(INFO) << "Loaded index of " << Frames() << " frames and " << key_frames_.size() << " key frames from "
+                << cache_file << ".";
+      return true;
+    }
+  }
+  cache.close();
+  auto start_time = std::chrono::steady_clock::now();
+  if (!Build(video_file)) {
+    frame_times_.clear();
+    key_frames_.clear();
+    return false;
+  }
+  LOG(INFO) << "Indexed " << Frames() << " frames and " << key_frames_.size() << " key frames of " << video_file
+            << " in " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count()
+            << " s.";
+  header = {kMagic, static_cast<uint64_t>(video_stat.st_size), video_mtime, frame_times_.size(), key_frames_.size()};
+  std::ofstream output(cache_file, std::ios::binary | std::ios::trunc);
+  output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  output.write(reinterpret_cast<const char *>(frame_times_.data()),
+               std::streamsize(frame_times_.size() * sizeof(uint64_t)));
+  output.write(reinterpret_cast<const char *>(key_frames_.data()),
+               std::streamsize(key_frames_.size() * sizeof(uint64_t)));
+  if (!output) LOG(WARNING) << "Failed to write video index cache " << cache_file << ".";
+  return true;
+}
+
+size_t video_source::file::VideoIndex::KeyFrame(size_t frame_index) const {
+  return *std::prev(std::upper_bound(key_frames_.begin(), key_frames_.end(), frame_index));
+}
+
+size_t video_source::file::VideoIndex::FrameAt(uint64_t time) const {
+  auto frame = std::upper_bound(frame_times_.begin(), frame_times_.end(), time);
+  return frame == frame_times_.begin() ? 0 : frame - frame_times_.begin() - 1;
+}
+
+bool video_source::file::VideoIndex::Build(std::string REF_IN video_file) {
+  frame_times_.clear();
+  key_frames_.clear();
+  // 原始数据包模式只读取数据包而不解码，扫描速度接近读盘速度
+  cv::VideoCapture video;
+  bool raw = video.open(video_file, cv::CAP_FFMPEG) && video.set(cv::CAP_PROP_FORMAT, -1);
+  if (!raw) {
+    video.release();
+    if (!video.open(video_file)) {
+      LOG(ERROR) << "Failed to open video file " << video_file << " for indexing.";
+      return false;
+    }
+    LOG(WARNING) << "Raw packet reading is not supported for " << video_file
+                 << ". Indexing by decoding, and seeking will decode from the first frame.";
+  }
+  auto frame_rate = video.get(cv::CAP_PROP_FPS);
+  double first_time = 0;
+  for (uint64_t i = 0; video.grab(); ++i) {
+    auto time = video.get(cv::CAP_PROP_POS_MSEC);
+    if (!i) first_time = time;
+    frame_times_.push_back(static_cast<uint64_t>(std::max(time - first_time, 0.) * 1e6));
+    if (!i || (raw && video.get(cv::CAP_PROP_LRF_HAS_KEY_FRAME) != 0)) key_frames_.push_back(i);
+  }
+  if (frame_times_.empty()) {
+    LOG(ERROR) << "No frames found in video file " << video_file << ".";
+    return false;
+  }
+  // 数据包按解码顺序排列，含 B 帧时显示时间并不单调，排序后即为按显示顺序的各帧时间；
+  // 容器不提供时间戳时按帧率生成
+  std::sort(frame_times_.begin(), frame_times_.end());
+  if (frame_times_.size() > 1 && !frame_times_.back() && frame_rate > 0)
+    for (size_t i = 0; i < frame_times_.size(); ++i)
+      frame_times_[i] = static_cast<uint64_t>(i * 1e9 / frame_rate);
+  return true;
+}
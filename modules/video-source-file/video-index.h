@@ -0,0 +1,58 @@
+#ifndef SRM_IC_2023_MODULES_VIDEO_SOURCE_FILE_VIDEO_INDEX_H_
+#define SRM_IC_2023_MODULES_VIDEO_SOURCE_FILE_VIDEO_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "common/syntactic-sugar.h"
+
+namespace video_source::file {
+/**
+ * @brief 视频帧索引，记录每帧的显示时间与关键帧位置
+ * @details 第一次打开视频时以不解码的原始数据包模式扫描一遍视频建立索引，并缓存到 cache 目录；
+ *   缓存中记录视频文件的大小与修改时间，视频变化后重新建立
+ */
+class VideoIndex final {
+ public:
+  VideoIndex() = default;
+  ~VideoIndex() = default;
+
+  /// 帧数
+  [[nodiscard]] size_t Frames() const { return frame_times_.size(); }
+
+  /**
+   * @brief 读取缓存的索引，缓存不存在或已过期时扫描视频建立索引并写入缓存
+   * @param [in] video_file 视频文件路径
+   * @param [in] cache_file 索引缓存文件路径
+   * @return 是否得到索引
+   */
+  bool Load(std::string REF_IN video_file, std::string REF_IN cache_file);
+
+  /**
+   * @brief 查找不晚于指定帧的最近关键帧
+   * @param frame_index 帧序号
+   * @return 关键帧序号，从该帧开始解码可以得到指定帧
+   */
+  [[nodiscard]] size_t KeyFrame(size_t frame_index) const;
+
+  /**
+   * @brief 查找指定时刻显示的帧
+   * @param time 相对第一帧的时间，单位 ns
+   * @return 显示时间不晚于该时刻的最后一帧的序号
+   */
+  [[nodiscard]] size_t FrameAt(uint64_t time) const;
+
+ private:
+  /**
+   * @brief 扫描视频建立索引
+   * @param [in] video_file 视频文件路径
+   * @return 是否扫描成功
+   */
+  bool Build(std::string REF_IN video_file);
+
+  std::vector<uint64_t> frame_times_;  ///< 各帧相对第一帧的显示时间，单位 ns
+  std::vector<uint64_t> key_frames_;   ///< 关键帧序号，升序，第一个总是 0
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_VIDEO_SOURCE_FILE_VIDEO_INDEX_H_
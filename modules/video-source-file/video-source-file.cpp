@@ -1,3 +1,7 @@
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
 #include <glog/logging.h>
 #include <opencv2/videoio.hpp>
 #include "video-source-file.h"
@@ -5,6 +9,16 @@
 video_source::Registry<video_source::file::FileVideoSource>
     video_source::file::FileVideoSource::registry_("file");
 
+video_source::file::FileVideoSource::~FileVideoSource() {
+  {
+    std::lock_guard<std::mutex> lock(queue_lock_);
+    stop_flag_ = true;
+  }
+  queue_cv_.notify_all();
+  if (decoding_thread_.joinable()) decoding_thread_.join();
+  if (pacer_.Dropped()) LOG(INFO) << pacer_.Dropped() << " late frames were dropped by real-time pacing.";
+}
+
 bool video_source::file::FileVideoSource::Initialize(std::string REF_IN config_file) {
   cv::FileStorage video_init_config;
   video_init_config.open(config_file, cv::FileStorage::READ);
@@ -46,37 +60,147 @@ bool video_source::file::FileVideoSource::Initialize(std::string REF_IN config_f
     distortion_mat_.release();
     return false;
   }
-  std::string video_file;
-  video_init_config["VIDEO"] >> video_file;
-  if (video_file.empty()) {
-    LOG(ERROR) << "Video configuration not found.";
+  std::string pacing;
+  video_init_config["PACING"] >> pacing;
+  if (!ParsePacing(pacing, pacing_)) {
+    LOG(ERROR) << "Invalid pacing mode " << pacing << ". Use \"realtime\", \"max\" or \"step\".";
     intrinsic_mat_.release();
     distortion_mat_.release();
     return false;
   }
-  video_.open(video_file);
-  if (!video_.isOpened()) {
-    LOG(ERROR) << "Failed to open video file " << video_file << ".";
+  pacer_.Reset(pacing_);
+  video_init_config["PREFETCH_DEPTH"] >> prefetch_depth_;
+  if (prefetch_depth_ <= 0) {
+    LOG(ERROR) << "Invalid prefetch depth " << prefetch_depth_ << ".";
     intrinsic_mat_.release();
     distortion_mat_.release();
     return false;
   }
-  frame_rate_ = video_.get(cv::CAP_PROP_FPS);
-  LOG(INFO) << "Initialized file video source.";
+  auto video_node = video_init_config["VIDEO"];
+  videos_.clear();
+  if (video_node.isSeq()) video_node >> videos_;
+  else {
+    std::string video_file;
+    video_node >> video_file;
+    if (!video_file.empty()) videos_.push_back(video_file);
+  }
+  if (videos_.empty()) {
+    LOG(ERROR) << "Video configuration not found.";
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  int loop = 0;
+  video_init_config["LOOP"] >> loop;
+  loop_ = loop;
+  // 启动前检查播放列表中的每个视频都可以打开，并记录各自的帧率
+  frame_periods_.clear();
+  for (auto &&video_file : videos_) {
+    if (!video_.open(video_file)) {
+      LOG(ERROR) << "Failed to open video file " << video_file << ".";
+      videos_.clear();
+      intrinsic_mat_.release();
+      distortion_mat_.release();
+      return false;
+    }
+    // 部分容器不记录帧率，后端返回 0 时无法生成时间戳
+    auto frame_rate = video_.get(cv::CAP_PROP_FPS);
+    if (!(frame_rate > 0) || !std::isfinite(frame_rate)) {
+      LOG(ERROR) << "Invalid frame rate " << frame_rate << " of video file " << video_file << ".";
+      videos_.clear();
+      frame_periods_.clear();
+      intrinsic_mat_.release();
+      distortion_mat_.release();
+      return false;
+    }
+    frame_periods_.push_back(uint64_t(1e9 / frame_rate));
+  }
+  current_video_ = 0;
+  if (videos_.size() > 1) video_.open(videos_.front());
+  // 索引只用于跳转，建立失败时仍可顺序播放
+  if (videos_.size() == 1) {
+    // 缓存文件名附加完整路径的哈希，不同目录下的同名视频不共用索引
+    std::error_code error;
+    auto video_path = std::filesystem::weakly_canonical(videos_.front(), error);
+    if (error) video_path = std::filesystem::absolute(videos_.front(), error);
+    std::ostringstream cache_file;
+    cache_file << "../cache/" << video_path.filename().string() << "-" << std::hex << std::setw(16)
+               << std::setfill('0') << std::hash<std::string>{}(video_path.string()) << ".index";
+    if (!index_.Load(videos_.front(), cache_file.str()))
+      LOG(WARNING) << "Seeking is unavailable without an index of video file " << videos_.front() << ".";
+  }
+  // 队列中的帧、下游持有的一帧与正在解码的一帧各占一个缓冲区
+  buffers_.resize(prefetch_depth_ + 2);
+  decoding_thread_ = std::thread(&FileVideoSource::DecodingThreadFunction, this);
+  LOG(INFO) << "Initialized file video source with " << videos_.size() << (loop_ ? " looped" : "")
+            << " videos, prefetch depth " << prefetch_depth_ << " at " << pacing << " pacing.";
   return true;
 }
 
 bool video_source::file::FileVideoSource::GetFrame(Frame REF_OUT frame) {
   cv::Mat image;
-  if (video_.read(image)) {
-    frame.image = std::move(image);
-    time_stamp_ += uint64_t(1e9 / frame_rate_);
-    frame.time_stamp = time_stamp_;
-    for (auto p : callback_list_)
-      (*p.first)(p.second, frame);
-    return true;
-  } else
+  uint64_t frame_period;
+  if (!PopFrame(image, frame_period)) return false;
+  time_stamp_ += frame_period;
+  // 下游处理不及时时丢弃已过期的帧，只释放最新的一帧
+  while (pacer_.Late(time_stamp_ + frame_period)) {
+    if (!PopFrame(image, frame_period)) return false;
+    time_stamp_ += frame_period;
+  }
+  pacer_.Wait(time_stamp_);
+  // 整体重新赋值，清空上一帧的金字塔缓存，并释放上一帧对缓冲区的引用
+  frame = Frame();
+  frame.image = std::move(image);
+  frame.time_stamp = time_stamp_;
+  frame.receive_time = Frame::HostTime();
+  for (auto p : callback_list_)
+    (*p.first)(p.second, frame);
+  return true;
+}
+
+bool video_source::file::FileVideoSource::SetPacing(Pacing pacing) {
+  pacing_ = pacing;
+  pacer_.Reset(pacing);
+  return true;
+}
+
+bool video_source::file::FileVideoSource::Seek(size_t frame_index) {
+  if (!index_.Frames()) {
+    LOG(ERROR) << "Seeking requires a single indexed video.";
+    return false;
+  }
+  if (frame_index >= index_.Frames()) {
+    LOG(ERROR) << "Failed to seek to frame " << frame_index << " of " << index_.Frames() << " indexed frames.";
     return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue_lock_);
+    seek_frame_ = static_cast<int64_t>(frame_index);
+    ready_.clear();
+    end_of_file_ = false;
+  }
+  queue_cv_.notify_all();
+  // 第 i 帧的时间戳为 (i + 1) 个帧间隔，跳转后重新开始实时节奏的计时
+  time_stamp_ = frame_index * frame_periods_.front();
+  pacer_.Reset(pacing_);
+  return true;
+}
+
+bool video_source::file::FileVideoSource::Seek(std::chrono::nanoseconds time) {
+  return Seek(index_.FrameAt(static_cast<uint64_t>(std::max(time.count(), int64_t(0)))));
+}
+
+bool video_source::file::FileVideoSource::PopFrame(cv::Mat REF_OUT image, uint64_t REF_OUT frame_period) {
+  {
+    std::unique_lock<std::mutex> lock(queue_lock_);
+    queue_cv_.wait(lock, [this] { return !ready_.empty() || end_of_file_; });
+    if (ready_.empty()) return false;
+    image = std::move(ready_.front().image);
+    frame_period = ready_.front().frame_period;
+    ready_.pop_front();
+  }
+  queue_cv_.notify_all();
+  return true;
 }
 
 void video_source::file::FileVideoSource::RegisterFrameCallback(FrameCallback callback, void *obj) {
@@ -89,3 +213,64 @@ void video_source::file::FileVideoSource::UnregisterFrameCallback(FrameCallback
   callback_list_.erase(std::remove_if(callback_list_.begin(), callback_list_.end(), filter), callback_list_.end());
   DLOG(INFO) << "Unregistered video source callback FUNC " << callback << ".";
 }
+
+void video_source::file::FileVideoSource::SeekVideo(size_t frame_index) {
+  auto key_frame = index_.KeyFrame(frame_index);
+  // 后端不支持定位时重新打开视频，从第一帧开始解码
+  if (!video_.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(key_frame))
+      || static_cast<size_t>(video_.get(cv::CAP_PROP_POS_FRAMES)) != key_frame) {
+    LOG(WARNING) << "Failed to seek to key frame " << key_frame << ". Decoding from the first frame.";
+    video_.open(videos_[current_video_]);
+    key_frame = 0;
+  }
+  for (auto i = key_frame; i < frame_index; ++i)
+    if (!video_.grab()) break;
+}
+
+bool video_source::file::FileVideoSource::OpenNextVideo() {
+  if (current_video_ + 1 == videos_.size() && !loop_) return false;
+  current_video_ = (current_video_ + 1) % videos_.size();
+  if (!video_.open(videos_[current_video_])) {
+    LOG(ERROR) << "Failed to open video file " << videos_[current_video_] << ".";
+    return false;
+  }
+  LOG(INFO) << "Playing video file " << videos_[current_video_] << ".";
+  return true;
+}
+
+void video_source::file::FileVideoSource::DecodingThreadFunction() {
+  while (true) {
+    int64_t seek_frame;
+    {
+      std::unique_lock<std::mutex> lock(queue_lock_);
+      queue_cv_.wait(lock, [this] {
+        return stop_flag_ || seek_frame_ >= 0
+            || (!end_of_file_ && ready_.size() < static_cast<size_t>(prefetch_depth_));
+      });
+      if (stop_flag_) return;
+      seek_frame = seek_frame_;
+      seek_frame_ = -1;
+    }
+    if (seek_frame >= 0) SeekVideo(static_cast<size_t>(seek_frame));
+    // 只有缓冲区自身持有引用时才可写入；下游长期持有帧时替换一个缓冲区，被替换的图像随下游的引用释放；
+    // 下游线程释放引用时原子地修改引用计数，这里同样原子地读取
+    auto buffer = std::find_if(buffers_.begin(), buffers_.end(),
+                               [](cv::Mat REF_IN mat) { return !mat.u || CV_XADD(&mat.u->refcount, 0) == 1; });
+    if (buffer == buffers_.end()) {
+      buffer = buffers_.begin() + static_cast<std::ptrdiff_t>(replace_index_++ % buffers_.size());
+      buffer->release();
+    }
+    bool decoded = video_.read(*buffer);
+    // 当前视频结束时切换到播放列表中的下一个视频，时间戳由 GetFrame() 继续累加
+    if (!decoded && OpenNextVideo()) decoded = video_.read(*buffer);
+    {
+      // 解码期间收到新的跳转请求时丢弃这一帧；到达文件结尾后等待跳转或停止
+      std::lock_guard<std::mutex> lock(queue_lock_);
+      if (seek_frame_ < 0) {
+        if (decoded) ready_.push_back({*buffer, frame_periods_[current_video_]});
+        else end_of_file_ = true;
+      }
+    }
+    queue_cv_.notify_all();
+  }
+}
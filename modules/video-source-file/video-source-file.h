@@ -1,31 +1,86 @@
 #ifndef SRM_IC_2023_MODULES_VIDEO_SOURCE_FILE_VIDEO_SOURCE_FILE_H_
 #define SRM_IC_2023_MODULES_VIDEO_SOURCE_FILE_VIDEO_SOURCE_FILE_H_
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include "video-source-base/video-source-base.h"
+#include "video-index.h"
 
 namespace video_source::file {
 /**
  * @brief 文件读取视频源接口类
+ * @details 解码线程提前解码至多 PREFETCH_DEPTH 帧放入队列，GetFrame() 只取出已解码的帧；
+ *   解码结果写入循环使用的图像缓冲区，缓冲区在下游释放对它的全部引用后才会被再次写入；
+ *   时间戳按视频帧率生成，帧按 PACING 设置的节奏释放；
+ *   跳转时清空队列，由解码线程从目标帧之前最近的关键帧开始解码到目标帧，关键帧位置来自缓存在 cache 目录的索引；
+ *   VIDEO 为列表时依次播放各视频，LOOP 开启时循环播放，时间戳跨视频连续递增；跳转只支持单个视频
  * @warning 禁止直接构造此类，请使用 @code video_source::CreateVideoSource("file") @endcode 获取该类的公共接口指针
  */
 class FileVideoSource final : public VideoSource {
  public:
   FileVideoSource() = default;
-  ~FileVideoSource() final = default;
+  ~FileVideoSource() final;
 
   bool Initialize(std::string REF_IN config_file) final;
   bool GetFrame(Frame REF_OUT frame) final;
   void RegisterFrameCallback(FrameCallback callback, void *obj) final;
   void UnregisterFrameCallback(FrameCallback callback) final;
+  bool SetPacing(Pacing pacing) final;
+  bool Seek(size_t frame_index) final;
+  bool Seek(std::chrono::nanoseconds time) final;
 
  private:
   static Registry<FileVideoSource> registry_;  ///< 相机公共接口指针
 
+  /**
+   * @brief 从已解码队列取出一帧，队列为空时等待解码
+   * @param [out] image 图像
+   * @return 是否取出成功，解码到文件结尾时为 false
+   */
+  bool PopFrame(cv::Mat REF_OUT image, uint64_t REF_OUT frame_period);
+
+  /**
+   * @brief 在解码线程中打开播放列表中的下一个视频
+   * @return 是否打开成功，播放列表结束且不循环时为 false
+   */
+  bool OpenNextVideo();
+
+  /**
+   * @brief 在解码线程中定位视频，下一次读取得到目标帧
+   * @param frame_index 目标帧序号
+   */
+  void SeekVideo(size_t frame_index);
+
+  void DecodingThreadFunction();
+
+  /// 已解码的帧
+  struct DecodedFrame {
+    cv::Mat image;          ///< 图像
+    uint64_t frame_period;  ///< 所属视频的帧间隔，单位 ns
+  };
+
   /// 注册回调函数列表
   std::vector<std::pair<FrameCallback, void *>> callback_list_;
-  double frame_rate_{};     ///< 帧率
-  cv::VideoCapture video_;  ///< 视频读取接口
-  uint64_t time_stamp_{};   ///< 时间戳
+  std::vector<std::string> videos_;      ///< 播放列表
+  std::vector<uint64_t> frame_periods_;  ///< 播放列表中各视频的帧间隔，单位 ns
+  bool loop_{};                          ///< 是否循环播放
+  size_t current_video_{};               ///< 正在解码的视频在播放列表中的序号，只在解码线程中访问
+  cv::VideoCapture video_;               ///< 视频读取接口，只在解码线程中访问
+  VideoIndex index_;                     ///< 视频帧索引，帧数为 0 时不支持跳转
+  uint64_t time_stamp_{};                ///< 时间戳
+  Pacer pacer_;                          ///< 帧释放节奏控制
+  int prefetch_depth_{};                 ///< 预解码队列深度
+  std::vector<cv::Mat> buffers_;         ///< 循环使用的图像缓冲区，只在解码线程中访问
+  size_t replace_index_{};               ///< 没有空闲缓冲区时下一个被替换的缓冲区
+  std::deque<DecodedFrame> ready_;       ///< 已解码的帧
+  bool end_of_file_{};                   ///< 是否已解码到文件结尾，受 queue_lock_ 保护
+  int64_t seek_frame_{-1};               ///< 待解码线程执行的跳转目标帧，-1 表示没有，受 queue_lock_ 保护
+  bool stop_flag_{};                     ///< 解码线程停止信号，受 queue_lock_ 保护
+  std::mutex queue_lock_;                ///< 已解码队列锁
+  std::condition_variable queue_cv_;     ///< 队列有新帧、有空位或停止的通知
+  std::thread decoding_thread_;          ///< 解码线程
 };
 }
 
@@ -0,0 +1,198 @@
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <glog/logging.h>
+#include "raw-recording/lz4.h"
+#include "video-source-replay.h"
+
+video_source::Registry<video_source::replay::ReplayVideoSource>
+    video_source::replay::ReplayVideoSource::registry_("replay");
+
+namespace {
+constexpr size_t kBuffers = 3;  ///< 循环使用的图像缓冲区数量，下游持有一两帧时仍有空闲的缓冲区
+}
+
+video_source::replay::ReplayVideoSource::~ReplayVideoSource() {
+  if (data_) munmap(data_, size_);
+  if (pacer_.Dropped()) LOG(INFO) << pacer_.Dropped() << " late frames were dropped by real-time pacing.";
+}
+
+bool video_source::replay::ReplayVideoSource::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage video_init_config;
+  video_init_config.open(config_file, cv::FileStorage::READ);
+  if (!video_init_config.isOpened()) {
+    LOG(ERROR) << "Failed to open camera initialization file " << config_file << ".";
+    return false;
+  }
+  std::string all_cams_config_file;
+  video_init_config["ALL_CAMS_CONFIG_FILE"] >> all_cams_config_file;
+  if (all_cams_config_file.empty()) {
+    LOG(ERROR) << "All cameras' config file configuration not found.";
+    return false;
+  }
+  cv::FileStorage all_cams_config;
+  all_cams_config.open(all_cams_config_file, cv::FileStorage::READ);
+  if (!all_cams_config.isOpened()) {
+    LOG(ERROR) << "Failed to open all cameras' config file " << all_cams_config_file << ".";
+    return false;
+  }
+  std::string all_lens_config_file;
+  video_init_config["ALL_LENS_CONFIG_FILE"] >> all_lens_config_file;
+  if (all_lens_config_file.empty()) {
+    LOG(ERROR) << "All lens' config file configuration not found.";
+    return false;
+  }
+  cv::FileStorage all_lens_config;
+  all_lens_config.open(all_lens_config_file, cv::FileStorage::READ);
+  if (!all_lens_config.isOpened()) {
+    LOG(ERROR) << "Failed to open all lens' config file " << all_lens_config_file << ".";
+    return false;
+  }
+  std::string len_type;
+  all_cams_config[video_init_config["CAMERA"]]["LEN"] >> len_type;
+  all_lens_config[len_type]["IntrinsicMatrix"] >> intrinsic_mat_;
+  all_lens_config[len_type]["DistortionMatrix"] >> distortion_mat_;
+  if (intrinsic_mat_.empty() || distortion_mat_.empty()) {
+    LOG(ERROR) << "Camera len configurations not found.";
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  std::string pacing;
+  video_init_config["PACING"] >> pacing;
+  if (!ParsePacing(pacing, pacing_)) {
+    LOG(ERROR) << "Invalid pacing mode " << pacing << ". Use \"realtime\", \"max\" or \"step\".";
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  pacer_.Reset(pacing_);
+  std::string recording_file;
+  video_init_config["RECORDING"] >> recording_file;
+  int fd = recording_file.empty() ? -1 : open(recording_file.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat file_stat{};
+  if (fd == -1 || fstat(fd, &file_stat) == -1) {
+    LOG(ERROR) << "Failed to open recording file " << recording_file << ".";
+    if (fd != -1) close(fd);
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  // 只读映射，下游可能修改的帧复制到缓冲区，不会因写入复制页面而增加内存占用；映射建立后即可关闭文件
+  size_ = file_stat.st_size;
+  auto address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    LOG(ERROR) << "Failed to map recording file " << recording_file << ".";
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  data_ = static_cast<uint8_t *>(address);
+  madvise(data_, size_, MADV_SEQUENTIAL);
+  if (!raw_recording::ReadIndex(data_, size_, index_) || index_.empty()) {
+    LOG(ERROR) << "No frames found in recording file " << recording_file << ".";
+    munmap(data_, size_);
+    data_ = nullptr;
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  next_frame_ = 0;
+  buffers_.assign(kBuffers, cv::Mat());
+  LOG(INFO) << "Initialized replay video source with " << index_.size() << " frames at " << pacing << " pacing.";
+  return true;
+}
+
+bool video_source::replay::ReplayVideoSource::GetFrame(Frame REF_OUT frame) {
+  if (next_frame_ >= index_.size()) return false;
+  // 下游处理不及时时跳过已过期的帧，被跳过的帧不解码
+  while (next_frame_ + 1 < index_.size() && pacer_.Late(index_[next_frame_ + 1].time_stamp)) ++next_frame_;
+  auto offset = index_[next_frame_].offset;
+  auto header = reinterpret_cast<const raw_recording::ChunkHeader *>(data_ + offset);
+  auto payload = data_ + offset + raw_recording::kChunkHeaderSize;
+  cv::Mat image;
+  // 未压缩的 Bayer 帧只被读取，直接引用映射的文件；彩色帧会被界面绘制修改，与解压的帧一样写入循环使用的缓冲区
+  if (header->codec == raw_recording::Codec::NONE && header->bayer_pattern >= 0)
+    image = cv::Mat(header->rows, header->cols, header->type, payload);
+  else {
+    auto &&buffer = Buffer();
+    buffer.create(header->rows, header->cols, header->type);
+    image = buffer;
+    if (header->codec == raw_recording::Codec::NONE) memcpy(image.data, payload, header->raw_size);
+    else if (!raw_recording::lz4::Decompress(payload, header->data_size, image.data, header->raw_size)) {
+      LOG(ERROR) << "Failed to decompress frame " << next_frame_ << " of recording.";
+      return false;
+    }
+  }
+  pacer_.Wait(header->time_stamp);
+  // 预读下一帧所在的页面，避免访问时同步读盘
+  if (++next_frame_ < index_.size()) {
+    auto page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    auto begin = index_[next_frame_].offset / page_size * page_size;
+    auto end = next_frame_ + 1 < index_.size() ? index_[next_frame_ + 1].offset : size_;
+    madvise(data_ + begin, end - begin, MADV_WILLNEED);
+  }
+  // 整体重新赋值，清空上一帧的金字塔缓存
+  frame = Frame();
+  if (header->bayer_pattern >= 0) {
+    frame.bayer = image;
+    frame.bayer_pattern = static_cast<simd::BayerPattern>(header->bayer_pattern);
+  } else
+    frame.image = image;
+  frame.receive_packet = header->receive_packet;
+  frame.time_stamp = header->time_stamp;
+  frame.receive_time = Frame::HostTime();
+  for (auto p : callback_list_)
+    (*p.first)(p.second, frame);
+  return true;
+}
+
+bool video_source::replay::ReplayVideoSource::SetPacing(Pacing pacing) {
+  pacing_ = pacing;
+  pacer_.Reset(pacing);
+  return true;
+}
+
+bool video_source::replay::ReplayVideoSource::Seek(size_t frame_index) {
+  if (frame_index >= index_.size()) {
+    LOG(ERROR) << "Failed to seek to frame " << frame_index << " of " << index_.size() << " recorded frames.";
+    return false;
+  }
+  next_frame_ = frame_index;
+  pacer_.Reset(pacing_);
+  return true;
+}
+
+bool video_source::replay::ReplayVideoSource::Seek(std::chrono::nanoseconds time) {
+  if (index_.empty()) return false;
+  auto time_stamp = index_.front().time_stamp + static_cast<uint64_t>(std::max(time.count(), int64_t(0)));
+  auto compare = [](uint64_t t, raw_recording::IndexEntry REF_IN entry) { return t < entry.time_stamp; };
+  auto frame = std::upper_bound(index_.begin(), index_.end(), time_stamp, compare);
+  return Seek(frame == index_.begin() ? 0 : frame - index_.begin() - 1);
+}
+
+cv::Mat &video_source::replay::ReplayVideoSource::Buffer() {
+  // 只有缓冲区自身持有引用时才可写入；下游长期持有帧时替换一个缓冲区，被替换的图像随下游的引用释放；
+  // 录像写入线程释放引用时原子地修改引用计数，这里同样原子地读取
+  auto buffer = std::find_if(buffers_.begin(), buffers_.end(),
+                             [](cv::Mat REF_IN mat) { return !mat.u || CV_XADD(&mat.u->refcount, 0) == 1; });
+  if (buffer == buffers_.end()) {
+    buffer = buffers_.begin() + static_cast<std::ptrdiff_t>(replace_index_++ % buffers_.size());
+    buffer->release();
+  }
+  return *buffer;
+}
+
+void video_source::replay::ReplayVideoSource::RegisterFrameCallback(FrameCallback callback, void *obj) {
+  callback_list_.emplace_back(callback, obj);
+  DLOG(INFO) << "Registered video source callback FUNC " << callback << " OBJ " << obj << ".";
+}
+
+void video_source::replay::ReplayVideoSource::UnregisterFrameCallback(FrameCallback callback) {
+  auto filter = [callback](auto p) { return p.first == callback; };
+  callback_list_.erase(std::remove_if(callback_list_.begin(), callback_list_.end(), filter), callback_list_.end());
+  DLOG(INFO) << "Unregistered video source callback FUNC " << callback << ".";
+}
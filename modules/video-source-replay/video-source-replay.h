@@ -0,0 +1,49 @@
+#ifndef SRM_IC_2023_MODULES_VIDEO_SOURCE_REPLAY_VIDEO_SOURCE_REPLAY_H_
+#define SRM_IC_2023_MODULES_VIDEO_SOURCE_REPLAY_VIDEO_SOURCE_REPLAY_H_
+
+#include "raw-recording/raw-recording.h"
+#include "video-source-base/video-source-base.h"
+
+namespace video_source::replay {
+/**
+ * @brief 原始录像回放视频源接口类
+ * @details 录像文件以只读方式整体映射，未压缩的 Bayer 帧直接在映射上构造 cv::Mat，不复制图像数据；
+ *   彩色帧会被下游绘制修改，与压缩的帧一样解码到循环使用的缓冲区，内存占用不随回放时长增长；帧的时间戳与串口信息按录制时的原值恢复；
+ *   帧按 PACING 设置的节奏释放，实时节奏以录制时的时间戳为准；每帧均可独立解码，跳转直接使用帧索引
+ * @warning 禁止直接构造此类，请使用 @code video_source::CreateVideoSource("replay") @endcode 获取该类的公共接口指针
+ */
+class ReplayVideoSource final : public VideoSource {
+ public:
+  ReplayVideoSource() = default;
+  ~ReplayVideoSource() final;
+
+  bool Initialize(std::string REF_IN config_file) final;
+  bool GetFrame(Frame REF_OUT frame) final;
+  void RegisterFrameCallback(FrameCallback callback, void *obj) final;
+  void UnregisterFrameCallback(FrameCallback callback) final;
+  bool SetPacing(Pacing pacing) final;
+  bool Seek(size_t frame_index) final;
+  bool Seek(std::chrono::nanoseconds time) final;
+
+ private:
+  static Registry<ReplayVideoSource> registry_;  ///< 相机公共接口指针
+
+  /**
+   * @brief 取得一个可写入的图像缓冲区
+   * @return 没有被下游引用的缓冲区
+   */
+  cv::Mat &Buffer();
+
+  /// 注册回调函数列表
+  std::vector<std::pair<FrameCallback, void *>> callback_list_;
+  uint8_t *data_{};                               ///< 录像文件只读映射首地址
+  size_t size_{};                                 ///< 录像文件字节数
+  std::vector<raw_recording::IndexEntry> index_;  ///< 帧索引
+  size_t next_frame_{};                           ///< 下一帧的序号
+  std::vector<cv::Mat> buffers_;                  ///< 循环使用的图像缓冲区，存放解压的帧与复制的彩色帧
+  size_t replace_index_{};                        ///< 没有空闲缓冲区时下一个被替换的缓冲区
+  Pacer pacer_;                                   ///< 帧释放节奏控制
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_VIDEO_SOURCE_REPLAY_VIDEO_SOURCE_REPLAY_H_
@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <glog/logging.h>
+#include <opencv2/imgcodecs.hpp>
+#include "video-source-sequence.h"
+
+video_source::Registry<video_source::sequence::SequenceVideoSource>
+    video_source::sequence::SequenceVideoSource::registry_("sequence");
+
+namespace {
+/**
+ * @brief 去除字符串首尾的空白字符
+ * @param [in] str 字符串
+ * @return 去除空白后的字符串
+ */
+std::string Trim(std::string REF_IN str) {
+  auto begin = str.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) return {};
+  return str.substr(begin, str.find_last_not_of(" \t\r") + 1 - begin);
+}
+
+/**
+ * @brief 按逗号拆分 CSV 的一行
+ * @param [in] line 一行文本
+ * @return 去除首尾空白后的各字段
+ */
+std::vector<std::string> SplitFields(std::string REF_IN line) {
+  std::vector<std::string> fields;
+  std::stringstream row(line);
+  for (std::string field; std::getline(row, field, ',');)
+    fields.push_back(Trim(field));
+  return fields;
+}
+
+/**
+ * @brief 解析数值字段，字段不存在时保持原值
+ * @tparam T 数值类型
+ * @param [in] record 字段名到字段内容的映射
+ * @param [in] name 字段名
+ * @param [out] value 解析结果
+ * @return 字段不存在或解析成功时为 true
+ */
+template<class T>
+bool ParseField(std::map<std::string, std::string> REF_IN record, std::string REF_IN name, T REF_OUT value) {
+  auto field = record.find(name);
+  if (field == record.end()) return true;
+  auto begin = field->second.data(), end = begin + field->second.size();
+  auto [ptr, error] = std::from_chars(begin, end, value);
+  return error == std::errc() && ptr == end;
+}
+}
+
+video_source::sequence::SequenceVideoSource::~SequenceVideoSource() {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    stop_flag_ = true;
+  }
+  space_cv_.notify_all();
+  for (auto &&thread : decoding_threads_)
+    if (thread.joinable()) thread.join();
+  if (pacer_.Dropped()) LOG(INFO) << pacer_.Dropped() << " late frames were dropped by real-time pacing.";
+}
+
+bool video_source::sequence::SequenceVideoSource::Initialize(std::string REF_IN config_file) {
+  cv::FileStorage video_init_config;
+  video_init_config.open(config_file, cv::FileStorage::READ);
+  if (!video_init_config.isOpened()) {
+    LOG(ERROR) << "Failed to open camera initialization file " << config_file << ".";
+    return false;
+  }
+  std::string all_cams_config_file;
+  video_init_config["ALL_CAMS_CONFIG_FILE"] >> all_cams_config_file;
+  if (all_cams_config_file.empty()) {
+    LOG(ERROR) << "All cameras' config file configuration not found.";
+    return false;
+  }
+  cv::FileStorage all_cams_config;
+  all_cams_config.open(all_cams_config_file, cv::FileStorage::READ);
+  if (!all_cams_config.isOpened()) {
+    LOG(ERROR) << "Failed to open all cameras' config file " << all_cams_config_file << ".";
+    return false;
+  }
+  std::string all_lens_config_file;
+  video_init_config["ALL_LENS_CONFIG_FILE"] >> all_lens_config_file;
+  if (all_lens_config_file.empty()) {
+    LOG(ERROR) << "All lens' config file configuration not found.";
+    return false;
+  }
+  cv::FileStorage all_lens_config;
+  all_lens_config.open(all_lens_config_file, cv::FileStorage::READ);
+  if (!all_lens_config.isOpened()) {
+    LOG(ERROR) << "Failed to open all lens' config file " << all_lens_config_file << ".";
+    return false;
+  }
+  std::string len_type;
+  all_cams_config[video_init_config["CAMERA"]]["LEN"] >> len_type;
+  all_lens_config[len_type]["IntrinsicMatrix"] >> intrinsic_mat_;
+  all_lens_config[len_type]["DistortionMatrix"] >> distortion_mat_;
+  if (intrinsic_mat_.empty() || distortion_mat_.empty()) {
+    LOG(ERROR) << "Camera len configurations not found.";
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  std::string pacing, images, metadata_file;
+  double frame_rate;
+  int threads, reorder_depth;
+  video_init_config["PACING"] >> pacing;
+  video_init_config["IMAGES"] >> images;
+  video_init_config["METADATA"] >> metadata_file;
+  video_init_config["FRAME_RATE"] >> frame_rate;
+  video_init_config["THREADS"] >> threads;
+  video_init_config["REORDER_DEPTH"] >> reorder_depth;
+  if (!ParsePacing(pacing, pacing_)) {
+    LOG(ERROR) << "Invalid pacing mode " << pacing << ". Use \"realtime\", \"max\" or \"step\".";
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  if (frame_rate <= 0 || threads < 0 || reorder_depth <= 0) {
+    LOG(ERROR) << "Invalid frame rate, thread count or reorder depth configuration.";
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  if (!ListImages(images)) {
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  // 没有附属信息的图片按固定帧率生成时间戳
+  auto frame_period = static_cast<uint64_t>(1e9 / frame_rate);
+  for (size_t i = 0; i < images_.size(); ++i)
+    images_[i].time_stamp = (i + 1) * frame_period;
+  // 未指定附属信息文件时使用图片目录下的 metadata.csv
+  std::filesystem::path images_path(images);
+  if (metadata_file.empty()) {
+    auto default_file = (std::filesystem::is_directory(images_path) ? images_path : images_path.parent_path())
+                        / "metadata.csv";
+    if (std::filesystem::exists(default_file)) metadata_file = default_file.string();
+  }
+  if (!metadata_file.empty() && !LoadMetadata(metadata_file)) {
+    images_.clear();
+    intrinsic_mat_.release();
+    distortion_mat_.release();
+    return false;
+  }
+  pacer_.Reset(pacing_);
+  slots_.assign(reorder_depth, {});
+  next_frame_ = next_task_ = 0;
+  stop_flag_ = false;
+  if (!threads) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  for (int i = 0; i < threads; ++i)
+    decoding_threads_.emplace_back(&SequenceVideoSource::DecodingThreadFunction, this);
+  LOG(INFO) << "Initialized sequence video source with " << images_.size() << " images, " << threads
+            << " decoding threads and " << pacing << " pacing.";
+  return true;
+}
+
+bool video_source::sequence::SequenceVideoSource::GetFrame(Frame REF_OUT frame) {
+  cv::Mat image;
+  size_t index;
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+      if (next_frame_ >= images_.size()) return false;
+      auto &&slot = slots_[next_frame_ % slots_.size()];
+      ready_cv_.wait(lock, [&] { return slot.ready && slot.index == next_frame_; });
+      index = next_frame_++;
+      image = std::move(slot.image);
+      slot.ready = false;
+      space_cv_.notify_one();
+      // 下游处理不及时时丢弃已过期的帧，解码失败的图片直接跳过
+      if (image.empty()) {
+        LOG(WARNING) << "Failed to decode image " << images_[index].file << ".";
+        continue;
+      }
+      if (next_frame_ < images_.size() && pacer_.Late(images_[next_frame_].time_stamp)) continue;
+      break;
+    }
+  }
+  pacer_.Wait(images_[index].time_stamp);
+  // 整体重新赋值，清空上一帧的金字塔缓存
+  frame = Frame();
+  frame.image = image;
+  frame.receive_packet = images_[index].receive_packet;
+  frame.time_stamp = images_[index].time_stamp;
+  frame.receive_time = Frame::HostTime();
+  for (auto p : callback_list_)
+    (*p.first)(p.second, frame);
+  return true;
+}
+
+bool video_source::sequence::SequenceVideoSource::SetPacing(Pacing pacing) {
+  pacing_ = pacing;
+  pacer_.Reset(pacing);
+  return true;
+}
+
+void video_source::sequence::SequenceVideoSource::RegisterFrameCallback(FrameCallback callback, void *obj) {
+  callback_list_.emplace_back(callback, obj);
+  DLOG(INFO) << "Registered video source callback FUNC " << callback << " OBJ " << obj << ".";
+}
+
+void video_source::sequence::SequenceVideoSource::UnregisterFrameCallback(FrameCallback callback) {
+  auto filter = [callback](auto p) { return p.first == callback; };
+  callback_list_.erase(std::remove_if(callback_list_.begin(), callback_list_.end(), filter), callback_list_.end());
+  DLOG(INFO) << "Unregistered video source callback FUNC " << callback << ".";
+}
+
+bool video_source::sequence::SequenceVideoSource::ListImages(std::string REF_IN images) {
+  images_.clear();
+  std::filesystem::path images_path(images);
+  std::error_code error;
+  if (std::filesystem::is_directory(images_path, error)) {
+    // 目录中的图片按文件名排序
+    std::vector<std::string> files;
+    for (auto &&entry : std::filesystem::directory_iterator(images_path, error)) {
+      if (!entry.is_regular_file()) continue;
+      auto extension = entry.path().extension().string();
+      std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+      if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp")
+        files.push_back(entry.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    for (auto &&file : files)
+      images_.push_back({file, 0, {}});
+  } else {
+    // 列表文件中的相对路径相对于列表文件所在目录
+    std::ifstream list(images);
+    if (!list) {
+      LOG(ERROR) << "Failed to open image directory or list file " << images << ".";
+      return false;
+    }
+    for (std::string line; std::getline(list, line);) {
+      line = Trim(line);
+      if (line.empty() || line[0] == '#') continue;
+      std::filesystem::path file(line);
+      images_.push_back({(file.is_absolute() ? file : images_path.parent_path() / file).string(), 0, {}});
+    }
+  }
+  if (images_.empty()) {
+    LOG(ERROR) << "No images found in " << images << ".";
+    return false;
+  }
+  return true;
+}
+
+bool video_source::sequence::SequenceVideoSource::LoadMetadata(std::string REF_IN metadata_file) {
+  std::ifstream metadata(metadata_file);
+  std::string line;
+  if (!metadata || !std::getline(metadata, line)) {
+    LOG(ERROR) << "Failed to read metadata file " << metadata_file << ".";
+    return false;
+  }
+  // 按表头确定各列含义，未知的列忽略
+  auto columns = SplitFields(line);
+  if (std::find(columns.begin(), columns.end(), "file") == columns.end()) {
+    LOG(ERROR) << "Metadata file " << metadata_file << " has no file column.";
+    return false;
+  }
+  bool has_time_stamp = std::find(columns.begin(), columns.end(), "time_stamp") != columns.end();
+  std::map<std::string, size_t> image_indices;
+  for (size_t i = 0; i < images_.size(); ++i)
+    image_indices[std::filesystem::path(images_[i].file).filename().string()] = i;
+  std::vector<bool> has_metadata(images_.size());
+  for (size_t line_number = 2; std::getline(metadata, line); ++line_number) {
+    if (Trim(line).empty()) continue;
+    auto fields = SplitFields(line);
+    if (fields.size() != columns.size()) {
+      LOG(ERROR) << "Metadata file " << metadata_file << " line " << line_number << " has " << fields.size()
+                 << " fields, expected " << columns.size() << ".";
+      return false;
+    }
+    std::map<std::string, std::string> record;
+    for (size_t i = 0; i < columns.size(); ++i)
+      record[columns[i]] = fields[i];
+    auto image = image_indices.find(std::filesystem::path(record["file"]).filename().string());
+    if (image == image_indices.end()) continue;
+    auto &&time_stamp = images_[image->second].time_stamp;
+    auto &&packet = images_[image->second].receive_packet;
+    if (!ParseField(record, "time_stamp", time_stamp) || !ParseField(record, "mode", packet.mode)
+        || !ParseField(record, "armor_kind", packet.armor_kind) || !ParseField(record, "color", packet.color)
+        || !ParseField(record, "bullet_speed", packet.bullet_speed) || !ParseField(record, "yaw", packet.yaw)
+        || !ParseField(record, "pitch", packet.pitch) || !ParseField(record, "roll", packet.roll)) {
+      LOG(ERROR) << "Invalid number in metadata file " << metadata_file << " line " << line_number << ".";
+      return false;
+    }
+    has_metadata[image->second] = true;
+  }
+  auto matched = static_cast<size_t>(std::count(has_metadata.begin(), has_metadata.end(), true));
+  // 记录的时间戳与生成的时间戳不可混用，否则节奏控制与跟踪器会看到时间倒退
+  if (has_time_stamp) {
+    for (size_t i = 0; i < images_.size(); ++i) {
+      if (!has_metadata[i]) {
+        LOG(ERROR) << "Image " << images_[i].file << " has no time stamp in " << metadata_file << ".";
+        return false;
+      }
+      if (i && images_[i].time_stamp <= images_[i - 1].time_stamp) {
+        LOG(ERROR) << "Time stamp of image " << images_[i].file << " in " << metadata_file
+                   << " is not later than that of the previous image.";
+        return false;
+      }
+    }
+  } else if (matched < images_.size()) {
+    LOG(WARNING) << images_.size() - matched << " images have no metadata in " << metadata_file << ".";
+  }
+  LOG(INFO) << "Loaded metadata of " << matched << " images from " << metadata_file << ".";
+  return true;
+}
+
+void video_source::sequence::SequenceVideoSource::DecodingThreadFunction() {
+  std::unique_lock<std::mutex> lock(lock_);
+  while (true) {
+    // 只领取重排缓冲区容纳得下的图片，领先主循环过多时等待
+    space_cv_.wait(lock, [this] {
+      return stop_flag_ || next_task_ >= images_.size() || next_task_ < next_frame_ + slots_.size();
+    });
+    if (stop_flag_ || next_task_ >= images_.size()) return;
+    auto index = next_task_++;
+    lock.unlock();
+    auto image = cv::imread(images_[index].file, cv::IMREAD_COLOR);
+    lock.lock();
+    slots_[index % slots_.size()] = {std::move(image), index, true};
+    ready_cv_.notify_all();
+  }
+}
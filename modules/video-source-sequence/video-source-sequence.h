@@ -0,0 +1,79 @@
+#ifndef SRM_IC_2023_MODULES_VIDEO_SOURCE_SEQUENCE_VIDEO_SOURCE_SEQUENCE_H_
+#define SRM_IC_2023_MODULES_VIDEO_SOURCE_SEQUENCE_VIDEO_SOURCE_SEQUENCE_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "video-source-base/video-source-base.h"
+
+namespace video_source::sequence {
+/**
+ * @brief 图片序列视频源接口类
+ * @details 从目录或列表文件读取图片，多个解码线程按序号领取图片并行解码，结果写入按序号排列的重排缓冲区，
+ *   主循环按原顺序取帧；解码线程最多领先主循环 REORDER_DEPTH 帧。存在附属信息文件时按文件名为图片附加时间戳
+ *   与串口信息，否则按 FRAME_RATE 生成时间戳
+ * @warning 禁止直接构造此类，请使用 @code video_source::CreateVideoSource("sequence") @endcode 获取该类的公共接口指针
+ */
+class SequenceVideoSource final : public VideoSource {
+ public:
+  SequenceVideoSource() = default;
+  ~SequenceVideoSource() final;
+
+  bool Initialize(std::string REF_IN config_file) final;
+  bool GetFrame(Frame REF_OUT frame) final;
+  void RegisterFrameCallback(FrameCallback callback, void *obj) final;
+  void UnregisterFrameCallback(FrameCallback callback) final;
+  bool SetPacing(Pacing pacing) final;
+
+ private:
+  /// 图片及其附属信息
+  struct Image {
+    std::string file;              ///< 图片路径
+    uint64_t time_stamp;           ///< 时间戳，单位 ns
+    ReceivePacket receive_packet;  ///< 串口接收的信息
+  };
+
+  /// 重排缓冲区中的一个位置
+  struct Slot {
+    cv::Mat image;  ///< 解码结果，解码失败时为空
+    size_t index;   ///< 图片序号
+    bool ready;     ///< 是否已解码完成
+  };
+
+  /**
+   * @brief 列出图片文件
+   * @param [in] images 图片目录，或每行一个图片路径的列表文件
+   * @return 是否成功列出至少一张图片
+   */
+  bool ListImages(std::string REF_IN images);
+
+  /**
+   * @brief 读取附属信息文件
+   * @details 文件为带表头的 CSV，file 列为图片文件名，其余可选列为 time_stamp（单位 ns）与 ReceivePacket 的同名字段；
+   *   有 time_stamp 列时每张图片都必须有记录，且按图片顺序严格递增；没有该列时使用按帧率生成的时间戳
+   * @param [in] metadata_file 附属信息文件路径
+   * @return 文件格式是否正确
+   */
+  bool LoadMetadata(std::string REF_IN metadata_file);
+
+  /// 解码线程函数
+  void DecodingThreadFunction();
+
+  static Registry<SequenceVideoSource> registry_;  ///< 相机公共接口指针
+
+  /// 注册回调函数列表
+  std::vector<std::pair<FrameCallback, void *>> callback_list_;
+  std::vector<Image> images_;                  ///< 图片列表
+  std::vector<Slot> slots_;                    ///< 重排缓冲区，序号为 i 的图片写入第 i % 大小 个位置
+  size_t next_frame_{};                        ///< 主循环下一帧的序号
+  size_t next_task_{};                         ///< 解码线程下一张待领取图片的序号
+  bool stop_flag_{};                           ///< 解码线程停止标志
+  std::mutex lock_;                            ///< 重排缓冲区互斥锁
+  std::condition_variable ready_cv_;           ///< 图片解码完成条件变量
+  std::condition_variable space_cv_;           ///< 重排缓冲区出现空位条件变量
+  std::vector<std::thread> decoding_threads_;  ///< 解码线程
+  Pacer pacer_;                                ///< 帧释放节奏控制
+};
+}
+
+#endif  // SRM_IC_2023_MODULES_VIDEO_SOURCE_SEQUENCE_VIDEO_SOURCE_SEQUENCE_H_